@@ -0,0 +1,101 @@
+/*
+ * Description: microbenchmarks of the concurrent maps (sprint 8): ConcurrentMap (std::map buckets) against
+ * ConcurrentHashMap (striped open addressing). Each benchmark takes 2 arguments: number of updates and number of
+ * distinct keys. Updates are distributed between the threads of the shared pool.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <execution>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../src/sprint_8/concurent_map.h"
+#include "../src/sprint_8/parallel_for.h"
+
+using namespace sprint_8::server;
+
+namespace {
+
+std::vector<int> MakeKeys(const benchmark::State& state) {
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> distribution(0, static_cast<int>(state.range(1)) - 1);
+
+    std::vector<int> keys(static_cast<size_t>(state.range(0)));
+    for (auto& key : keys)
+        key = distribution(generator);
+    return keys;
+}
+
+void MapArguments(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"updates", "keys"});
+    benchmark->ArgsProduct({{100'000}, {1'000, 100'000}});
+    benchmark->Unit(benchmark::kMicrosecond);
+}
+
+}  // namespace
+
+/* BENCHMARKS */
+
+void BM_ConcurrentMapAccumulate(benchmark::State& state) {
+    const auto keys = MakeKeys(state);
+    const auto buckets_count = static_cast<size_t>(std::thread::hardware_concurrency());
+
+    for (auto _ : state) {
+        ConcurrentMap<int, double> map(buckets_count);
+        utils::ForEach(std::execution::par, keys, [&map](int key) { map[key].ref_to_value += 1.; });
+        benchmark::DoNotOptimize(map.BuildOrdinaryMap());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ConcurrentMapAccumulate)->Apply(MapArguments);
+
+void BM_ConcurrentHashMapAccumulate(benchmark::State& state) {
+    const auto keys = MakeKeys(state);
+
+    for (auto _ : state) {
+        ConcurrentHashMap<int, double> map;
+        utils::ForEach(std::execution::par, keys, [&map](int key) { map.Accumulate(key, 1.); });
+        benchmark::DoNotOptimize(map.Drain());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ConcurrentHashMapAccumulate)->Apply(MapArguments);
+
+void BM_ConcurrentMapErase(benchmark::State& state) {
+    const auto keys = MakeKeys(state);
+    const auto buckets_count = static_cast<size_t>(std::thread::hardware_concurrency());
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        ConcurrentMap<int, double> map(buckets_count);
+        for (int key : keys)
+            map[key].ref_to_value += 1.;
+        state.ResumeTiming();
+
+        utils::ForEach(std::execution::par, keys, [&map](int key) { map.Erase(key); });
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ConcurrentMapErase)->Apply(MapArguments);
+
+void BM_ConcurrentHashMapErase(benchmark::State& state) {
+    const auto keys = MakeKeys(state);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        ConcurrentHashMap<int, double> map;
+        for (int key : keys)
+            map.Accumulate(key, 1.);
+        state.ResumeTiming();
+
+        utils::ForEach(std::execution::par, keys, [&map](int key) { map.Erase(key); });
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ConcurrentHashMapErase)->Apply(MapArguments);
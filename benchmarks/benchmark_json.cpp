@@ -0,0 +1,106 @@
+/*
+ * Description: benchmarks of the JSON parsers of the transport catalogue (sprint 14) on the make_base input: stream
+ * parser json::Load against the two-stage json::FastLoad, and the pull parser, which walks the input without the DOM.
+ * Input is the real make_base file, if its path is set in the JSON_BENCHMARK_INPUT environment variable, otherwise
+ * it is the synthetic make_base input. The argument of the synthetic input is the number of the stops.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "../src/sprint_14/src/json.h"
+#include "../src/sprint_14/src/json_fast_loader.h"
+#include "../src/sprint_14/src/json_pull_parser.h"
+
+namespace {
+
+constexpr int kRoadDistancesCount{8};
+constexpr int kRouteLength{20};
+
+/// @brief Base requests of the city with 'stops_count' stops and 'stops_count / 10' buses
+std::string GenerateMakeBaseInput(int stops_count) {
+    std::mt19937 generator(42u);
+    std::uniform_real_distribution<double> latitude(55.5, 55.9);
+    std::uniform_real_distribution<double> longitude(37.3, 37.7);
+    std::uniform_int_distribution<int> stop(0, stops_count - 1);
+    std::uniform_int_distribution<int> distance(300, 3'000);
+
+    std::ostringstream output;
+    output.precision(8);
+    output << R"({"serialization_settings": {"file": "transport_catalogue.db"}, "base_requests": [)";
+
+    for (int id = 0; id < stops_count; ++id) {
+        output << R"({"type": "Stop", "name": "Stop )" << id << R"(", "latitude": )" << latitude(generator)
+               << R"(, "longitude": )" << longitude(generator) << R"(, "road_distances": {)";
+        // Keys of the dictionary should be unique, so the distances are set to the next stops by the ids
+        for (int index = 0; index < kRoadDistancesCount; ++index)
+            output << (index == 0 ? "" : ", ") << R"("Stop )" << (id + index + 1) % stops_count << R"(": )"
+                   << distance(generator);
+        output << "}}, ";
+    }
+
+    for (int id = 0; id < stops_count / 10; ++id) {
+        output << R"({"type": "Bus", "name": "Bus )" << id << R"(", "is_roundtrip": false, "stops": [)";
+        for (int index = 0; index < kRouteLength; ++index)
+            output << (index == 0 ? "" : ", ") << R"("Stop )" << stop(generator) << '"';
+        output << "]}" << (id + 1 < stops_count / 10 ? ", " : "");
+    }
+
+    output << R"(], "routing_settings": {"bus_wait_time": 6, "bus_velocity": 40}})";
+    return output.str();
+}
+
+std::string LoadInput(const benchmark::State& state) {
+    if (const char* path = std::getenv("JSON_BENCHMARK_INPUT")) {
+        std::ifstream input(path, std::ios::binary);
+        return json::ReadAll(input);
+    }
+    return GenerateMakeBaseInput(static_cast<int>(state.range(0)));
+}
+
+void InputArguments(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"stops"});
+    benchmark->Args({1'000})->Args({10'000})->Args({100'000});
+    benchmark->Unit(benchmark::kMillisecond);
+}
+
+void BM_JsonStreamLoad(benchmark::State& state) {
+    const std::string text = LoadInput(state);
+
+    for (auto _ : state) {
+        std::istringstream input(text);
+        benchmark::DoNotOptimize(json::Load(input));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_JsonStreamLoad)->Apply(InputArguments);
+
+void BM_JsonFastLoad(benchmark::State& state) {
+    const std::string text = LoadInput(state);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(json::FastLoad(text));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_JsonFastLoad)->Apply(InputArguments);
+
+void BM_JsonPullSkip(benchmark::State& state) {
+    const std::string text = LoadInput(state);
+
+    for (auto _ : state) {
+        json::PullParser parser(text);
+        parser.Skip();
+        benchmark::DoNotOptimize(parser.GetPosition());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_JsonPullSkip)->Apply(InputArguments);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,208 @@
+/*
+ * Description: benchmarks of the search server hot paths (sprint 8).
+ * Each benchmark takes 3 arguments: number of documents, vocabulary size and number of words in the document.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <execution>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "../src/sprint_8/paginator.h"
+#include "../src/sprint_8/process_queries.h"
+#include "../src/sprint_8/search_server.h"
+#include "corpus_generator.h"
+
+using namespace sprint_8::server;
+using namespace std::literals;
+
+namespace {
+
+constexpr int kStopWordsCount{10};
+constexpr int kQueriesCount{1'000};
+constexpr int kQueryPlusWordsCount{5};
+constexpr int kQueryMinusWordsCount{2};
+
+struct Corpus {
+    std::vector<std::string> stop_words;
+    std::vector<std::string> documents;
+    std::vector<std::string> queries;
+};
+
+Corpus MakeCorpus(const benchmark::State& state) {
+    benchmarks::CorpusSettings settings;
+    settings.vocabulary_size = static_cast<int>(state.range(1));
+    settings.words_in_document = static_cast<int>(state.range(2));
+
+    benchmarks::CorpusGenerator generator(settings);
+
+    Corpus corpus;
+    // The most frequent words in the Zipf distribution play the role of the stop words ("a", "the", "and", ...)
+    const auto& vocabulary = generator.GetVocabulary();
+    corpus.stop_words = {vocabulary.begin(), vocabulary.begin() + std::min<size_t>(kStopWordsCount, vocabulary.size())};
+    corpus.documents = generator.GenerateDocuments(static_cast<int>(state.range(0)));
+    corpus.queries = generator.GenerateQueries(kQueriesCount, kQueryPlusWordsCount, kQueryMinusWordsCount);
+
+    return corpus;
+}
+
+SearchServer MakeSearchServer(const Corpus& corpus) {
+    SearchServer server(corpus.stop_words);
+
+    for (int id = 0; id < static_cast<int>(corpus.documents.size()); ++id)
+        server.AddDocument(id, corpus.documents[id], DocumentStatus::ACTUAL, {id % 10, 1, 2});
+
+    return server;
+}
+
+void CorpusArguments(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"documents", "vocabulary", "words"});
+    benchmark->ArgsProduct({{1'000, 10'000}, {1'000, 20'000}, {20, 100}});
+    benchmark->Unit(benchmark::kMicrosecond);
+}
+
+}  // namespace
+
+/* BENCHMARKS */
+
+void BM_AddDocument(benchmark::State& state) {
+    const auto corpus = MakeCorpus(state);
+
+    for (auto _ : state) {
+        SearchServer server(corpus.stop_words);
+        for (int id = 0; id < static_cast<int>(corpus.documents.size()); ++id)
+            server.AddDocument(id, corpus.documents[id], DocumentStatus::ACTUAL, {1, 2, 3});
+
+        benchmark::DoNotOptimize(server);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(corpus.documents.size()));
+}
+BENCHMARK(BM_AddDocument)->Apply(CorpusArguments);
+
+template <class ExecutionPolicy>
+void BM_FindTopDocuments(benchmark::State& state, ExecutionPolicy policy) {
+    const auto corpus = MakeCorpus(state);
+    const auto server = MakeSearchServer(corpus);
+
+    size_t query_id{0};
+    for (auto _ : state) {
+        const auto& query = corpus.queries[query_id++ % corpus.queries.size()];
+        benchmark::DoNotOptimize(server.FindTopDocuments(policy, query));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_FindTopDocuments, seq, std::execution::seq)->Apply(CorpusArguments);
+BENCHMARK_CAPTURE(BM_FindTopDocuments, par, std::execution::par)->Apply(CorpusArguments);
+
+void BM_PaginateDocuments(benchmark::State& state) {
+    constexpr int kPageSize{10};
+    constexpr size_t kPageId{2};
+
+    const auto corpus = MakeCorpus(state);
+    const auto server = MakeSearchServer(corpus);
+
+    size_t query_id{0};
+    for (auto _ : state) {
+        const auto& query = corpus.queries[query_id++ % corpus.queries.size()];
+        const auto generator = server.FindDocumentsGenerator(std::execution::seq, query,
+                                                             [](int, DocumentStatus, int) { return true; });
+        const auto page = utils::Paginate(generator, kPageSize).GetPage(kPageId);
+        for (auto document = page.start; document != page.end; ++document)
+            benchmark::DoNotOptimize(*document);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PaginateDocuments)->Apply(CorpusArguments);
+
+template <class ExecutionPolicy>
+void BM_MatchDocument(benchmark::State& state, ExecutionPolicy policy) {
+    const auto corpus = MakeCorpus(state);
+    const auto server = MakeSearchServer(corpus);
+    const int documents_count = server.GetDocumentCount();
+
+    size_t query_id{0};
+    for (auto _ : state) {
+        const auto& query = corpus.queries[query_id % corpus.queries.size()];
+        benchmark::DoNotOptimize(server.MatchDocument(policy, query, static_cast<int>(query_id % documents_count)));
+        ++query_id;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MatchDocument, seq, std::execution::seq)->Apply(CorpusArguments);
+BENCHMARK_CAPTURE(BM_MatchDocument, par, std::execution::par)->Apply(CorpusArguments);
+
+template <class ExecutionPolicy>
+void BM_RemoveDocument(benchmark::State& state, ExecutionPolicy policy) {
+    const auto corpus = MakeCorpus(state);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto server = MakeSearchServer(corpus);
+        state.ResumeTiming();
+
+        for (int id = 0; id < static_cast<int>(corpus.documents.size()); ++id)
+            server.RemoveDocument(policy, id);
+
+        benchmark::DoNotOptimize(server);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(corpus.documents.size()));
+}
+BENCHMARK_CAPTURE(BM_RemoveDocument, seq, std::execution::seq)->Apply(CorpusArguments);
+BENCHMARK_CAPTURE(BM_RemoveDocument, par, std::execution::par)->Apply(CorpusArguments);
+
+void BM_RemoveDuplicates(benchmark::State& state) {
+    auto corpus = MakeCorpus(state);
+    // Make a half of the documents duplicates of the other half (same words set, different order)
+    const size_t originals_count = corpus.documents.size() / 2;
+    for (size_t id = originals_count; id < corpus.documents.size(); ++id) {
+        auto words = utils::SplitIntoWords(corpus.documents[id - originals_count]);
+        std::string duplicate;
+        for (auto word = words.rbegin(); word != words.rend(); ++word)
+            duplicate.append(*word).push_back(' ');
+        duplicate.pop_back();
+        corpus.documents[id] = std::move(duplicate);
+    }
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto server = MakeSearchServer(corpus);
+        state.ResumeTiming();
+
+        RemoveDuplicates(server);
+        benchmark::DoNotOptimize(server);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(corpus.documents.size()));
+}
+BENCHMARK(BM_RemoveDuplicates)->Apply(CorpusArguments);
+
+void BM_ProcessQueries(benchmark::State& state) {
+    const auto corpus = MakeCorpus(state);
+    const auto server = MakeSearchServer(corpus);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(ProcessQueries(server, corpus.queries));
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(corpus.queries.size()));
+}
+BENCHMARK(BM_ProcessQueries)->Apply(CorpusArguments);
+
+void BM_ProcessQueriesJoined(benchmark::State& state) {
+    const auto corpus = MakeCorpus(state);
+    const auto server = MakeSearchServer(corpus);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(ProcessQueriesJoined(server, corpus.queries));
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(corpus.queries.size()));
+}
+BENCHMARK(BM_ProcessQueriesJoined)->Apply(CorpusArguments);
+
+BENCHMARK_MAIN();
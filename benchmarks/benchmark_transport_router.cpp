@@ -0,0 +1,213 @@
+/*
+ * Description: benchmarks of the transport routers (sprint 14): graph router, where each bus route is O(L^2) edges
+ * between the pairs of its stops, against RaptorRouter, which works with the routes themselves.
+ * Each benchmark takes one argument: length of the bus routes. Total number of the stops on all routes is the same for
+ * all lengths, so only the shape of the network changes.
+ * Geo benchmarks compare the geographic length of all routes computed pair by pair with the batch kernel.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../src/sprint_14/src/transport_router.h"
+#include "city_generator.h"
+
+namespace {
+
+constexpr int kStopsCount{2'000};
+constexpr int kTotalRoutesLength{16'000};
+constexpr int kRoutesCount{256};
+constexpr int kMatrixSize{32};
+
+struct City {
+    std::unique_ptr<catalogue::TransportCatalogue> catalogue;
+    std::vector<std::pair<std::string_view, std::string_view>> routes;
+};
+
+City MakeCity(const benchmark::State& state) {
+    benchmarks::CitySettings settings;
+    settings.stops_count = kStopsCount;
+    settings.route_length = static_cast<int>(state.range(0));
+    settings.buses_count = kTotalRoutesLength / settings.route_length;
+
+    benchmarks::CityGenerator generator(settings);
+
+    City city;
+    city.catalogue = generator.GenerateCatalogue();
+    city.routes = generator.GenerateRoutes(*city.catalogue, kRoutesCount);
+    return city;
+}
+
+routing::Settings MakeSettings(routing::RouterType type) {
+    routing::Settings settings;
+    settings.bus_velocity_ = 1'000. * 40. / 60.;
+    settings.bus_wait_time_ = 6;
+    settings.router_type_ = type;
+    // Each query is from the new source, so the cache of the shortest-path trees does not help
+    settings.router_cache_size_ = 1u;
+    return settings;
+}
+
+void CityArguments(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"route_length"});
+    benchmark->Args({10})->Args({40})->Args({160});
+    benchmark->Unit(benchmark::kMillisecond);
+}
+
+void BuildRouter(benchmark::State& state, routing::RouterType type) {
+    const auto city = MakeCity(state);
+
+    for (auto _ : state) {
+        routing::TransportRouter router(*city.catalogue, MakeSettings(type));
+        benchmark::DoNotOptimize(router);
+    }
+}
+
+void BuildRoutes(benchmark::State& state, routing::RouterType type) {
+    const auto city = MakeCity(state);
+    const routing::TransportRouter router(*city.catalogue, MakeSettings(type));
+
+    for (auto _ : state) {
+        for (const auto& [from, to] : city.routes)
+            benchmark::DoNotOptimize(router.BuildRoute(from, to));
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(city.routes.size()));
+}
+
+void MatrixArguments(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"route_length"});
+    benchmark->Args({40});
+    benchmark->Unit(benchmark::kMillisecond);
+}
+
+std::pair<std::vector<std::string_view>, std::vector<std::string_view>> MakeMatrixStops(const City& city) {
+    std::vector<std::string_view> from;
+    std::vector<std::string_view> to;
+    for (int index = 0; index < kMatrixSize; ++index) {
+        from.push_back(city.routes[index].first);
+        to.push_back(city.routes[index].second);
+    }
+    return {std::move(from), std::move(to)};
+}
+
+/// @brief Matrix of the route times, found with the independent queries for each pair of stops
+void BuildRoutePairs(benchmark::State& state, routing::RouterType type) {
+    const auto city = MakeCity(state);
+    const routing::TransportRouter router(*city.catalogue, MakeSettings(type));
+    const auto [from, to] = MakeMatrixStops(city);
+
+    for (auto _ : state) {
+        for (std::string_view stop_from : from) {
+            for (std::string_view stop_to : to)
+                benchmark::DoNotOptimize(router.BuildRoute(stop_from, stop_to));
+        }
+    }
+}
+
+void BuildRouteMatrix(benchmark::State& state, routing::RouterType type) {
+    const auto city = MakeCity(state);
+    const routing::TransportRouter router(*city.catalogue, MakeSettings(type));
+    const auto [from, to] = MakeMatrixStops(city);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(router.BuildRouteMatrix(from, to));
+}
+
+}  // namespace
+
+/* BENCHMARKS */
+
+void BM_GraphRouterBuild(benchmark::State& state) {
+    BuildRouter(state, routing::RouterType::Dijkstra);
+}
+BENCHMARK(BM_GraphRouterBuild)->Apply(CityArguments);
+
+void BM_RaptorRouterBuild(benchmark::State& state) {
+    BuildRouter(state, routing::RouterType::Raptor);
+}
+BENCHMARK(BM_RaptorRouterBuild)->Apply(CityArguments);
+
+void BM_GraphRouterQuery(benchmark::State& state) {
+    BuildRoutes(state, routing::RouterType::Dijkstra);
+}
+BENCHMARK(BM_GraphRouterQuery)->Apply(CityArguments);
+
+void BM_RaptorRouterQuery(benchmark::State& state) {
+    BuildRoutes(state, routing::RouterType::Raptor);
+}
+BENCHMARK(BM_RaptorRouterQuery)->Apply(CityArguments);
+
+void BM_GraphRoutePairs(benchmark::State& state) {
+    BuildRoutePairs(state, routing::RouterType::Dijkstra);
+}
+BENCHMARK(BM_GraphRoutePairs)->Apply(MatrixArguments);
+
+void BM_GraphRouteMatrix(benchmark::State& state) {
+    BuildRouteMatrix(state, routing::RouterType::Dijkstra);
+}
+BENCHMARK(BM_GraphRouteMatrix)->Apply(MatrixArguments);
+
+void BM_HierarchyRoutePairs(benchmark::State& state) {
+    BuildRoutePairs(state, routing::RouterType::ContractionHierarchies);
+}
+BENCHMARK(BM_HierarchyRoutePairs)->Apply(MatrixArguments);
+
+void BM_HierarchyRouteMatrix(benchmark::State& state) {
+    BuildRouteMatrix(state, routing::RouterType::ContractionHierarchies);
+}
+BENCHMARK(BM_HierarchyRouteMatrix)->Apply(MatrixArguments);
+
+void BM_RaptorRoutePairs(benchmark::State& state) {
+    BuildRoutePairs(state, routing::RouterType::Raptor);
+}
+BENCHMARK(BM_RaptorRoutePairs)->Apply(MatrixArguments);
+
+void BM_RaptorRouteMatrix(benchmark::State& state) {
+    BuildRouteMatrix(state, routing::RouterType::Raptor);
+}
+BENCHMARK(BM_RaptorRouteMatrix)->Apply(MatrixArguments);
+
+/* GEOGRAPHIC LENGTH OF ALL ROUTES: ONE PAIR AT A TIME AGAINST THE BATCH KERNEL */
+
+void BM_GeoLengthScalar(benchmark::State& state) {
+    const auto city = MakeCity(state);
+    const auto& catalogue = *city.catalogue;
+
+    for (auto _ : state) {
+        double length{0.};
+        for (catalogue::BusId bus = 0; bus < catalogue.GetBusesCount(); ++bus) {
+            const auto stops = catalogue.GetBusStops(bus);
+            for (auto stop = std::next(stops.begin()); stop < stops.end(); ++stop)
+                length += geo::ComputeDistance(catalogue.GetStopPoint(*std::prev(stop)), catalogue.GetStopPoint(*stop));
+        }
+        benchmark::DoNotOptimize(length);
+    }
+}
+BENCHMARK(BM_GeoLengthScalar)->Apply(MatrixArguments);
+
+void BM_GeoLengthBatch(benchmark::State& state) {
+    const auto city = MakeCity(state);
+    const auto& catalogue = *city.catalogue;
+
+    geo::PointsTerms points;
+    for (catalogue::StopId stop = 0; stop < catalogue.GetStopsCount(); ++stop)
+        points.Add(catalogue.GetStopPoint(stop));
+
+    for (auto _ : state) {
+        double length{0.};
+        for (catalogue::BusId bus = 0; bus < catalogue.GetBusesCount(); ++bus) {
+            const auto stops = catalogue.GetBusStops(bus);
+            length += geo::ComputePathLength(points, stops.begin(), static_cast<size_t>(stops.end() - stops.begin()));
+        }
+        benchmark::DoNotOptimize(length);
+    }
+}
+BENCHMARK(BM_GeoLengthBatch)->Apply(MatrixArguments);
+
+BENCHMARK_MAIN();
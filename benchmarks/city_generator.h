@@ -0,0 +1,95 @@
+#pragma once
+
+/*
+ * Description: synthetic city generator for the transport router benchmarks (sprint 14).
+ * Stops are scattered uniformly over the square area, each bus visits random stops. Half of the buses are circular,
+ * the other half are two-directional. Road distances are set only in one direction, so the routers use the reverse
+ * distance fallback as well.
+ */
+
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../src/sprint_14/src/transport_catalogue.h"
+
+namespace benchmarks {
+
+struct CitySettings {
+    int stops_count{1'000};
+    int buses_count{100};
+    int route_length{20};
+    unsigned seed{42u};
+};
+
+class CityGenerator {
+public:  // Constructor
+    explicit CityGenerator(CitySettings settings) : settings_(settings), generator_(settings.seed) {}
+
+public:  // Methods
+    std::unique_ptr<catalogue::TransportCatalogue> GenerateCatalogue() {
+        auto catalogue = std::make_unique<catalogue::TransportCatalogue>();
+
+        std::uniform_real_distribution<double> latitude(kMinLatitude, kMinLatitude + kAreaSize);
+        std::uniform_real_distribution<double> longitude(kMinLongitude, kMinLongitude + kAreaSize);
+
+        stop_names_.clear();
+        for (int id = 0; id < settings_.stops_count; ++id) {
+            stop_names_.emplace_back("Stop " + std::to_string(id));
+            catalogue->AddStop({stop_names_.back(), {latitude(generator_), longitude(generator_)}});
+        }
+
+        std::uniform_int_distribution<int> stop_distribution(0, settings_.stops_count - 1);
+        std::uniform_int_distribution<int> distance_distribution(kMinDistance, kMaxDistance);
+
+        for (int id = 0; id < settings_.buses_count; ++id) {
+            catalogue::Bus bus;
+            bus.number = "Bus " + std::to_string(id);
+            bus.type = (id % 2 == 0) ? catalogue::RouteType::CIRCLE : catalogue::RouteType::TWO_DIRECTIONAL;
+
+            for (int index = 0; index < settings_.route_length; ++index)
+                bus.stop_names.emplace_back(stop_names_[stop_distribution(generator_)]);
+            if (bus.type == catalogue::RouteType::CIRCLE)
+                bus.stop_names.push_back(bus.stop_names.front());
+
+            for (size_t index = 1; index < bus.stop_names.size(); ++index)
+                catalogue->AddDistance(bus.stop_names[index - 1], bus.stop_names[index], distance_distribution(generator_));
+
+            catalogue->AddBus(std::move(bus));
+        }
+
+        return catalogue;
+    }
+
+    /// @brief Generates pairs of stops for the route requests
+    std::vector<std::pair<std::string_view, std::string_view>> GenerateRoutes(const catalogue::TransportCatalogue& catalogue,
+                                                                              int routes_count) {
+        std::uniform_int_distribution<catalogue::StopId> stop_distribution(
+            0u, static_cast<catalogue::StopId>(catalogue.GetStopsCount() - 1));
+
+        std::vector<std::pair<std::string_view, std::string_view>> routes;
+        routes.reserve(routes_count);
+        for (int id = 0; id < routes_count; ++id)
+            routes.emplace_back(catalogue.GetStopName(stop_distribution(generator_)),
+                                catalogue.GetStopName(stop_distribution(generator_)));
+
+        return routes;
+    }
+
+private:  // Constants
+    static constexpr double kMinLatitude{55.5};
+    static constexpr double kMinLongitude{37.3};
+    static constexpr double kAreaSize{0.4};
+
+    static constexpr int kMinDistance{300};
+    static constexpr int kMaxDistance{3'000};
+
+private:  // Fields
+    CitySettings settings_;
+    std::mt19937 generator_;
+    std::vector<std::string> stop_names_;
+};
+
+}  // namespace benchmarks
@@ -0,0 +1,119 @@
+#pragma once
+
+/*
+ * Description: synthetic corpus generator for the search server benchmarks.
+ * Words of the documents and queries follow Zipf's law, so the index looks like the one built for a natural language
+ * text: a few very frequent words and a long tail of rare ones.
+ */
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace benchmarks {
+
+struct CorpusSettings {
+    int vocabulary_size{10'000};
+    int words_in_document{50};
+    double zipf_exponent{1.};
+    unsigned seed{42u};
+};
+
+class CorpusGenerator {
+public:  // Constructor
+    explicit CorpusGenerator(CorpusSettings settings) : settings_(settings), generator_(settings.seed) {
+        BuildVocabulary();
+        BuildZipfDistribution();
+    }
+
+public:  // Methods
+    [[nodiscard]] const std::vector<std::string>& GetVocabulary() const {
+        return vocabulary_;
+    }
+
+    std::string GenerateDocument() {
+        return GenerateText(settings_.words_in_document, 0);
+    }
+
+    std::vector<std::string> GenerateDocuments(int documents_count) {
+        std::vector<std::string> documents;
+        documents.reserve(documents_count);
+
+        for (int id = 0; id < documents_count; ++id)
+            documents.emplace_back(GenerateDocument());
+
+        return documents;
+    }
+
+    /// @brief Generates query with the given number of plus & minus words (minus words are prefixed with '-')
+    std::string GenerateQuery(int plus_words_count, int minus_words_count) {
+        return GenerateText(plus_words_count, minus_words_count);
+    }
+
+    std::vector<std::string> GenerateQueries(int queries_count, int plus_words_count, int minus_words_count) {
+        std::vector<std::string> queries;
+        queries.reserve(queries_count);
+
+        for (int id = 0; id < queries_count; ++id)
+            queries.emplace_back(GenerateQuery(plus_words_count, minus_words_count));
+
+        return queries;
+    }
+
+private:  // Constants
+    static constexpr int kMinWordLength{3};
+    static constexpr int kMaxWordLength{10};
+
+private:  // Methods
+    void BuildVocabulary() {
+        std::uniform_int_distribution<int> length_distribution(kMinWordLength, kMaxWordLength);
+        std::uniform_int_distribution<int> letter_distribution('a', 'z');
+
+        std::unordered_set<std::string> unique_words;
+        unique_words.reserve(settings_.vocabulary_size);
+        vocabulary_.reserve(settings_.vocabulary_size);
+
+        while (static_cast<int>(vocabulary_.size()) < settings_.vocabulary_size) {
+            std::string word(length_distribution(generator_), ' ');
+            for (char& letter : word)
+                letter = static_cast<char>(letter_distribution(generator_));
+
+            if (unique_words.insert(word).second)
+                vocabulary_.emplace_back(std::move(word));
+        }
+    }
+
+    void BuildZipfDistribution() {
+        // Word with the rank 'k' appears with the probability proportional to 1 / k^s
+        std::vector<double> weights(vocabulary_.size());
+        for (size_t rank = 0; rank < weights.size(); ++rank)
+            weights[rank] = 1. / std::pow(static_cast<double>(rank + 1), settings_.zipf_exponent);
+
+        zipf_distribution_ = std::discrete_distribution<int>(weights.begin(), weights.end());
+    }
+
+    std::string GenerateText(int plus_words_count, int minus_words_count) {
+        std::string text;
+        text.reserve((plus_words_count + minus_words_count) * (kMaxWordLength + 2));
+
+        for (int id = 0; id < plus_words_count + minus_words_count; ++id) {
+            if (!text.empty())
+                text.push_back(' ');
+            if (id >= plus_words_count)
+                text.push_back('-');
+            text += vocabulary_[zipf_distribution_(generator_)];
+        }
+
+        return text;
+    }
+
+private:  // Fields
+    CorpusSettings settings_;
+    std::mt19937 generator_;
+    std::vector<std::string> vocabulary_;
+    std::discrete_distribution<int> zipf_distribution_;
+};
+
+}  // namespace benchmarks
@@ -0,0 +1,748 @@
+#pragma once
+
+/*
+ * Description: Contraction Hierarchies router. Vertices are contracted one by one in the order of their importance
+ * (the least important first): after the contraction of vertex V the shortcut U -> X is added for each path
+ * U -> V -> X, if there is no shorter path between U and X without V (so-called witness). Each vertex gets the rank,
+ * which equals to its contraction order.
+ *
+ * Query is the bidirectional Dijkstra, which moves only to the vertices with the higher rank, so it settles only
+ * a small part of the graph. Shortcuts remember the pair of edges, which they replace, so the found route is unpacked
+ * to the original graph edges.
+ *
+ * Preprocessing is parallel: on each round the independent set of vertices (no two of them are neighbours) is
+ * contracted at once. Witness searches of the round are independent and run on the thread pool, shortcuts are
+ * applied sequentially, so the result does not depend on the number of threads. Witnesses do not pass through the
+ * vertices of the current round: otherwise two vertices could be witnesses of each other and both would be contracted
+ * without the shortcuts.
+ *
+ * Many-to-many weights are found with the buckets: upward search from each target in the reversed graph leaves the
+ * pair (target, distance) in the bucket of each settled vertex, then upward search from each source combines its
+ * distances with the buckets of the settled vertices. So it takes |from| + |to| searches instead of |from| * |to|.
+ *
+ * Graph should be frozen (see DirectedWeightedGraph::Freeze). Upward and downward search graphs are stored in the
+ * same compressed sparse rows layout.
+ */
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "graph.h"
+#include "router.h"
+#include "thread_pool.h"
+
+namespace graph {
+
+template <typename Weight>
+class ContractionHierarchy {
+private:
+    using Graph = DirectedWeightedGraph<Weight>;
+
+public:
+    using RouteInfo = typename Router<Weight>::RouteInfo;
+
+    /// @brief Edge 'from' -> 'to', which replaces the path of two edges 'first' -> 'second' through contracted vertex
+    /// @details Edges ids: [0, E) are the original edges of the graph, [E, E + shortcuts count) are the shortcuts
+    struct Shortcut {
+        VertexId from{0};
+        VertexId to{0};
+        Weight weight{};
+        EdgeId first{0};
+        EdgeId second{0};
+    };
+
+    /// @brief Result of the preprocessing, which is enough to restore the hierarchy for the same graph
+    struct Data {
+        std::vector<size_t> ranks;
+        std::vector<Shortcut> shortcuts;
+    };
+
+public:
+    explicit ContractionHierarchy(const Graph& graph);
+    ContractionHierarchy(const Graph& graph, Data data);
+
+    std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to) const;
+    std::vector<std::optional<RouteInfo>> BuildRoutes(VertexId from, const std::vector<VertexId>& to) const;
+
+    /// @brief Weights of the shortest routes from each of 'from' to each of 'to' (row-major, nullopt if there is no
+    /// route). Weights are summed up with the shortcuts, so they could differ from BuildRoute in the last bits
+    std::vector<std::optional<Weight>> BuildWeightsMatrix(const std::vector<VertexId>& from,
+                                                          const std::vector<VertexId>& to) const;
+
+    const Data& GetData() const;
+
+private:
+    struct AdjacentEdge {
+        VertexId vertex{0};
+        Weight weight{};
+        EdgeId edge{0};
+    };
+    using AdjacencyList = std::vector<std::vector<AdjacentEdge>>;
+
+    /// @brief Edges of vertex V have indices [offsets[V], offsets[V + 1])
+    struct SearchGraph {
+        std::vector<size_t> offsets;
+        std::vector<AdjacentEdge> edges;
+    };
+
+    class Builder;
+
+    static constexpr EdgeId kNoEdge{std::numeric_limits<EdgeId>::max()};
+    static constexpr Weight ZERO_WEIGHT{};
+    static constexpr Weight kInfinity{std::numeric_limits<Weight>::max()};
+
+    void BuildSearchGraph();
+    std::pair<VertexId, VertexId> GetEdgeEnds(EdgeId edge_id) const;
+    void CheckVertex(VertexId vertex) const;
+
+    /// @brief Full search from 'source' in the search graph: calls 'visit(vertex, distance)' for each settled vertex
+    template <typename Visitor>
+    void SearchUpward(VertexId source, const SearchGraph& graph, Visitor visit) const;
+    void UnpackEdge(EdgeId edge_id, std::vector<EdgeId>& edges) const;
+
+    const Graph& graph_;
+    Data data_;
+
+    // upward_[v]: edges v -> w with rank(w) > rank(v), downward_[v]: edges w -> v with rank(w) > rank(v)
+    SearchGraph upward_;
+    SearchGraph downward_;
+};
+
+/* PREPROCESSING */
+
+template <typename Weight>
+class ContractionHierarchy<Weight>::Builder {
+public:
+    explicit Builder(const Graph& graph)
+        : graph_(graph),
+          vertex_count_(graph.GetVertexCount()),
+          out_edges_(vertex_count_),
+          in_edges_(vertex_count_),
+          is_contracted_(vertex_count_, false),
+          is_contracting_(vertex_count_, false),
+          deleted_neighbours_(vertex_count_, 0),
+          priorities_(vertex_count_, 0) {
+        for (EdgeId edge_id = 0; edge_id < graph.GetEdgeCount(); ++edge_id) {
+            const auto& edge = graph.GetEdge(edge_id);
+            if (edge.weight < ZERO_WEIGHT) {
+                throw std::domain_error("Edges' weights should be non-negative");
+            }
+            // Loops are never a part of the shortest path
+            if (edge.from != edge.to) {
+                AddEdge(edge.from, edge.to, edge.weight, edge_id);
+            }
+        }
+    }
+
+    Data Build() {
+        Data data;
+        data.ranks.resize(vertex_count_);
+
+        std::vector<VertexId> remaining(vertex_count_);
+        for (VertexId vertex = 0; vertex < vertex_count_; ++vertex) {
+            remaining[vertex] = vertex;
+        }
+        UpdatePriorities(remaining);
+
+        size_t next_rank{0u};
+        size_t last_update_size = remaining.size();
+        while (!remaining.empty()) {
+            // Step 1. Select independent set of the vertices: each of them is more important than all its neighbours
+            std::vector<VertexId> selected;
+            for (VertexId vertex : remaining) {
+                if (IsLocalMinimum(vertex)) {
+                    selected.push_back(vertex);
+                    is_contracting_[vertex] = true;
+                }
+            }
+
+            // Step 2. Find shortcuts for all selected vertices in parallel (only reads the current graph)
+            std::vector<std::vector<Shortcut>> shortcuts(selected.size());
+            parallel::ThreadPool::Instance().Run(selected.size(), [this, &selected, &shortcuts](size_t index) {
+                FindShortcuts(selected[index], kMaxWitnessSettledCount, shortcuts[index]);
+            });
+
+            // Step 3. Contract vertices sequentially, so the result is deterministic
+            std::vector<VertexId> neighbours;
+            for (size_t index = 0; index < selected.size(); ++index) {
+                for (const auto& shortcut : shortcuts[index]) {
+                    AddShortcut(shortcut);
+                }
+                Contract(selected[index], neighbours);
+                is_contracting_[selected[index]] = false;
+                data.ranks[selected[index]] = next_rank++;
+            }
+
+            remaining.erase(std::remove_if(remaining.begin(), remaining.end(),
+                                           [this](VertexId vertex) { return is_contracted_[vertex]; }),
+                            remaining.end());
+
+            // Step 4. Importance of the neighbours has been changed. Full estimation (simulated contraction) is
+            // expensive in the dense core of the graph, so it is done only when the graph has been reduced noticeably,
+            // meanwhile neighbours are penalized for each contracted neighbour
+            if (remaining.size() * kFullUpdateDenominator <= last_update_size * (kFullUpdateDenominator - 1)) {
+                last_update_size = remaining.size();
+                UpdatePriorities(remaining);
+            } else {
+                for (VertexId neighbour : neighbours) {
+                    ++priorities_[neighbour];
+                }
+            }
+        }
+
+        data.shortcuts = std::move(shortcuts_);
+        return data;
+    }
+
+private:
+    // Witness search is limited: if it gives up, the shortcut is added, which is always correct. Priority estimation
+    // uses the shorter search, it affects only the quality of the vertices order
+    static constexpr size_t kMaxWitnessSettledCount{150u};
+    static constexpr size_t kMaxEstimationSettledCount{5u};
+
+    // Priorities of all remaining vertices are recomputed after contraction of each 1/8 of them
+    static constexpr size_t kFullUpdateDenominator{8u};
+
+    struct WitnessScratch {
+        std::vector<Weight> distances;
+        std::vector<VertexId> touched;
+        std::vector<std::pair<Weight, VertexId>> queue;
+        std::vector<bool> is_target;
+    };
+
+    void AddEdge(VertexId from, VertexId to, Weight weight, EdgeId edge_id) {
+        // Only the lightest edge between two vertices is used
+        auto& out_edges = out_edges_[from];
+        const auto position = std::find_if(out_edges.begin(), out_edges.end(),
+                                           [to](const AdjacentEdge& edge) { return edge.vertex == to; });
+        if (position == out_edges.end()) {
+            out_edges.push_back({to, weight, edge_id});
+            in_edges_[to].push_back({from, weight, edge_id});
+            return;
+        }
+
+        if (weight < position->weight) {
+            *position = {to, weight, edge_id};
+            for (auto& in_edge : in_edges_[to]) {
+                if (in_edge.vertex == from) {
+                    in_edge = {from, weight, edge_id};
+                }
+            }
+        }
+    }
+
+    bool HasShorterEdge(VertexId from, VertexId to, Weight weight) const {
+        const auto& out_edges = out_edges_[from];
+        return std::any_of(out_edges.begin(), out_edges.end(), [to, weight](const AdjacentEdge& edge) {
+            return edge.vertex == to && edge.weight <= weight;
+        });
+    }
+
+    void AddShortcut(const Shortcut& shortcut) {
+        if (HasShorterEdge(shortcut.from, shortcut.to, shortcut.weight)) {
+            return;
+        }
+
+        AddEdge(shortcut.from, shortcut.to, shortcut.weight, graph_.GetEdgeCount() + shortcuts_.size());
+        shortcuts_.push_back(shortcut);
+    }
+
+    void Contract(VertexId vertex, std::vector<VertexId>& neighbours) {
+        is_contracted_[vertex] = true;
+
+        const auto remove_vertex = [vertex](std::vector<AdjacentEdge>& edges) {
+            edges.erase(std::remove_if(edges.begin(), edges.end(),
+                                       [vertex](const AdjacentEdge& edge) { return edge.vertex == vertex; }),
+                        edges.end());
+        };
+
+        for (const auto& edge : out_edges_[vertex]) {
+            remove_vertex(in_edges_[edge.vertex]);
+            ++deleted_neighbours_[edge.vertex];
+            neighbours.push_back(edge.vertex);
+        }
+        for (const auto& edge : in_edges_[vertex]) {
+            remove_vertex(out_edges_[edge.vertex]);
+            ++deleted_neighbours_[edge.vertex];
+            neighbours.push_back(edge.vertex);
+        }
+
+        out_edges_[vertex].clear();
+        out_edges_[vertex].shrink_to_fit();
+        in_edges_[vertex].clear();
+        in_edges_[vertex].shrink_to_fit();
+    }
+
+    /// @brief Vertex is contracted before its neighbours, if it has lower priority (ties are broken by id)
+    bool IsLocalMinimum(VertexId vertex) const {
+        const auto key = std::make_pair(priorities_[vertex], vertex);
+        const auto is_less_important = [this, &key](const AdjacentEdge& edge) {
+            return std::make_pair(priorities_[edge.vertex], edge.vertex) < key;
+        };
+
+        return std::none_of(out_edges_[vertex].begin(), out_edges_[vertex].end(), is_less_important) &&
+               std::none_of(in_edges_[vertex].begin(), in_edges_[vertex].end(), is_less_important);
+    }
+
+    /// @brief Priority = edge difference (added shortcuts - removed edges) + number of contracted neighbours
+    void UpdatePriorities(const std::vector<VertexId>& vertices) {
+        parallel::ThreadPool::Instance().Run(vertices.size(), [this, &vertices](size_t index) {
+            static thread_local std::vector<Shortcut> shortcuts;
+            shortcuts.clear();
+
+            const VertexId vertex = vertices[index];
+            if (is_contracted_[vertex]) {
+                return;
+            }
+
+            FindShortcuts(vertex, kMaxEstimationSettledCount, shortcuts);
+            priorities_[vertex] = static_cast<int>(shortcuts.size()) -
+                                  static_cast<int>(out_edges_[vertex].size() + in_edges_[vertex].size()) +
+                                  deleted_neighbours_[vertex];
+        });
+    }
+
+    void FindShortcuts(VertexId vertex, size_t max_settled_count, std::vector<Shortcut>& shortcuts) const {
+        const auto& out_edges = out_edges_[vertex];
+        if (out_edges.empty()) {
+            return;
+        }
+
+        Weight max_out_weight = ZERO_WEIGHT;
+        for (const auto& out_edge : out_edges) {
+            max_out_weight = std::max(max_out_weight, out_edge.weight);
+        }
+
+        static thread_local WitnessScratch scratch;
+        if (scratch.distances.size() < vertex_count_) {
+            scratch.distances.assign(vertex_count_, kInfinity);
+            scratch.is_target.assign(vertex_count_, false);
+        }
+        for (const auto& out_edge : out_edges) {
+            scratch.is_target[out_edge.vertex] = true;
+        }
+
+        for (const auto& in_edge : in_edges_[vertex]) {
+            FindWitnesses(in_edge.vertex, vertex, in_edge.weight + max_out_weight, out_edges.size(), max_settled_count,
+                          scratch);
+
+            for (const auto& out_edge : out_edges) {
+                const Weight weight = in_edge.weight + out_edge.weight;
+                if (out_edge.vertex != in_edge.vertex && weight < scratch.distances[out_edge.vertex]) {
+                    shortcuts.push_back({in_edge.vertex, out_edge.vertex, weight, in_edge.edge, out_edge.edge});
+                }
+            }
+
+            for (VertexId touched : scratch.touched) {
+                scratch.distances[touched] = kInfinity;
+            }
+            scratch.touched.clear();
+        }
+
+        for (const auto& out_edge : out_edges) {
+            scratch.is_target[out_edge.vertex] = false;
+        }
+    }
+
+    /// @brief Dijkstra from 'source', which ignores 'excluded' vertex and the vertices of the current round, and stops
+    /// after 'max_distance' or when all 'targets_count' targets (out neighbours of the excluded vertex) are settled
+    void FindWitnesses(VertexId source, VertexId excluded, Weight max_distance, size_t targets_count,
+                       size_t max_settled_count, WitnessScratch& scratch) const {
+        auto& [distances, touched, queue, is_target] = scratch;
+        const auto push = [&](Weight distance, VertexId vertex) {
+            if (distances[vertex] == kInfinity) {
+                touched.push_back(vertex);
+            }
+            distances[vertex] = distance;
+            queue.emplace_back(distance, vertex);
+            std::push_heap(queue.begin(), queue.end(), std::greater<>{});
+        };
+
+        queue.clear();
+        push(ZERO_WEIGHT, source);
+
+        size_t settled_count{0u};
+        while (!queue.empty() && settled_count < max_settled_count) {
+            std::pop_heap(queue.begin(), queue.end(), std::greater<>{});
+            const auto [distance, vertex] = queue.back();
+            queue.pop_back();
+
+            if (distance > distances[vertex]) {
+                continue;
+            }
+            if (distance > max_distance) {
+                break;
+            }
+            ++settled_count;
+
+            if (is_target[vertex] && --targets_count == 0) {
+                break;
+            }
+
+            for (const auto& edge : out_edges_[vertex]) {
+                const Weight candidate = distance + edge.weight;
+                if (edge.vertex != excluded && !is_contracting_[edge.vertex] && candidate < distances[edge.vertex]) {
+                    push(candidate, edge.vertex);
+                }
+            }
+        }
+    }
+
+    const Graph& graph_;
+    const size_t vertex_count_{0u};
+
+    // Graph of the not contracted vertices (with shortcuts)
+    AdjacencyList out_edges_;
+    AdjacencyList in_edges_;
+
+    std::vector<bool> is_contracted_;
+    std::vector<bool> is_contracting_;  // vertices of the current round
+    std::vector<int> deleted_neighbours_;
+    std::vector<int> priorities_;
+
+    std::vector<Shortcut> shortcuts_;
+};
+
+/* HIERARCHY */
+
+template <typename Weight>
+ContractionHierarchy<Weight>::ContractionHierarchy(const Graph& graph)
+    : ContractionHierarchy(graph, Builder(graph).Build()) {}
+
+template <typename Weight>
+ContractionHierarchy<Weight>::ContractionHierarchy(const Graph& graph, Data data)
+    : graph_(graph), data_(std::move(data)) {
+    if (data_.ranks.size() != graph.GetVertexCount()) {
+        throw std::invalid_argument("Contraction hierarchy does not correspond to the graph");
+    }
+    BuildSearchGraph();
+}
+
+template <typename Weight>
+const typename ContractionHierarchy<Weight>::Data& ContractionHierarchy<Weight>::GetData() const {
+    return data_;
+}
+
+template <typename Weight>
+void ContractionHierarchy<Weight>::BuildSearchGraph() {
+    const size_t vertex_count = graph_.GetVertexCount();
+    const auto& rows = graph_.GetCompressedSparseRows();
+
+    // Edges are passed twice: the first pass counts edges of each vertex, the second one puts them to their places
+    const auto for_each_edge = [this, &rows, vertex_count](const auto& function) {
+        for (VertexId from = 0; from < vertex_count; ++from) {
+            for (size_t arc = rows.offsets[from]; arc < rows.offsets[from + 1]; ++arc) {
+                function(from, rows.targets[arc], rows.weights[arc], rows.edge_ids[arc]);
+            }
+        }
+        for (size_t index = 0; index < data_.shortcuts.size(); ++index) {
+            const auto& shortcut = data_.shortcuts[index];
+            function(shortcut.from, shortcut.to, shortcut.weight, graph_.GetEdgeCount() + index);
+        }
+    };
+
+    upward_.offsets.assign(vertex_count + 1, 0u);
+    downward_.offsets.assign(vertex_count + 1, 0u);
+    for_each_edge([this](VertexId from, VertexId to, Weight, EdgeId) {
+        if (from != to) {
+            ++(data_.ranks[from] < data_.ranks[to] ? upward_.offsets[from + 1] : downward_.offsets[to + 1]);
+        }
+    });
+    for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+        upward_.offsets[vertex + 1] += upward_.offsets[vertex];
+        downward_.offsets[vertex + 1] += downward_.offsets[vertex];
+    }
+
+    upward_.edges.resize(upward_.offsets.back());
+    downward_.edges.resize(downward_.offsets.back());
+    std::vector<size_t> upward_positions(upward_.offsets.begin(), upward_.offsets.end() - 1);
+    std::vector<size_t> downward_positions(downward_.offsets.begin(), downward_.offsets.end() - 1);
+    for_each_edge([&](VertexId from, VertexId to, Weight weight, EdgeId edge_id) {
+        if (from == to) {
+            return;
+        }
+        if (data_.ranks[from] < data_.ranks[to]) {
+            upward_.edges[upward_positions[from]++] = {to, weight, edge_id};
+        } else {
+            downward_.edges[downward_positions[to]++] = {from, weight, edge_id};
+        }
+    });
+}
+
+template <typename Weight>
+std::pair<VertexId, VertexId> ContractionHierarchy<Weight>::GetEdgeEnds(EdgeId edge_id) const {
+    if (edge_id < graph_.GetEdgeCount()) {
+        const auto& edge = graph_.GetEdge(edge_id);
+        return {edge.from, edge.to};
+    }
+    const auto& shortcut = data_.shortcuts[edge_id - graph_.GetEdgeCount()];
+    return {shortcut.from, shortcut.to};
+}
+
+template <typename Weight>
+void ContractionHierarchy<Weight>::UnpackEdge(EdgeId edge_id, std::vector<EdgeId>& edges) const {
+    std::vector<EdgeId> stack{edge_id};
+    while (!stack.empty()) {
+        const EdgeId current = stack.back();
+        stack.pop_back();
+
+        if (current < graph_.GetEdgeCount()) {
+            edges.push_back(current);
+        } else {
+            // 'first' should be unpacked before 'second', so it is pushed last
+            const auto& shortcut = data_.shortcuts[current - graph_.GetEdgeCount()];
+            stack.push_back(shortcut.second);
+            stack.push_back(shortcut.first);
+        }
+    }
+}
+
+template <typename Weight>
+std::optional<typename ContractionHierarchy<Weight>::RouteInfo> ContractionHierarchy<Weight>::BuildRoute(
+    VertexId from, VertexId to) const {
+    const size_t vertex_count = graph_.GetVertexCount();
+    CheckVertex(from);
+    CheckVertex(to);
+    if (from == to) {
+        return RouteInfo{ZERO_WEIGHT, {}};
+    }
+
+    using QueueItem = std::pair<Weight, VertexId>;
+
+    // Search state of one direction: arrays are reused between the queries, only touched items are reset
+    struct Search {
+        std::vector<Weight> distances;
+        std::vector<EdgeId> previous_edges;
+        std::vector<VertexId> touched;
+        std::vector<QueueItem> queue;
+
+        void Reset(size_t size) {
+            if (distances.size() < size) {
+                distances.assign(size, kInfinity);
+                previous_edges.assign(size, kNoEdge);
+            }
+            for (VertexId vertex : touched) {
+                distances[vertex] = kInfinity;
+                previous_edges[vertex] = kNoEdge;
+            }
+            touched.clear();
+            queue.clear();
+        }
+
+        void Push(Weight distance, VertexId vertex, EdgeId edge) {
+            if (distances[vertex] == kInfinity) {
+                touched.push_back(vertex);
+            }
+            distances[vertex] = distance;
+            previous_edges[vertex] = edge;
+            queue.emplace_back(distance, vertex);
+            std::push_heap(queue.begin(), queue.end(), std::greater<>{});
+        }
+
+        Weight GetMinDistance() const {
+            return queue.empty() ? kInfinity : queue.front().first;
+        }
+    };
+
+    static thread_local Search forward;
+    static thread_local Search backward;
+    forward.Reset(vertex_count);
+    backward.Reset(vertex_count);
+
+    forward.Push(ZERO_WEIGHT, from, kNoEdge);
+    backward.Push(ZERO_WEIGHT, to, kNoEdge);
+
+    Weight best_distance = kInfinity;
+    VertexId meeting_vertex = vertex_count;
+
+    const auto step = [&best_distance, &meeting_vertex](Search& search, const Search& opposite,
+                                                        const SearchGraph& graph) {
+        std::pop_heap(search.queue.begin(), search.queue.end(), std::greater<>{});
+        const auto [distance, vertex] = search.queue.back();
+        search.queue.pop_back();
+
+        if (distance > search.distances[vertex]) {
+            return;
+        }
+        if (opposite.distances[vertex] != kInfinity && distance + opposite.distances[vertex] < best_distance) {
+            best_distance = distance + opposite.distances[vertex];
+            meeting_vertex = vertex;
+        }
+
+        for (size_t index = graph.offsets[vertex]; index < graph.offsets[vertex + 1]; ++index) {
+            const auto& edge = graph.edges[index];
+            const Weight candidate = distance + edge.weight;
+            if (candidate < search.distances[edge.vertex]) {
+                search.Push(candidate, edge.vertex, edge.edge);
+            }
+        }
+    };
+
+    // Each direction stops, when its nearest vertex is further than the best found route
+    while (forward.GetMinDistance() < best_distance || backward.GetMinDistance() < best_distance) {
+        if (forward.GetMinDistance() <= backward.GetMinDistance()) {
+            step(forward, backward, upward_);
+        } else {
+            step(backward, forward, downward_);
+        }
+    }
+
+    if (meeting_vertex == vertex_count) {
+        return std::nullopt;
+    }
+
+    // Path from -> meeting vertex is restored backward, path meeting vertex -> to is restored forward
+    std::vector<EdgeId> packed_edges;
+    for (VertexId vertex = meeting_vertex; vertex != from;) {
+        const EdgeId edge_id = forward.previous_edges[vertex];
+        packed_edges.push_back(edge_id);
+        vertex = GetEdgeEnds(edge_id).first;
+    }
+    std::reverse(packed_edges.begin(), packed_edges.end());
+
+    for (VertexId vertex = meeting_vertex; vertex != to;) {
+        const EdgeId edge_id = backward.previous_edges[vertex];
+        packed_edges.push_back(edge_id);
+        vertex = GetEdgeEnds(edge_id).second;
+    }
+
+    std::vector<EdgeId> edges;
+    for (EdgeId edge_id : packed_edges) {
+        UnpackEdge(edge_id, edges);
+    }
+
+    // Weight is summed along the route (as Dijkstra does), so the result does not depend on the shortcuts rounding
+    Weight weight = ZERO_WEIGHT;
+    for (EdgeId edge_id : edges) {
+        weight += graph_.GetEdge(edge_id).weight;
+    }
+
+    return RouteInfo{weight, std::move(edges)};
+}
+
+template <typename Weight>
+std::vector<std::optional<typename ContractionHierarchy<Weight>::RouteInfo>> ContractionHierarchy<Weight>::BuildRoutes(
+    VertexId from, const std::vector<VertexId>& to) const {
+    // Bidirectional queries touch only the small part of the graph, so each route is found separately
+    std::vector<std::optional<RouteInfo>> routes;
+    routes.reserve(to.size());
+    for (VertexId vertex_to : to) {
+        routes.push_back(BuildRoute(from, vertex_to));
+    }
+    return routes;
+}
+
+template <typename Weight>
+std::vector<std::optional<Weight>> ContractionHierarchy<Weight>::BuildWeightsMatrix(
+    const std::vector<VertexId>& from, const std::vector<VertexId>& to) const {
+    struct BucketItem {
+        size_t target{0u};
+        Weight distance{};
+    };
+
+    // Step 1. Backward searches from the targets: items are collected and then grouped by vertices
+    std::vector<std::pair<VertexId, BucketItem>> items;
+    for (size_t target = 0; target < to.size(); ++target) {
+        CheckVertex(to[target]);
+        SearchUpward(to[target], downward_, [&items, target](VertexId vertex, Weight distance) {
+            items.push_back({vertex, {target, distance}});
+        });
+    }
+
+    const size_t vertex_count = graph_.GetVertexCount();
+    std::vector<size_t> bucket_offsets(vertex_count + 1, 0u);
+    for (const auto& [vertex, _] : items) {
+        ++bucket_offsets[vertex + 1];
+    }
+    for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+        bucket_offsets[vertex + 1] += bucket_offsets[vertex];
+    }
+    std::vector<BucketItem> buckets(items.size());
+    std::vector<size_t> positions(bucket_offsets.begin(), bucket_offsets.end() - 1);
+    for (const auto& [vertex, item] : items) {
+        buckets[positions[vertex]++] = item;
+    }
+
+    // Step 2. Forward searches from the sources meet the targets in the buckets of the settled vertices
+    std::vector<Weight> weights(from.size() * to.size(), kInfinity);
+    for (size_t source = 0; source < from.size(); ++source) {
+        CheckVertex(from[source]);
+        Weight* row = &weights[source * to.size()];
+        SearchUpward(from[source], upward_, [&](VertexId vertex, Weight distance) {
+            for (size_t index = bucket_offsets[vertex]; index < bucket_offsets[vertex + 1]; ++index) {
+                const auto& item = buckets[index];
+                row[item.target] = std::min(row[item.target], distance + item.distance);
+            }
+        });
+    }
+
+    std::vector<std::optional<Weight>> matrix;
+    matrix.reserve(weights.size());
+    for (Weight weight : weights) {
+        matrix.push_back(weight == kInfinity ? std::nullopt : std::optional<Weight>(weight));
+    }
+    return matrix;
+}
+
+template <typename Weight>
+template <typename Visitor>
+void ContractionHierarchy<Weight>::SearchUpward(VertexId source, const SearchGraph& graph, Visitor visit) const {
+    using QueueItem = std::pair<Weight, VertexId>;
+
+    // Distances are reused between the searches of the thread, only touched items are reset
+    static thread_local std::vector<Weight> distances;
+    static thread_local std::vector<VertexId> touched;
+    static thread_local std::vector<QueueItem> queue;
+
+    if (distances.size() < graph_.GetVertexCount()) {
+        distances.assign(graph_.GetVertexCount(), kInfinity);
+    }
+    for (VertexId vertex : touched) {
+        distances[vertex] = kInfinity;
+    }
+    touched.clear();
+    queue.clear();
+
+    const auto push = [](Weight distance, VertexId vertex) {
+        if (distances[vertex] == kInfinity) {
+            touched.push_back(vertex);
+        }
+        distances[vertex] = distance;
+        queue.emplace_back(distance, vertex);
+        std::push_heap(queue.begin(), queue.end(), std::greater<>{});
+    };
+
+    push(ZERO_WEIGHT, source);
+    while (!queue.empty()) {
+        std::pop_heap(queue.begin(), queue.end(), std::greater<>{});
+        const auto [distance, vertex] = queue.back();
+        queue.pop_back();
+
+        if (distance > distances[vertex]) {
+            continue;
+        }
+        visit(vertex, distance);
+
+        for (size_t index = graph.offsets[vertex]; index < graph.offsets[vertex + 1]; ++index) {
+            const auto& edge = graph.edges[index];
+            const Weight candidate = distance + edge.weight;
+            if (candidate < distances[edge.vertex]) {
+                push(candidate, edge.vertex);
+            }
+        }
+    }
+}
+
+template <typename Weight>
+void ContractionHierarchy<Weight>::CheckVertex(VertexId vertex) const {
+    if (vertex >= graph_.GetVertexCount()) {
+        throw std::out_of_range("Vertex is out of graph");
+    }
+}
+
+}  // namespace graph
@@ -0,0 +1,222 @@
+#pragma once
+
+/*
+ * Description: router, which finds the shortest path between two vertices on demand with the Dijkstra algorithm.
+ * In comparison with graph::Router there is no O(V^3) precomputation and O(V^2) memory: the full shortest-path tree
+ * is built for the source vertex on the first request and kept in the LRU cache, so the next requests from the same
+ * source only restore the path.
+ *
+ * Graph should be frozen (see DirectedWeightedGraph::Freeze).
+ */
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "graph.h"
+#include "router.h"
+
+namespace graph {
+
+template <typename Weight>
+class DijkstraRouter {
+private:
+    using Graph = DirectedWeightedGraph<Weight>;
+
+public:
+    using RouteInfo = typename Router<Weight>::RouteInfo;
+
+    /// @brief Shortest-path tree from the source: distance and the last edge of the path to each vertex
+    struct ShortestPathTree {
+        std::vector<Weight> distances;
+        std::vector<EdgeId> previous_edges;
+    };
+
+public:
+    static constexpr size_t kDefaultCacheSize{256u};
+
+    explicit DijkstraRouter(const Graph& graph, size_t cache_size = kDefaultCacheSize);
+
+    std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to) const;
+    /// @brief Routes from one vertex to each of the vertices 'to', which are restored from the same shortest-path tree
+    std::vector<std::optional<RouteInfo>> BuildRoutes(VertexId from, const std::vector<VertexId>& to) const;
+
+    /// @brief Returns the shortest-path tree from the given vertex (builds it, if it is not in the cache)
+    std::shared_ptr<const ShortestPathTree> GetShortestPathTree(VertexId from) const;
+
+private:
+    using TreePtr = std::shared_ptr<const ShortestPathTree>;
+
+    static constexpr EdgeId kNoEdge{std::numeric_limits<EdgeId>::max()};
+    static constexpr Weight ZERO_WEIGHT{};
+
+    TreePtr BuildShortestPathTree(VertexId from) const;
+    std::optional<RouteInfo> RestoreRoute(const ShortestPathTree& tree, VertexId from, VertexId to) const;
+
+    TreePtr FindInCache(VertexId from) const;
+    void AddToCache(VertexId from, TreePtr tree) const;
+
+    const Graph& graph_;
+    const CompressedSparseRows<Weight>& rows_;
+    const size_t cache_size_{kDefaultCacheSize};
+
+    // LRU cache of the shortest-path trees: the most recently used source is in the front of the list
+    mutable std::mutex cache_mutex_;
+    mutable std::list<std::pair<VertexId, TreePtr>> cache_;
+    mutable std::unordered_map<VertexId, typename std::list<std::pair<VertexId, TreePtr>>::iterator> source_to_tree_;
+};
+
+template <typename Weight>
+DijkstraRouter<Weight>::DijkstraRouter(const Graph& graph, size_t cache_size)
+    : graph_(graph), rows_(graph.GetCompressedSparseRows()), cache_size_(std::max<size_t>(cache_size, 1u)) {
+    for (const auto& edge : graph.GetEdges()) {
+        if (edge.weight < ZERO_WEIGHT) {
+            throw std::domain_error("Edges' weights should be non-negative");
+        }
+    }
+}
+
+template <typename Weight>
+std::optional<typename DijkstraRouter<Weight>::RouteInfo> DijkstraRouter<Weight>::BuildRoute(VertexId from,
+                                                                                             VertexId to) const {
+    return RestoreRoute(*GetShortestPathTree(from), from, to);
+}
+
+template <typename Weight>
+std::vector<std::optional<typename DijkstraRouter<Weight>::RouteInfo>> DijkstraRouter<Weight>::BuildRoutes(
+    VertexId from, const std::vector<VertexId>& to) const {
+    const auto tree = GetShortestPathTree(from);
+
+    std::vector<std::optional<RouteInfo>> routes;
+    routes.reserve(to.size());
+    for (VertexId vertex_to : to) {
+        routes.push_back(RestoreRoute(*tree, from, vertex_to));
+    }
+    return routes;
+}
+
+template <typename Weight>
+std::optional<typename DijkstraRouter<Weight>::RouteInfo> DijkstraRouter<Weight>::RestoreRoute(
+    const ShortestPathTree& tree, VertexId from, VertexId to) const {
+    if (to >= tree.distances.size()) {
+        throw std::out_of_range("Vertex is out of graph");
+    }
+    if (to != from && tree.previous_edges[to] == kNoEdge) {
+        return std::nullopt;
+    }
+
+    std::vector<EdgeId> edges;
+    for (VertexId vertex = to; vertex != from;) {
+        const EdgeId edge_id = tree.previous_edges[vertex];
+        edges.push_back(edge_id);
+        vertex = graph_.GetEdge(edge_id).from;
+    }
+    std::reverse(edges.begin(), edges.end());
+
+    return RouteInfo{tree.distances[to], std::move(edges)};
+}
+
+template <typename Weight>
+std::shared_ptr<const typename DijkstraRouter<Weight>::ShortestPathTree> DijkstraRouter<Weight>::GetShortestPathTree(
+    VertexId from) const {
+    if (from >= graph_.GetVertexCount()) {
+        throw std::out_of_range("Vertex is out of graph");
+    }
+
+    if (auto tree = FindInCache(from)) {
+        return tree;
+    }
+
+    // Tree is built without the lock, so the different sources could be processed concurrently
+    auto tree = BuildShortestPathTree(from);
+    AddToCache(from, tree);
+    return tree;
+}
+
+template <typename Weight>
+typename DijkstraRouter<Weight>::TreePtr DijkstraRouter<Weight>::BuildShortestPathTree(VertexId from) const {
+    using QueueItem = std::pair<Weight, VertexId>;
+
+    // Binary heap storage is reused between the calls in the same thread to avoid the allocations
+    static thread_local std::vector<QueueItem> queue;
+    queue.clear();
+    const auto push = [](Weight distance, VertexId vertex) {
+        queue.emplace_back(distance, vertex);
+        std::push_heap(queue.begin(), queue.end(), std::greater<>{});
+    };
+
+    const size_t vertex_count = graph_.GetVertexCount();
+    auto tree = std::make_shared<ShortestPathTree>();
+    tree->distances.assign(vertex_count, std::numeric_limits<Weight>::max());
+    tree->previous_edges.assign(vertex_count, kNoEdge);
+
+    auto& distances = tree->distances;
+    auto& previous_edges = tree->previous_edges;
+
+    distances[from] = ZERO_WEIGHT;
+    push(ZERO_WEIGHT, from);
+
+    while (!queue.empty()) {
+        std::pop_heap(queue.begin(), queue.end(), std::greater<>{});
+        const auto [distance, vertex] = queue.back();
+        queue.pop_back();
+
+        // Lazy deletion: the vertex could be in the queue several times, only the first extraction is actual
+        if (distance > distances[vertex]) {
+            continue;
+        }
+
+        for (size_t arc = rows_.offsets[vertex]; arc < rows_.offsets[vertex + 1]; ++arc) {
+            const VertexId target = rows_.targets[arc];
+            const Weight candidate = distance + rows_.weights[arc];
+            if (candidate < distances[target]) {
+                distances[target] = candidate;
+                previous_edges[target] = rows_.edge_ids[arc];
+                push(candidate, target);
+            }
+        }
+    }
+
+    return tree;
+}
+
+template <typename Weight>
+typename DijkstraRouter<Weight>::TreePtr DijkstraRouter<Weight>::FindInCache(VertexId from) const {
+    std::lock_guard guard(cache_mutex_);
+
+    const auto position = source_to_tree_.find(from);
+    if (position == source_to_tree_.end()) {
+        return nullptr;
+    }
+
+    cache_.splice(cache_.begin(), cache_, position->second);
+    return position->second->second;
+}
+
+template <typename Weight>
+void DijkstraRouter<Weight>::AddToCache(VertexId from, TreePtr tree) const {
+    std::lock_guard guard(cache_mutex_);
+
+    // Tree could be already added by the other thread
+    if (source_to_tree_.count(from) > 0) {
+        return;
+    }
+
+    cache_.emplace_front(from, std::move(tree));
+    source_to_tree_.emplace(from, cache_.begin());
+
+    if (cache_.size() > cache_size_) {
+        source_to_tree_.erase(cache_.back().first);
+        cache_.pop_back();
+    }
+}
+
+}  // namespace graph
@@ -0,0 +1,138 @@
+#pragma once
+
+/*
+ * Description: table of the road distances between the stops. It is the open addressing hash table with the linear
+ * probing, keyed by the pair of stops ids packed into one 64-bit integer, so the lookup is one multiplication and a
+ * few sequential slots reads.
+ *
+ * The distance 'to' -> 'from' is equal to 'from' -> 'to', if it is not set explicitly. This rule is applied on adding,
+ * so each lookup is done only once in the given direction.
+ */
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "domain.h"
+
+namespace catalogue {
+
+class DistanceTable {
+public:  // Methods
+    /// @brief Sets the distance 'from' -> 'to' and the one 'to' -> 'from', if the last one is not set explicitly
+    /// @details The explicit distance is not overwritten (the first one added is used)
+    void Add(StopId from, StopId to, int distance) {
+        Slot& forward = FindOrInsert(MakeKey(from, to));
+        if (forward.is_explicit)
+            return;
+        forward.distance = distance;
+        forward.is_explicit = true;
+
+        Slot& backward = FindOrInsert(MakeKey(to, from));
+        if (!backward.is_explicit)
+            backward.distance = distance;
+    }
+
+    /// @brief Returns the distance 'from' -> 'to' (throws std::out_of_range if there is no such one in any direction)
+    [[nodiscard]] int Get(StopId from, StopId to) const {
+        if (const Slot* slot = Find(MakeKey(from, to)))
+            return slot->distance;
+        throw std::out_of_range("No distance between the stops");
+    }
+
+    /// @brief Calls 'function(from, to, distance)' for each explicitly set distance
+    template <typename Function>
+    void ForEachExplicit(Function function) const {
+        for (const Slot& slot : slots_) {
+            if (slot.key != kEmptyKey && slot.is_explicit)
+                function(static_cast<StopId>(slot.key >> 32u), static_cast<StopId>(slot.key), slot.distance);
+        }
+    }
+
+    [[nodiscard]] size_t GetSize() const {
+        return size_;
+    }
+
+private:  // Types
+    struct Slot {
+        uint64_t key{kEmptyKey};
+        int distance{0};
+        bool is_explicit{false};
+    };
+
+private:  // Constants
+    // Stops ids are less than the maximum of StopId, so the pair of maximums is never used by the real key
+    static constexpr uint64_t kEmptyKey{std::numeric_limits<uint64_t>::max()};
+    static constexpr size_t kMinCapacity{16u};
+
+private:  // Methods
+    static uint64_t MakeKey(StopId from, StopId to) {
+        return static_cast<uint64_t>(from) << 32u | to;
+    }
+
+    size_t GetPosition(uint64_t key) const {
+        // Fibonacci hashing: the high bits of the product depend on all bits of the key
+        constexpr uint64_t kMultiplier{11400714819323198485ull};
+        return static_cast<size_t>((key * kMultiplier) >> shift_);
+    }
+
+    const Slot* Find(uint64_t key) const {
+        if (slots_.empty())
+            return nullptr;
+
+        const size_t mask = slots_.size() - 1;
+        for (size_t position = GetPosition(key);; position = (position + 1) & mask) {
+            const Slot& slot = slots_[position];
+            if (slot.key == key)
+                return &slot;
+            if (slot.key == kEmptyKey)
+                return nullptr;
+        }
+    }
+
+    Slot& FindOrInsert(uint64_t key) {
+        // Load factor is kept not greater than 1/2, so the probe sequences are short
+        if (2 * (size_ + 1) > slots_.size())
+            Rehash(slots_.empty() ? kMinCapacity : 2 * slots_.size());
+
+        const size_t mask = slots_.size() - 1;
+        size_t position = GetPosition(key);
+        while (slots_[position].key != key && slots_[position].key != kEmptyKey)
+            position = (position + 1) & mask;
+
+        Slot& slot = slots_[position];
+        if (slot.key == kEmptyKey) {
+            slot.key = key;
+            ++size_;
+        }
+        return slot;
+    }
+
+    void Rehash(size_t capacity) {
+        std::vector<Slot> slots(capacity);
+        std::swap(slots, slots_);
+
+        shift_ = 64u;
+        for (size_t size = capacity; size > 1; size >>= 1u)
+            --shift_;
+
+        const size_t mask = capacity - 1;
+        for (const Slot& slot : slots) {
+            if (slot.key == kEmptyKey)
+                continue;
+
+            size_t position = GetPosition(slot.key);
+            while (slots_[position].key != kEmptyKey)
+                position = (position + 1) & mask;
+            slots_[position] = slot;
+        }
+    }
+
+private:  // Fields
+    std::vector<Slot> slots_;  // capacity is the power of 2
+    size_t size_{0u};
+    unsigned shift_{64u};
+};
+
+}  // namespace catalogue
@@ -12,8 +12,4 @@ std::ostream& operator<<(std::ostream& os, const BusStatistics& bus_info) {
     return os;
 }
 
-size_t Bus::GetStopsCount() const {
-    return (type == RouteType::CIRCLE) ? stop_names.size() : 2 * stop_names.size() - 1;
-}
-
 }  // namespace catalogue
@@ -5,6 +5,7 @@
  * describe buses and stops
  */
 
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <set>
@@ -19,28 +20,23 @@ namespace catalogue {
 
 using Path = std::filesystem::path;
 
+/// @brief Dense ids of the stops and buses in the catalogue: [0, count) in the order of adding
+using StopId = uint32_t;
+using BusId = uint32_t;
+
 enum class RouteType { CIRCLE, TWO_DIRECTIONAL };
 
+/// @brief Bus, which is added to the catalogue (stops are referred by names)
 struct Bus {
     std::string number;
     RouteType type;
     std::vector<std::string_view> stop_names;
-    std::set<std::string_view> unique_stops;
-
-    [[nodiscard]] size_t GetStopsCount() const;
 };
 
+/// @brief Stop, which is added to the catalogue
 struct Stop {
     std::string name;
     geo::Coordinates point;
-
-    [[nodiscard]] size_t Hash() const {
-        return std::hash<std::string>{}(name) + even_value * std::hash<double>{}(point.lng) +
-               even_value * even_value * std::hash<double>{}(point.lat);
-    }
-
-private:  // Fields
-    static const size_t even_value{37};
 };
 
 struct BusStatistics {
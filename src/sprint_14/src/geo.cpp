@@ -1,7 +1,48 @@
 #include "geo.h"
 
+#include <algorithm>
+
 namespace geo {
 
+namespace {
+// Points are processed by chunks: the first loop computes the cosines of the central angles (plain arithmetic on the
+// arrays, which is vectorized by the compiler), the second one calls 'acos'
+constexpr size_t kChunkSize{64u};
+
+void ComputeArcs(const double* cosines, size_t size, double* distances) {
+    // Cosine of the same points could be slightly greater than 1 because of the rounding
+    for (size_t index = 0; index < size; ++index)
+        distances[index] = std::acos(std::min(cosines[index], 1.)) * kEarthRadius;
+}
+
+template <typename Consumer>
+void ComputeDistancesByChunks(const PointsTerms& points, const uint32_t* from, const uint32_t* to, size_t count,
+                              Consumer consumer) {
+    const double* sin_lat = points.sin_lat.data();
+    const double* cos_lat = points.cos_lat.data();
+    const double* sin_lng = points.sin_lng.data();
+    const double* cos_lng = points.cos_lng.data();
+
+    double cosines[kChunkSize];
+    double distances[kChunkSize];
+
+    for (size_t begin = 0; begin < count; begin += kChunkSize) {
+        const size_t size = std::min(kChunkSize, count - begin);
+
+        // cos(lng_a - lng_b) = cos(lng_a) * cos(lng_b) + sin(lng_a) * sin(lng_b)
+        for (size_t index = 0; index < size; ++index) {
+            const uint32_t a = from[begin + index];
+            const uint32_t b = to[begin + index];
+            cosines[index] = sin_lat[a] * sin_lat[b] +
+                             cos_lat[a] * cos_lat[b] * (cos_lng[a] * cos_lng[b] + sin_lng[a] * sin_lng[b]);
+        }
+
+        ComputeArcs(cosines, size, distances);
+        consumer(begin, distances, size);
+    }
+}
+}  // namespace
+
 double ComputeDistance(Coordinates from, Coordinates to) {
     using namespace std;
     static const double dr = 3.1415926535 / 180.;
@@ -10,4 +51,56 @@ double ComputeDistance(Coordinates from, Coordinates to) {
            6371000;
 }
 
+void PointsTerms::Add(Coordinates point) {
+    sin_lat.push_back(std::sin(point.lat * kDegreesToRadians));
+    cos_lat.push_back(std::cos(point.lat * kDegreesToRadians));
+    sin_lng.push_back(std::sin(point.lng * kDegreesToRadians));
+    cos_lng.push_back(std::cos(point.lng * kDegreesToRadians));
+}
+
+size_t PointsTerms::GetSize() const {
+    return sin_lat.size();
+}
+
+void ComputeDistances(const PointsTerms& points, const uint32_t* from, const uint32_t* to, size_t count,
+                      double* distances) {
+    ComputeDistancesByChunks(points, from, to, count, [distances](size_t begin, const double* chunk, size_t size) {
+        std::copy(chunk, chunk + size, distances + begin);
+    });
+}
+
+void ComputeDistances(const PointsTerms& points, Coordinates from, const uint32_t* to, size_t count,
+                      double* distances) {
+    const double sin_lat = std::sin(from.lat * kDegreesToRadians);
+    const double cos_lat = std::cos(from.lat * kDegreesToRadians);
+    const double sin_lng = std::sin(from.lng * kDegreesToRadians);
+    const double cos_lng = std::cos(from.lng * kDegreesToRadians);
+
+    double cosines[kChunkSize];
+    for (size_t begin = 0; begin < count; begin += kChunkSize) {
+        const size_t size = std::min(kChunkSize, count - begin);
+
+        for (size_t index = 0; index < size; ++index) {
+            const uint32_t b = to[begin + index];
+            cosines[index] = sin_lat * points.sin_lat[b] +
+                             cos_lat * points.cos_lat[b] * (cos_lng * points.cos_lng[b] + sin_lng * points.sin_lng[b]);
+        }
+
+        ComputeArcs(cosines, size, distances + begin);
+    }
+}
+
+double ComputePathLength(const PointsTerms& points, const uint32_t* path, size_t count) {
+    if (count < 2)
+        return 0.;
+
+    double length{0.};
+    ComputeDistancesByChunks(points, path, path + 1, count - 1, [&length](size_t, const double* chunk, size_t size) {
+        for (size_t index = 0; index < size; ++index)
+            length += chunk[index];
+    });
+
+    return length;
+}
+
 }  // namespace geo
@@ -6,9 +6,14 @@
  */
 
 #include <cmath>
+#include <cstdint>
+#include <vector>
 
 namespace geo {
 
+inline constexpr double kDegreesToRadians{3.1415926535 / 180.};
+inline constexpr double kEarthRadius{6371000.};  // in meters
+
 struct Coordinates {
     double lat{0.};
     double lng{0.};
@@ -16,4 +21,28 @@ struct Coordinates {
 
 double ComputeDistance(Coordinates from, Coordinates to);
 
-}  // namespace geo
\ No newline at end of file
+/// @brief Points in the structure of arrays layout with the precomputed sines and cosines of their coordinates
+/// @details Terms are computed once per point, so the distance between two points needs only one 'acos' call instead
+/// of six trigonometric calls of ComputeDistance
+struct PointsTerms {
+    std::vector<double> sin_lat;
+    std::vector<double> cos_lat;
+    std::vector<double> sin_lng;
+    std::vector<double> cos_lng;
+
+    void Add(Coordinates point);
+    [[nodiscard]] size_t GetSize() const;
+};
+
+/// @brief Computes distances[i] between the points with the indices from[i] and to[i] for i in [0, count)
+void ComputeDistances(const PointsTerms& points, const uint32_t* from, const uint32_t* to, size_t count,
+                      double* distances);
+
+/// @brief Computes distances[i] between the point 'from' and the point with the index to[i] for i in [0, count)
+void ComputeDistances(const PointsTerms& points, Coordinates from, const uint32_t* to, size_t count,
+                      double* distances);
+
+/// @brief Length of the path through the points with the given indices (in the given order)
+double ComputePathLength(const PointsTerms& points, const uint32_t* path, size_t count);
+
+}  // namespace geo
@@ -1,10 +1,19 @@
 #pragma once
 
 /*
- * Description: representation of weighted graph
+ * Description: representation of weighted graph.
+ *
+ * Graph is built with AddEdge and then frozen: Freeze() converts the incidence lists to the compressed sparse row
+ * (CSR) arrays, where the outgoing edges of each vertex are stored contiguously. Routing algorithms work only with the
+ * frozen graph: neighbours are iterated without the indirection through the edges vector and without the per-vertex
+ * allocations. Frozen graph can't be modified.
  */
 
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <tuple>
 #include <vector>
 
 #include "ranges.h"
@@ -26,6 +35,16 @@ bool operator==(const Edge<Weight>& left, const Edge<Weight>& right) {
     return std::make_tuple(left.from, left.to, left.weight) == std::make_tuple(right.from, right.to, right.weight);
 }
 
+/// @brief Outgoing edges of the frozen graph: edges of vertex V have indices [offsets[V], offsets[V + 1])
+/// @details Edges of each vertex keep the order, in which they have been added
+template <typename Weight>
+struct CompressedSparseRows {
+    std::vector<size_t> offsets;
+    std::vector<VertexId> targets;
+    std::vector<Weight> weights;
+    std::vector<EdgeId> edge_ids;
+};
+
 template <typename Weight>
 class DirectedWeightedGraph {
 private:
@@ -37,31 +56,107 @@ public:
     explicit DirectedWeightedGraph(size_t vertex_count);
     EdgeId AddEdge(const Edge<Weight>& edge);
 
+    /// @brief Converts the graph to the CSR representation (does nothing if the graph is already frozen)
+    void Freeze();
+    [[nodiscard]] bool IsFrozen() const;
+
+    /// @brief Hash of the vertices count and of the edges (in the order of adding), which is used to check that the
+    /// stored routing data has been computed for the same graph
+    [[nodiscard]] uint64_t GetFingerprint() const;
+
     size_t GetVertexCount() const;
     size_t GetEdgeCount() const;
     const Edge<Weight>& GetEdge(EdgeId edge_id) const;
     const std::vector<Edge<Weight>>& GetEdges() const;
     IncidentEdgesRange GetIncidentEdges(VertexId vertex) const;
 
+    /// @brief Returns CSR arrays of the frozen graph (throws std::logic_error if the graph is not frozen)
+    const CompressedSparseRows<Weight>& GetCompressedSparseRows() const;
+
 private:
+    size_t vertex_count_{0u};
     std::vector<Edge<Weight>> edges_;
     std::vector<IncidenceList> incidence_lists_;
+
+    bool is_frozen_{false};
+    CompressedSparseRows<Weight> rows_;
 };
 
 template <typename Weight>
-DirectedWeightedGraph<Weight>::DirectedWeightedGraph(size_t vertex_count) : incidence_lists_(vertex_count) {}
+DirectedWeightedGraph<Weight>::DirectedWeightedGraph(size_t vertex_count)
+    : vertex_count_(vertex_count), incidence_lists_(vertex_count) {}
 
 template <typename Weight>
 EdgeId DirectedWeightedGraph<Weight>::AddEdge(const Edge<Weight>& edge) {
+    if (is_frozen_) {
+        throw std::logic_error("Frozen graph can't be modified");
+    }
+
     edges_.push_back(edge);
     const EdgeId id = edges_.size() - 1;
     incidence_lists_.at(edge.from).push_back(id);
     return id;
 }
 
+template <typename Weight>
+void DirectedWeightedGraph<Weight>::Freeze() {
+    if (is_frozen_) {
+        return;
+    }
+
+    rows_.offsets.resize(vertex_count_ + 1);
+    rows_.targets.reserve(edges_.size());
+    rows_.weights.reserve(edges_.size());
+    rows_.edge_ids.reserve(edges_.size());
+
+    rows_.offsets[0] = 0u;
+    for (VertexId vertex = 0; vertex < vertex_count_; ++vertex) {
+        for (const EdgeId edge_id : incidence_lists_[vertex]) {
+            rows_.targets.push_back(edges_[edge_id].to);
+            rows_.weights.push_back(edges_[edge_id].weight);
+            rows_.edge_ids.push_back(edge_id);
+        }
+        rows_.offsets[vertex + 1] = rows_.edge_ids.size();
+    }
+
+    // Incidence lists are not needed anymore: GetIncidentEdges uses the ranges of the CSR edges ids
+    std::vector<IncidenceList>().swap(incidence_lists_);
+    is_frozen_ = true;
+}
+
+template <typename Weight>
+bool DirectedWeightedGraph<Weight>::IsFrozen() const {
+    return is_frozen_;
+}
+
+template <typename Weight>
+uint64_t DirectedWeightedGraph<Weight>::GetFingerprint() const {
+    // FNV-1a over the bytes of the values: weights are compared bitwise, as they are stored
+    constexpr uint64_t kOffsetBasis{14695981039346656037ull};
+    constexpr uint64_t kPrime{1099511628211ull};
+
+    uint64_t hash = kOffsetBasis;
+    const auto add = [&hash](const auto& value) {
+        unsigned char bytes[sizeof(value)];
+        std::memcpy(bytes, &value, sizeof(value));
+        for (unsigned char byte : bytes) {
+            hash ^= byte;
+            hash *= kPrime;
+        }
+    };
+
+    add(static_cast<uint64_t>(vertex_count_));
+    for (const auto& edge : edges_) {
+        add(static_cast<uint64_t>(edge.from));
+        add(static_cast<uint64_t>(edge.to));
+        add(edge.weight);
+    }
+    return hash;
+}
+
 template <typename Weight>
 size_t DirectedWeightedGraph<Weight>::GetVertexCount() const {
-    return incidence_lists_.size();
+    return vertex_count_;
 }
 
 template <typename Weight>
@@ -82,6 +177,21 @@ const std::vector<Edge<Weight>>& DirectedWeightedGraph<Weight>::GetEdges() const
 template <typename Weight>
 typename DirectedWeightedGraph<Weight>::IncidentEdgesRange DirectedWeightedGraph<Weight>::GetIncidentEdges(
     VertexId vertex) const {
-    return ranges::AsRange(incidence_lists_.at(vertex));
+    if (!is_frozen_) {
+        return ranges::AsRange(incidence_lists_.at(vertex));
+    }
+
+    if (vertex >= vertex_count_) {
+        throw std::out_of_range("Vertex is out of graph");
+    }
+    return {rows_.edge_ids.begin() + rows_.offsets[vertex], rows_.edge_ids.begin() + rows_.offsets[vertex + 1]};
+}
+
+template <typename Weight>
+const CompressedSparseRows<Weight>& DirectedWeightedGraph<Weight>::GetCompressedSparseRows() const {
+    if (!is_frozen_) {
+        throw std::logic_error("Graph should be frozen");
+    }
+    return rows_;
 }
-}  // namespace graph
\ No newline at end of file
+}  // namespace graph
@@ -1,6 +1,9 @@
 #include "json.h"
 
+#include <algorithm>
 #include <iterator>
+#include <sstream>
+#include <stdexcept>
 
 namespace json {
 
@@ -34,16 +37,13 @@ Node LoadArray(std::istream& input) {
 }
 
 Node LoadDict(std::istream& input) {
-    Dict dict;
+    std::vector<Dict::value_type> items;
 
     for (char c; input >> c && c != '}';) {
         if (c == '"') {
             std::string key = LoadString(input).AsString();
             if (input >> c && c == ':') {
-                if (dict.find(key) != dict.end()) {
-                    throw ParsingError("Duplicate key '"s + key + "' have been found");
-                }
-                dict.emplace(std::move(key), LoadNode(input));
+                items.emplace_back(std::move(key), LoadNode(input));
             } else {
                 throw ParsingError(": is expected but '"s + c + "' has been found"s);
             }
@@ -54,7 +54,7 @@ Node LoadDict(std::istream& input) {
     if (!input) {
         throw ParsingError("Dictionary parsing error"s);
     }
-    return Node(std::move(dict));
+    return Node(Dict(std::move(items)));
 }
 
 Node LoadString(std::istream& input) {
@@ -340,6 +340,95 @@ void PrintNode(const Node& node, const PrintContext& ctx) {
 
 }  // namespace
 
+Dict::Dict(std::vector<value_type> items) : items_(std::move(items)) {
+    const auto is_less = [](const value_type& lhs, const value_type& rhs) { return lhs.first < rhs.first; };
+    std::sort(items_.begin(), items_.end(), is_less);
+
+    const auto is_equal = [](const value_type& lhs, const value_type& rhs) { return lhs.first == rhs.first; };
+    if (const auto duplicate = std::adjacent_find(items_.begin(), items_.end(), is_equal); duplicate != items_.end())
+        throw ParsingError("Duplicate key '"s + duplicate->first + "' have been found");
+}
+
+Dict::iterator Dict::find(std::string_view key) {
+    const size_t position = LowerBound(key);
+    return position != items_.size() && items_[position].first == key ? items_.begin() + position : items_.end();
+}
+
+Dict::const_iterator Dict::find(std::string_view key) const {
+    const size_t position = LowerBound(key);
+    return position != items_.size() && items_[position].first == key ? items_.begin() + position : items_.end();
+}
+
+size_t Dict::count(std::string_view key) const {
+    return find(key) != end() ? 1u : 0u;
+}
+
+const Node& Dict::at(std::string_view key) const {
+    if (const auto position = find(key); position != end())
+        return position->second;
+    throw std::out_of_range("No key '"s + std::string(key) + "' in the dictionary"s);
+}
+
+std::pair<Dict::iterator, bool> Dict::emplace(std::string key, Node value) {
+    const size_t position = LowerBound(key);
+    if (position != items_.size() && items_[position].first == key)
+        return {items_.begin() + position, false};
+    return {items_.emplace(items_.begin() + position, std::move(key), std::move(value)), true};
+}
+
+Dict::iterator Dict::begin() {
+    return items_.begin();
+}
+
+Dict::iterator Dict::end() {
+    return items_.end();
+}
+
+Dict::const_iterator Dict::begin() const {
+    return items_.begin();
+}
+
+Dict::const_iterator Dict::end() const {
+    return items_.end();
+}
+
+size_t Dict::size() const {
+    return items_.size();
+}
+
+bool Dict::empty() const {
+    return items_.empty();
+}
+
+bool Dict::operator==(const Dict& rhs) const {
+    return items_ == rhs.items_;
+}
+
+size_t Dict::LowerBound(std::string_view key) const {
+    const auto is_less = [](const value_type& item, std::string_view value) { return item.first < value; };
+    return static_cast<size_t>(std::lower_bound(items_.begin(), items_.end(), key, is_less) - items_.begin());
+}
+
+std::string ReadAll(std::istream& input) {
+    // Size of the seekable streams (files) is known in advance, so the buffer is allocated only once
+    const auto begin = input.tellg();
+    if (begin != std::istream::pos_type(-1) && input.seekg(0, std::ios::end)) {
+        const auto end = input.tellg();
+        input.seekg(begin);
+        if (end != std::istream::pos_type(-1) && input) {
+            std::string buffer(static_cast<size_t>(end - begin), '\0');
+            input.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.resize(static_cast<size_t>(input.gcount()));
+            return buffer;
+        }
+    }
+    input.clear();
+
+    std::ostringstream output;
+    output << input.rdbuf();
+    return output.str();
+}
+
 Document Load(std::istream& input) {
     return Document{LoadNode(input)};
 }
@@ -1,15 +1,15 @@
 #pragma once
 
 #include <iostream>
-#include <map>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <variant>
 #include <vector>
 
 namespace json {
 
 class Node;
-using Dict = std::map<std::string, Node>;
 using Array = std::vector<Node>;
 
 class ParsingError : public std::runtime_error {
@@ -17,6 +17,47 @@ public:
     using runtime_error::runtime_error;
 };
 
+/// @brief Dictionary of JSON: vector of the items sorted by the keys. Lookup is the binary search over the contiguous
+/// memory, and the parsed dictionary is built by one sort instead of the allocation of the tree node per key.
+/// Interface is the one of std::map, which has been used before
+class Dict {
+public:  // Types
+    using value_type = std::pair<std::string, Node>;
+    using iterator = std::vector<value_type>::iterator;
+    using const_iterator = std::vector<value_type>::const_iterator;
+
+public:  // Constructors
+    Dict() = default;
+    /// @brief Builds the dictionary from the items in any order (throws ParsingError on the duplicate keys)
+    explicit Dict(std::vector<value_type> items);
+
+public:  // Methods
+    [[nodiscard]] iterator find(std::string_view key);
+    [[nodiscard]] const_iterator find(std::string_view key) const;
+    [[nodiscard]] size_t count(std::string_view key) const;
+    /// @brief Throws std::out_of_range if there is no such key
+    [[nodiscard]] const Node& at(std::string_view key) const;
+
+    /// @brief Inserts the item, if there is no such key yet (the existing one is not overwritten)
+    std::pair<iterator, bool> emplace(std::string key, Node value);
+
+    [[nodiscard]] iterator begin();
+    [[nodiscard]] iterator end();
+    [[nodiscard]] const_iterator begin() const;
+    [[nodiscard]] const_iterator end() const;
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] bool empty() const;
+
+    bool operator==(const Dict& rhs) const;
+
+private:  // Methods
+    [[nodiscard]] size_t LowerBound(std::string_view key) const;
+
+private:  // Fields
+    std::vector<value_type> items_;
+};
+
 class Node final
     : private std::variant<std::nullptr_t, Array, Dict, bool, int, double, std::string> {
 public:
@@ -139,6 +180,9 @@ inline bool operator!=(const Document& lhs, const Document& rhs) {
     return !(lhs == rhs);
 }
 
+/// @brief Reads the whole input into the string
+std::string ReadAll(std::istream& input);
+
 Document Load(std::istream& input);
 
 void Print(const Document& doc, std::ostream& output);
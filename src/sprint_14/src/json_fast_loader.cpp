@@ -0,0 +1,454 @@
+#include "json_fast_loader.h"
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define JSON_FAST_LOADER_SSE2
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace json {
+
+namespace {
+using namespace std::literals;
+
+constexpr size_t kBlockSize{64u};
+
+/// @brief Bit masks of the block of 64 characters: bit 'i' corresponds to the character 'i' of the block
+struct BlockMasks {
+    uint64_t quotes{0u};
+    uint64_t backslashes{0u};
+    uint64_t operators{0u};  // {}[]:,
+    uint64_t spaces{0u};
+    uint64_t line_ends{0u};
+};
+
+#ifdef JSON_FAST_LOADER_SSE2
+
+BlockMasks ClassifyBlock(const char* block) {
+    BlockMasks masks;
+
+    for (size_t part = 0; part < kBlockSize / 16u; ++part) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + part * 16u));
+
+        const auto to_mask = [part](__m128i matches) {
+            return static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(matches))) << (part * 16u);
+        };
+        const auto equal = [](__m128i characters, char value) {
+            return _mm_cmpeq_epi8(characters, _mm_set1_epi8(value));
+        };
+
+        masks.quotes |= to_mask(equal(chunk, '"'));
+        masks.backslashes |= to_mask(equal(chunk, '\\'));
+
+        // Brackets differ from the braces only by one bit: '[' | 0x20 is '{' and ']' | 0x20 is '}'
+        const __m128i lowered = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+        const __m128i brackets = _mm_or_si128(equal(lowered, '{'), equal(lowered, '}'));
+        const __m128i separators = _mm_or_si128(equal(chunk, ':'), equal(chunk, ','));
+        masks.operators |= to_mask(_mm_or_si128(brackets, separators));
+
+        const __m128i line_ends = _mm_or_si128(equal(chunk, '\n'), equal(chunk, '\r'));
+        masks.line_ends |= to_mask(line_ends);
+        masks.spaces |= to_mask(_mm_or_si128(line_ends, _mm_or_si128(equal(chunk, ' '), equal(chunk, '\t'))));
+    }
+
+    return masks;
+}
+
+#else
+
+BlockMasks ClassifyBlock(const char* block) {
+    BlockMasks masks;
+
+    for (size_t position = 0; position < kBlockSize; ++position) {
+        const uint64_t bit = uint64_t{1u} << position;
+        switch (block[position]) {
+            case '"':
+                masks.quotes |= bit;
+                break;
+            case '\\':
+                masks.backslashes |= bit;
+                break;
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+            case ':':
+            case ',':
+                masks.operators |= bit;
+                break;
+            case '\n':
+            case '\r':
+                masks.line_ends |= bit;
+                masks.spaces |= bit;
+                break;
+            case ' ':
+            case '\t':
+                masks.spaces |= bit;
+                break;
+            default:
+                break;
+        }
+    }
+
+    return masks;
+}
+
+#endif
+
+int CountTrailingZeros(uint64_t value) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index{0u};
+    _BitScanForward64(&index, value);
+    return static_cast<int>(index);
+#elif defined(__GNUC__)
+    return __builtin_ctzll(value);
+#else
+    int count{0};
+    for (; (value & 1u) == 0u; value >>= 1u)
+        ++count;
+    return count;
+#endif
+}
+
+/// @brief Bit 'i' of the result is XOR of the bits [0, i] of the value: for the quotes mask it is the mask of the
+/// characters inside the strings (opening quotes are included, closing ones are not)
+uint64_t PrefixXor(uint64_t value) {
+    for (unsigned shift = 1u; shift < 64u; shift <<= 1u)
+        value ^= value << shift;
+    return value;
+}
+
+/// @brief Mask of the characters escaped by the backslashes ('previous_escaped' is carried between the blocks)
+uint64_t FindEscaped(uint64_t backslashes, bool& previous_escaped) {
+    if (backslashes == 0u && !previous_escaped)
+        return 0u;
+
+    // Escape sequences are rare, so the blocks with them are resolved bit by bit
+    uint64_t escaped{0u};
+    for (unsigned position = 0; position < kBlockSize; ++position) {
+        const uint64_t bit = uint64_t{1u} << position;
+        if (previous_escaped) {
+            escaped |= bit;
+            previous_escaped = false;
+        } else if ((backslashes & bit) != 0u) {
+            previous_escaped = true;
+        }
+    }
+    return escaped;
+}
+
+/// @brief Stage 1: positions of the operators outside the strings, of the opening and closing quotes and of the
+/// starts of the scalars (numbers and literals)
+std::vector<uint32_t> IndexStructurals(std::string_view text) {
+    if (text.size() > std::numeric_limits<uint32_t>::max())
+        throw ParsingError("Input is too big"s);
+
+    std::vector<uint32_t> index;
+    index.reserve(text.size() / 8u);
+
+    uint64_t previous_in_string{0u};  // all ones, if the previous block is ended inside the string
+    uint64_t previous_scalar{0u};     // 1, if the last character of the previous block is the part of the scalar
+    bool previous_escaped{false};
+
+    char tail[kBlockSize];
+    for (size_t offset = 0; offset < text.size(); offset += kBlockSize) {
+        const char* block = text.data() + offset;
+        if (text.size() - offset < kBlockSize) {
+            // Last block is padded by the spaces, which do not change the structure
+            std::memset(tail, ' ', kBlockSize);
+            std::memcpy(tail, block, text.size() - offset);
+            block = tail;
+        }
+
+        const BlockMasks masks = ClassifyBlock(block);
+        const uint64_t quotes = masks.quotes & ~FindEscaped(masks.backslashes, previous_escaped);
+        const uint64_t in_string = PrefixXor(quotes) ^ previous_in_string;
+        previous_in_string = 0u - (in_string >> 63u);
+
+        if ((masks.line_ends & in_string) != 0u)
+            throw ParsingError("Unexpected end of line"s);
+
+        const uint64_t scalars = ~(masks.spaces | masks.operators | quotes | in_string);
+        const uint64_t scalars_starts = scalars & ~(scalars << 1u | previous_scalar);
+        previous_scalar = scalars >> 63u;
+
+        uint64_t structurals = (masks.operators & ~in_string) | quotes | scalars_starts;
+        for (; structurals != 0u; structurals &= structurals - 1u)
+            index.push_back(static_cast<uint32_t>(offset + CountTrailingZeros(structurals)));
+    }
+
+    if (previous_in_string != 0u)
+        throw ParsingError("String parsing error"s);
+
+    return index;
+}
+
+bool IsDigit(char c) {
+    return '0' <= c && c <= '9';
+}
+
+bool IsScalarEnd(char c) {
+    switch (c) {
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r':
+        case '{':
+        case '}':
+        case '[':
+        case ']':
+        case ':':
+        case ',':
+        case '"':
+            return true;
+        default:
+            return false;
+    }
+}
+
+/// @brief Checks the grammar of the JSON number and tells, whether it is the integer one
+bool IsIntegerNumber(std::string_view text) {
+    size_t position{0u};
+    const auto read_digits = [&text, &position] {
+        const size_t begin = position;
+        while (position < text.size() && IsDigit(text[position]))
+            ++position;
+        return position != begin;
+    };
+    const auto skip = [&text, &position](char first, char second) {
+        if (position < text.size() && (text[position] == first || text[position] == second)) {
+            ++position;
+            return true;
+        }
+        return false;
+    };
+
+    bool is_valid = true;
+    bool is_int = true;
+
+    skip('-', '-');
+    // After 0 there could be no other digits in JSON
+    if (!skip('0', '0'))
+        is_valid = read_digits();
+    if (is_valid && skip('.', '.')) {
+        is_valid = read_digits();
+        is_int = false;
+    }
+    if (is_valid && skip('e', 'E')) {
+        skip('+', '-');
+        is_valid = read_digits();
+        is_int = false;
+    }
+
+    if (!is_valid || position != text.size())
+        throw ParsingError("Failed to convert "s + std::string(text) + " to number"s);
+    return is_int;
+}
+
+/// @brief Stage 2: builds the tree by the structural index
+class TreeBuilder {
+public:  // Constructor
+    TreeBuilder(std::string_view text, std::vector<uint32_t> index) : text_(text), index_(std::move(index)) {}
+
+public:  // Methods
+    Node Build() {
+        Node root = ParseValue();
+        if (position_ != index_.size())
+            throw ParsingError("Unexpected data after the end of the document"s);
+        return root;
+    }
+
+private:  // Methods
+    char PeekToken() const {
+        if (position_ == index_.size())
+            throw ParsingError("Unexpected EOF"s);
+        return text_[index_[position_]];
+    }
+
+    char NextToken() {
+        const char token = PeekToken();
+        offset_ = index_[position_++];
+        return token;
+    }
+
+    Node ParseValue() {
+        switch (const char token = NextToken()) {
+            case '{':
+                return ParseDict();
+            case '[':
+                return ParseArray();
+            case '"':
+                return ParseString();
+            case '}':
+            case ']':
+            case ':':
+            case ',':
+                throw ParsingError("Unexpected '"s + token + "' has been found"s);
+            default:
+                return ParseScalar();
+        }
+    }
+
+    Node ParseArray() {
+        const size_t begin = items_.size();
+
+        if (PeekToken() == ']') {
+            ++position_;
+        } else {
+            while (true) {
+                items_.push_back(ParseValue());
+                if (const char token = NextToken(); token == ']')
+                    break;
+                else if (token != ',')
+                    throw ParsingError(R"(',' is expected but ')"s + token + "' has been found"s);
+            }
+        }
+
+        const auto items_begin = items_.begin() + static_cast<std::ptrdiff_t>(begin);
+        Array array(std::make_move_iterator(items_begin), std::make_move_iterator(items_.end()));
+        items_.erase(items_begin, items_.end());
+
+        return Node(std::move(array));
+    }
+
+    Node ParseDict() {
+        const size_t begin = entries_.size();
+
+        if (PeekToken() == '}') {
+            ++position_;
+        } else {
+            while (true) {
+                if (const char token = NextToken(); token != '"')
+                    throw ParsingError("Key is expected but '"s + token + "' has been found"s);
+                std::string key = ParseString();
+
+                if (const char token = NextToken(); token != ':')
+                    throw ParsingError(": is expected but '"s + token + "' has been found"s);
+                Node value = ParseValue();
+                entries_.emplace_back(std::move(key), std::move(value));
+
+                if (const char token = NextToken(); token == '}')
+                    break;
+                else if (token != ',')
+                    throw ParsingError(R"(',' is expected but ')"s + token + "' has been found"s);
+            }
+        }
+
+        const auto entries_begin = entries_.begin() + static_cast<std::ptrdiff_t>(begin);
+        std::vector<Dict::value_type> items(std::make_move_iterator(entries_begin),
+                                            std::make_move_iterator(entries_.end()));
+        entries_.erase(entries_begin, entries_.end());
+
+        return Node(Dict(std::move(items)));
+    }
+
+    std::string ParseString() {
+        // Closing quote is always the next position in the index after the opening one
+        const size_t begin = offset_ + 1u;
+        NextToken();
+        const std::string_view body = text_.substr(begin, offset_ - begin);
+
+        if (std::memchr(body.data(), '\\', body.size()) == nullptr)
+            return std::string(body);
+
+        std::string value;
+        value.reserve(body.size());
+        for (size_t position = 0; position < body.size(); ++position) {
+            if (body[position] != '\\') {
+                value.push_back(body[position]);
+                continue;
+            }
+
+            switch (const char escaped_char = body[++position]) {
+                case 'n':
+                    value.push_back('\n');
+                    break;
+                case 't':
+                    value.push_back('\t');
+                    break;
+                case 'r':
+                    value.push_back('\r');
+                    break;
+                case '"':
+                    value.push_back('"');
+                    break;
+                case '\\':
+                    value.push_back('\\');
+                    break;
+                default:
+                    throw ParsingError("Unrecognized escape sequence \\"s + escaped_char);
+            }
+        }
+        return value;
+    }
+
+    Node ParseScalar() {
+        size_t end = offset_;
+        while (end < text_.size() && !IsScalarEnd(text_[end]))
+            ++end;
+        const std::string_view scalar = text_.substr(offset_, end - offset_);
+
+        switch (scalar.front()) {
+            case 't':
+            case 'f':
+                if (scalar == "true"sv || scalar == "false"sv)
+                    return Node(scalar == "true"sv);
+                throw ParsingError("Failed to parse '"s + std::string(scalar) + "' as bool"s);
+            case 'n':
+                if (scalar == "null"sv)
+                    return Node(nullptr);
+                throw ParsingError("Failed to parse '"s + std::string(scalar) + "' as null"s);
+            default:
+                return ParseNumber(scalar);
+        }
+    }
+
+    static Node ParseNumber(std::string_view text) {
+        const char* begin = text.data();
+        const char* end = text.data() + text.size();
+
+        if (IsIntegerNumber(text)) {
+            // Integer, which does not fit int (overflow), is stored as double
+            int value{0};
+            if (const auto result = std::from_chars(begin, end, value); result.ec == std::errc())
+                return Node(value);
+        }
+
+        double value{0.};
+        if (const auto result = std::from_chars(begin, end, value); result.ec != std::errc())
+            throw ParsingError("Failed to convert "s + std::string(text) + " to number"s);
+        return Node(value);
+    }
+
+private:  // Fields
+    std::string_view text_;
+    std::vector<uint32_t> index_;
+    size_t position_{0u};  // position in the index
+    size_t offset_{0u};    // offset in the text of the last read token
+
+    // Children of the not closed containers: each container uses the top of the stack
+    std::vector<Node> items_;
+    std::vector<Dict::value_type> entries_;
+};
+
+}  // namespace
+
+Document FastLoad(std::istream& input) {
+    return FastLoad(ReadAll(input));
+}
+
+Document FastLoad(std::string_view text) {
+    return Document{TreeBuilder(text, IndexStructurals(text)).Build()};
+}
+
+}  // namespace json
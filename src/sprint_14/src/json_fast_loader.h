@@ -0,0 +1,28 @@
+#pragma once
+
+/*
+ * Description: drop-in alternative to json::Load for the big inputs. The whole input is read into one buffer and
+ * parsed in two stages:
+ *  1. Structural index: blocks of 64 bytes are classified with SIMD (SSE2, if available) into the bit masks of the
+ *     quotes, backslashes, operators and spaces. Masks give the positions of the operators outside the strings, of
+ *     the strings borders and of the scalars starts without the branch per character.
+ *  2. Tree building: the index is walked by the recursive descent. Children of all containers are collected in the
+ *     shared scratch stacks and moved into the vectors of the exact size, when the container is closed, so the
+ *     containers do not grow by reallocations. Numbers are converted by std::from_chars, dictionaries are built by one
+ *     sort of the collected items.
+ *
+ * Result is the same as of json::Load for any valid JSON document, invalid ones cause ParsingError.
+ */
+
+#include <iostream>
+#include <string_view>
+
+#include "json.h"
+
+namespace json {
+
+Document FastLoad(std::istream& input);
+
+Document FastLoad(std::string_view text);
+
+}  // namespace json
@@ -0,0 +1,352 @@
+#include "json_pull_parser.h"
+
+#include <charconv>
+
+namespace json {
+
+namespace {
+using namespace std::literals;
+
+bool IsSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+bool IsDigit(char c) {
+    return '0' <= c && c <= '9';
+}
+
+bool IsAlpha(char c) {
+    return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z');
+}
+
+std::optional<int> ToInt(std::string_view text) {
+    int value{0};
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc() || end != text.data() + text.size())
+        return std::nullopt;
+    return value;
+}
+
+double ToDouble(std::string_view text) {
+    double value{0.};
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc() || end != text.data() + text.size())
+        throw ParsingError("Failed to convert "s + std::string(text) + " to number"s);
+    return value;
+}
+
+}  // namespace
+
+PullParser::PullParser(std::istream& input) : buffer_(ReadAll(input)) {}
+
+PullParser::PullParser(std::string buffer) : buffer_(std::move(buffer)) {}
+
+PullParser::ValueType PullParser::Peek() {
+    SkipSpaces();
+    if (position_ == buffer_.size())
+        throw ParsingError("Unexpected EOF"s);
+
+    switch (buffer_[position_]) {
+        case '{':
+            return ValueType::Dict;
+        case '[':
+            return ValueType::Array;
+        case '"':
+            return ValueType::String;
+        case 't':
+            [[fallthrough]];
+        case 'f':
+            return ValueType::Bool;
+        case 'n':
+            return ValueType::Null;
+        default:
+            return ValueType::Number;
+    }
+}
+
+void PullParser::StartDict() {
+    Expect('{');
+}
+
+std::optional<std::string_view> PullParser::NextKey() {
+    const bool is_first = IsAfter('{');
+    char c = GetNonSpace();
+    if (c == '}')
+        return std::nullopt;
+    if (!is_first) {
+        if (c != ',')
+            throw ParsingError(R"(',' or '}' is expected but ')"s + c + "' has been found"s);
+        c = GetNonSpace();
+    }
+    if (c != '"')
+        throw ParsingError(R"('"' is expected but ')"s + c + "' has been found"s);
+
+    const std::string_view key = ReadStringBody();
+    if (c = GetNonSpace(); c != ':')
+        throw ParsingError(": is expected but '"s + c + "' has been found"s);
+
+    return key;
+}
+
+void PullParser::StartArray() {
+    Expect('[');
+}
+
+bool PullParser::NextItem() {
+    const bool is_first = IsAfter('[');
+    const char c = GetNonSpace();
+    if (c == ']')
+        return false;
+    if (is_first) {
+        --position_;
+        return true;
+    }
+
+    if (c != ',')
+        throw ParsingError(R"(',' or ']' is expected but ')"s + c + "' has been found"s);
+    if (GetNonSpace() == ']')
+        throw ParsingError("Value is expected after ','"s);
+    --position_;
+    return true;
+}
+
+std::string_view PullParser::ReadString() {
+    Expect('"');
+    return ReadStringBody();
+}
+
+int PullParser::ReadInt() {
+    const Number number = ReadNumberText();
+    if (number.is_int) {
+        if (const auto value = ToInt(number.text))
+            return *value;
+    }
+    throw ParsingError("Not an int: "s + std::string(number.text));
+}
+
+double PullParser::ReadDouble() {
+    const Number number = ReadNumberText();
+    if (number.is_int) {
+        if (const auto value = ToInt(number.text))
+            return *value;
+    }
+    return ToDouble(number.text);
+}
+
+bool PullParser::ReadBool() {
+    const std::string_view literal = ReadLiteral();
+    if (literal == "true"sv)
+        return true;
+    if (literal == "false"sv)
+        return false;
+    throw ParsingError("Failed to parse '"s + std::string(literal) + "' as bool"s);
+}
+
+void PullParser::ReadNull() {
+    if (const std::string_view literal = ReadLiteral(); literal != "null"sv)
+        throw ParsingError("Failed to parse '"s + std::string(literal) + "' as null"s);
+}
+
+Node PullParser::ReadNode() {
+    switch (Peek()) {
+        case ValueType::Dict: {
+            std::vector<Dict::value_type> items;
+            StartDict();
+            while (const auto key = NextKey())
+                items.emplace_back(std::string(*key), ReadNode());
+            return Node(Dict(std::move(items)));
+        }
+        case ValueType::Array: {
+            Array array;
+            StartArray();
+            while (NextItem())
+                array.push_back(ReadNode());
+            return Node(std::move(array));
+        }
+        case ValueType::String:
+            return std::string(ReadString());
+        case ValueType::Bool:
+            return ReadBool();
+        case ValueType::Null:
+            ReadNull();
+            return nullptr;
+        case ValueType::Number: {
+            const Number number = ReadNumberText();
+            if (number.is_int) {
+                // Integer, which does not fit int (overflow), is stored as double
+                if (const auto value = ToInt(number.text))
+                    return *value;
+            }
+            return ToDouble(number.text);
+        }
+    }
+    return nullptr;
+}
+
+void PullParser::Skip() {
+    switch (Peek()) {
+        case ValueType::Dict:
+            StartDict();
+            while (NextKey())
+                Skip();
+            break;
+        case ValueType::Array:
+            StartArray();
+            while (NextItem())
+                Skip();
+            break;
+        case ValueType::String:
+            ++position_;
+            ReadStringBody();
+            break;
+        case ValueType::Bool:
+            static_cast<void>(ReadBool());
+            break;
+        case ValueType::Null:
+            ReadNull();
+            break;
+        case ValueType::Number:
+            ReadNumberText();
+            break;
+    }
+}
+
+size_t PullParser::GetPosition() const {
+    return position_;
+}
+
+void PullParser::SetPosition(size_t position) {
+    if (position > buffer_.size())
+        throw std::out_of_range("Position is out of the buffer");
+    position_ = position;
+}
+
+void PullParser::SkipSpaces() {
+    while (position_ < buffer_.size() && IsSpace(buffer_[position_]))
+        ++position_;
+}
+
+char PullParser::GetNonSpace() {
+    SkipSpaces();
+    if (position_ == buffer_.size())
+        throw ParsingError("Unexpected EOF"s);
+    return buffer_[position_++];
+}
+
+bool PullParser::IsAfter(char c) const {
+    size_t position = position_;
+    while (position > 0 && IsSpace(buffer_[position - 1]))
+        --position;
+    return position > 0 && buffer_[position - 1] == c;
+}
+
+void PullParser::Expect(char expected) {
+    if (const char c = GetNonSpace(); c != expected)
+        throw ParsingError("'"s + expected + "' is expected but '"s + c + "' has been found"s);
+}
+
+std::string_view PullParser::ReadStringBody() {
+    // Fast path: the string without the escape sequences is the part of the buffer
+    const size_t begin = position_;
+    while (position_ < buffer_.size()) {
+        const char c = buffer_[position_];
+        if (c == '"') {
+            return std::string_view(buffer_).substr(begin, position_++ - begin);
+        } else if (c == '\\') {
+            break;
+        } else if (c == '\n' || c == '\r') {
+            throw ParsingError("Unexpected end of line"s);
+        }
+        ++position_;
+    }
+
+    std::string value = buffer_.substr(begin, position_ - begin);
+    while (true) {
+        if (position_ == buffer_.size())
+            throw ParsingError("String parsing error");
+
+        const char c = buffer_[position_++];
+        if (c == '"') {
+            break;
+        } else if (c == '\\') {
+            if (position_ == buffer_.size())
+                throw ParsingError("String parsing error");
+
+            const char escaped_char = buffer_[position_++];
+            switch (escaped_char) {
+                case 'n':
+                    value.push_back('\n');
+                    break;
+                case 't':
+                    value.push_back('\t');
+                    break;
+                case 'r':
+                    value.push_back('\r');
+                    break;
+                case '"':
+                    value.push_back('"');
+                    break;
+                case '\\':
+                    value.push_back('\\');
+                    break;
+                default:
+                    throw ParsingError("Unrecognized escape sequence \\"s + escaped_char);
+            }
+        } else if (c == '\n' || c == '\r') {
+            throw ParsingError("Unexpected end of line"s);
+        } else {
+            value.push_back(c);
+        }
+    }
+
+    return unescaped_strings_.Store(value);
+}
+
+std::string_view PullParser::ReadLiteral() {
+    SkipSpaces();
+    const size_t begin = position_;
+    while (position_ < buffer_.size() && IsAlpha(buffer_[position_]))
+        ++position_;
+    return std::string_view(buffer_).substr(begin, position_ - begin);
+}
+
+PullParser::Number PullParser::ReadNumberText() {
+    SkipSpaces();
+    const size_t begin = position_;
+    Number number;
+
+    const auto peek = [this] { return position_ < buffer_.size() ? buffer_[position_] : '\0'; };
+    const auto read_digits = [this, &peek] {
+        if (!IsDigit(peek()))
+            throw ParsingError("A digit is expected"s);
+        while (IsDigit(peek()))
+            ++position_;
+    };
+
+    if (peek() == '-')
+        ++position_;
+    // After 0 there could be no other digits in JSON
+    if (peek() == '0')
+        ++position_;
+    else
+        read_digits();
+
+    if (peek() == '.') {
+        ++position_;
+        read_digits();
+        number.is_int = false;
+    }
+
+    if (const char c = peek(); c == 'e' || c == 'E') {
+        ++position_;
+        if (const char sign = peek(); sign == '+' || sign == '-')
+            ++position_;
+        read_digits();
+        number.is_int = false;
+    }
+
+    number.text = std::string_view(buffer_).substr(begin, position_ - begin);
+    return number;
+}
+
+}  // namespace json
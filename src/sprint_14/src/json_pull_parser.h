@@ -0,0 +1,90 @@
+#pragma once
+
+/*
+ * Description: pull (event based) JSON parser over the contiguous buffer. The whole input is read into memory once,
+ * after that the caller walks the document value by value: enters dictionaries and arrays, reads the keys and the
+ * scalars, skips the not needed values. No DOM is built, so the big inputs are parsed without the allocation per
+ * node. The sub-tree could be still loaded as json::Node, where it is more convenient (small settings objects).
+ *
+ * Strings are returned as the views of the buffer. Strings with the escape sequences are unescaped into the arena of
+ * the parser, so all returned views stay valid until the parser is destroyed.
+ *
+ * Result for the valid documents is the same as of json::Load. Invalid documents cause ParsingError, as in
+ * json::FastLoad (json::Load accepts some of them, e.g. the values without the commas between them).
+ */
+
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "json.h"
+#include "string_arena.h"
+
+namespace json {
+
+class PullParser {
+public:  // Types
+    enum class ValueType { Null, Bool, Number, String, Array, Dict };
+
+public:  // Constructors
+    /// @brief Reads the whole 'input' into the buffer
+    explicit PullParser(std::istream& input);
+    explicit PullParser(std::string buffer);
+
+public:  // Methods
+    /// @brief Type of the next value (throws ParsingError on the end of the input)
+    [[nodiscard]] ValueType Peek();
+
+    /// @brief Enters the dictionary: keys are read by NextKey() until it returns std::nullopt
+    void StartDict();
+    /// @brief Returns the next key of the dictionary (the value after it is the next one to read) or std::nullopt,
+    /// when the dictionary is over
+    [[nodiscard]] std::optional<std::string_view> NextKey();
+
+    /// @brief Enters the array: each item is read after NextItem() returns true
+    void StartArray();
+    [[nodiscard]] bool NextItem();
+
+    [[nodiscard]] std::string_view ReadString();
+    [[nodiscard]] int ReadInt();
+    /// @brief Reads the number (integer one as well)
+    [[nodiscard]] double ReadDouble();
+    [[nodiscard]] bool ReadBool();
+    void ReadNull();
+
+    /// @brief Loads the next value with all nested ones as json::Node
+    [[nodiscard]] Node ReadNode();
+    /// @brief Skips the next value with all nested ones
+    void Skip();
+
+    /// @brief Position in the buffer: the parser could return to the value read before (for example, when the order
+    /// of the keys in the input differs from the order of the processing)
+    [[nodiscard]] size_t GetPosition() const;
+    void SetPosition(size_t position);
+
+private:  // Types
+    struct Number {
+        std::string_view text;
+        bool is_int{true};
+    };
+
+private:  // Methods
+    void SkipSpaces();
+    [[nodiscard]] char GetNonSpace();
+    /// @brief Checks the last not space character before the position. No value ends with '[' or '{', so it tells,
+    /// whether the next item is the first one in the container
+    [[nodiscard]] bool IsAfter(char c) const;
+    void Expect(char expected);
+
+    std::string_view ReadStringBody();
+    std::string_view ReadLiteral();
+    Number ReadNumberText();
+
+private:  // Fields
+    std::string buffer_;
+    size_t position_{0u};
+    memory::StringArena unescaped_strings_;
+};
+
+}  // namespace json
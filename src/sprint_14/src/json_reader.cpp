@@ -1,8 +1,14 @@
 #include "json_reader.h"
 
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <variant>
 
-#include "json_builder.h"
+#include "profiler.h"
+#include "thread_pool.h"
 
 namespace request {
 
@@ -13,107 +19,365 @@ using namespace routing;
 
 namespace {
 
-std::pair<catalogue::Stop, bool> ParseBusStopInput(const json::Dict& info) {
-    Stop stop;
-
-    stop.name = info.at("name"s).AsString();
-    stop.point.lat = info.at("latitude"s).AsDouble();
-    stop.point.lng = info.at("longitude"s).AsDouble();
+// Stat requests are processed by the batches, so the memory for the responses is bounded. Each task of the thread pool
+// is a few requests: the costs of the requests differ a lot (e.g. Map and Bus), so the tasks are small for the balance
+constexpr size_t kRequestsBatchSize{512u};
+constexpr size_t kRequestsPerTask{8u};
+
+/// @brief Base request, which is read in one pass. Road distances and stops of the bus refer to the stops, which
+/// could be added by the next requests, so they are skipped and only their positions in the input are stored
+struct BaseRequest {
+    std::string_view type;
+    std::string_view name;
+    geo::Coordinates point;
+    bool is_roundtrip{false};
+    std::optional<size_t> road_distances;
+    std::optional<size_t> stops;
+};
 
-    bool has_road_distances = !info.at("road_distances"s).AsDict().empty();
+BaseRequest ParseBaseRequest(json::PullParser& parser) {
+    BaseRequest request;
+
+    parser.StartDict();
+    while (const auto key = parser.NextKey()) {
+        if (*key == "type"sv) {
+            request.type = parser.ReadString();
+        } else if (*key == "name"sv) {
+            request.name = parser.ReadString();
+        } else if (*key == "latitude"sv) {
+            request.point.lat = parser.ReadDouble();
+        } else if (*key == "longitude"sv) {
+            request.point.lng = parser.ReadDouble();
+        } else if (*key == "is_roundtrip"sv) {
+            request.is_roundtrip = parser.ReadBool();
+        } else if (*key == "road_distances"sv) {
+            request.road_distances = parser.GetPosition();
+            parser.Skip();
+        } else if (*key == "stops"sv) {
+            request.stops = parser.GetPosition();
+            parser.Skip();
+        } else {
+            parser.Skip();
+        }
+    }
 
-    return {std::move(stop), has_road_distances};
+    return request;
 }
 
-Bus ParseBusRouteInput(const json::Dict& info) {
-    Bus bus;
-
-    bus.number = info.at("name"s).AsString();
-    bus.type = info.at("is_roundtrip"s).AsBool() ? RouteType::CIRCLE : RouteType::TWO_DIRECTIONAL;
+Bus ParseBusRouteInput(const BaseRequest& request, json::PullParser& parser) {
+    if (!request.stops)
+        throw std::out_of_range("No stops of the bus "s + std::string(request.name));
 
-    const auto& stops = info.at("stops"s).AsArray();
-    bus.stop_names.reserve(stops.size());
+    Bus bus;
 
-    for (const auto& stop : stops)
-        bus.stop_names.emplace_back(stop.AsString());
+    bus.number = std::string(request.name);
+    bus.type = request.is_roundtrip ? RouteType::CIRCLE : RouteType::TWO_DIRECTIONAL;
 
-    bus.unique_stops = {bus.stop_names.begin(), bus.stop_names.end()};
+    // Views of the names stay valid until the parser is destroyed
+    parser.SetPosition(*request.stops);
+    parser.StartArray();
+    while (parser.NextItem())
+        bus.stop_names.emplace_back(parser.ReadString());
 
     return bus;
 }
 
-void MakeBusResponse(int request_id, const BusStatistics& statistics, json::Builder& json_builder) {
-    // P.S. no need to use std::move() because all types on the right are trivial
+/// @brief Positions of the values of the request fields, so the fields are read in the order of the processing, which
+/// could differ from the order in the input
+class RequestFields {
+public:  // Constructor
+    explicit RequestFields(json::PullParser& parser) : parser_(parser) {
+        parser_.StartDict();
+        while (const auto key = parser_.NextKey()) {
+            if (Find(*key))
+                throw json::ParsingError("Duplicate key '"s + std::string(*key) + "' have been found");
+            fields_.emplace_back(*key, parser_.GetPosition());
+            parser_.Skip();
+        }
+        end_ = parser_.GetPosition();
+    }
 
-    json_builder.StartDict();
-    json_builder.Key("curvature"s).Value(statistics.curvature);
-    json_builder.Key("request_id"s).Value(request_id);
-    json_builder.Key("route_length"s).Value(statistics.rout_length);
-    json_builder.Key("stop_count"s).Value(static_cast<int>(statistics.stops_count));
-    json_builder.Key("unique_stop_count"s).Value(static_cast<int>(statistics.unique_stops_count));
-    json_builder.EndDict();
+public:  // Methods
+    /// @brief Moves the parser to the value of the field (throws std::out_of_range if there is no such field)
+    json::PullParser& At(std::string_view key) const {
+        if (const auto position = Find(key)) {
+            parser_.SetPosition(*position);
+            return parser_;
+        }
+        throw std::out_of_range("No field "s + std::string(key) + " in the request"s);
+    }
+
+    /// @brief Moves the parser to the end of the request
+    void SkipToEnd() const {
+        parser_.SetPosition(end_);
+    }
+
+private:  // Methods
+    [[nodiscard]] std::optional<size_t> Find(std::string_view key) const {
+        for (const auto& [field, position] : fields_) {
+            if (field == key)
+                return position;
+        }
+        return std::nullopt;
+    }
+
+private:  // Fields
+    json::PullParser& parser_;
+    std::vector<std::pair<std::string_view, size_t>> fields_;
+    size_t end_{0u};
+};
+
+// Keys of the responses are written in the alphabetical order, as json::Print of the responses tree has done before
+
+void MakeBusResponse(int request_id, const BusStatistics& statistics, json::Writer& json_writer) {
+    json_writer.StartDict();
+    json_writer.Key("curvature"sv).Value(statistics.curvature);
+    json_writer.Key("request_id"sv).Value(request_id);
+    json_writer.Key("route_length"sv).Value(statistics.rout_length);
+    json_writer.Key("stop_count"sv).Value(static_cast<int>(statistics.stops_count));
+    json_writer.Key("unique_stop_count"sv).Value(static_cast<int>(statistics.unique_stops_count));
+    json_writer.EndDict();
 }
 
-void MakeStopResponse(int request_id, const std::set<std::string_view>& buses, json::Builder& json_builder) {
-    json_builder.StartDict();
-    json_builder.Key("request_id"s).Value(request_id);
+void MakeStopResponse(int request_id, TransportCatalogue::BusesRange buses, const RequestHandler& handler,
+                      json::Writer& json_writer) {
+    json_writer.StartDict();
 
-    json_builder.Key("buses"s).StartArray();
-    for (std::string_view bus : buses)
-        json_builder.Value(std::string(bus));
-    json_builder.EndArray();
+    json_writer.Key("buses"sv).StartArray();
+    for (BusId bus : buses)
+        json_writer.Value(handler.GetBusNumber(bus));
+    json_writer.EndArray();
 
-    json_builder.EndDict();
+    json_writer.Key("request_id"sv).Value(request_id);
+    json_writer.EndDict();
 }
 
-struct RouteItemVisitor {
-    json::Builder& json;
+void MakeRouteItemResponse(const routing::ResponseItem& item, json::Writer& json_writer) {
+    switch (item.type) {
+        case ResponseType::Wait:
+            json_writer.Key("stop_name"sv).Value(item.name);
+            json_writer.Key("time"sv).Value(item.time);
+            json_writer.Key("type"sv).Value("Wait"sv);
+            break;
+        case ResponseType::Bus:
+            json_writer.Key("bus"sv).Value(item.name);
+            json_writer.Key("span_count"sv).Value(item.span_count);
+            json_writer.Key("time"sv).Value(item.time);
+            json_writer.Key("type"sv).Value("Bus"sv);
+            break;
+    }
+}
+
+void MakeRouteResponse(int request_id, const routing::ResponseData& route_info, json::Writer& json_writer) {
+    json_writer.StartDict();
+
+    json_writer.Key("items"sv).StartArray();
 
-    void operator()(const WaitResponse& response) const {
-        json.Key("type"s).Value(response.type);
-        json.Key("stop_name"s).Value(response.stop_name);
-        json.Key("time"s).Value(response.time);
+    for (const auto& item : route_info.items) {
+        json_writer.StartDict();
+        MakeRouteItemResponse(item, json_writer);
+        json_writer.EndDict();
     }
 
-    void operator()(const BusResponse& response) const {
-        json.Key("type"s).Value(response.type);
-        json.Key("bus").Value(response.bus);
-        json.Key("span_count"s).Value(response.span_count);
-        json.Key("time"s).Value(response.time);
+    json_writer.EndArray();
+
+    json_writer.Key("request_id"sv).Value(request_id);
+    json_writer.Key("total_time"sv).Value(route_info.total_time);
+
+    json_writer.EndDict();
+}
+
+void MakeRouteMatrixResponse(int request_id, const routing::RouteTimesMatrix& matrix, json::Writer& json_writer) {
+    json_writer.StartDict();
+    json_writer.Key("request_id"sv).Value(request_id);
+
+    // Absent route is null
+    json_writer.Key("total_times"sv).StartArray();
+    for (const auto& row : matrix) {
+        json_writer.StartArray();
+        for (const auto& time : row) {
+            if (time)
+                json_writer.Value(*time);
+            else
+                json_writer.Value(nullptr);
+        }
+        json_writer.EndArray();
     }
-};
+    json_writer.EndArray();
 
-void MakeRouteResponse(int request_id, const routing::ResponseData& route_info, json::Builder& json_builder) {
-    json_builder.StartDict();
+    json_writer.EndDict();
+}
 
-    json_builder.Key("request_id"s).Value(request_id);
-    json_builder.Key("total_time"s).Value(route_info.total_time);
+std::vector<std::string_view> ParseStopNames(json::PullParser& names) {
+    std::vector<std::string_view> stops;
+    names.StartArray();
+    while (names.NextItem())
+        stops.emplace_back(names.ReadString());
+    return stops;
+}
 
-    json_builder.Key("items"s).StartArray();
+geo::Coordinates ParseCoordinates(const RequestFields& info, const std::string& prefix = ""s) {
+    const double latitude = info.At(prefix + "latitude"s).ReadDouble();
+    return {latitude, info.At(prefix + "longitude"s).ReadDouble()};
+}
 
-    for (const auto& item : route_info.items) {
-        json_builder.StartDict();
-        std::visit(RouteItemVisitor{json_builder}, item);
-        json_builder.EndDict();
+/// @brief Route endpoint is either the name of the stop or the point, which is snapped to the nearest route stop
+using RouteEndpoint = std::variant<std::string_view, geo::Coordinates>;
+
+RouteEndpoint ParseRouteEndpoint(json::PullParser& endpoint) {
+    if (endpoint.Peek() == json::PullParser::ValueType::String)
+        return endpoint.ReadString();
+    return ParseCoordinates(RequestFields(endpoint));
+}
+
+/// @brief Stop of the catalogue (the router throws std::out_of_range on the unknown stop name)
+bool IsKnownStop(std::string_view stop, const RequestHandler& handler) {
+    return handler.GetBusesThroughTheStop(stop).has_value();
+}
+
+bool AreKnownStops(const std::vector<std::string_view>& stops, const RequestHandler& handler) {
+    return std::all_of(stops.begin(), stops.end(),
+                       [&handler](std::string_view stop) { return IsKnownStop(stop, handler); });
+}
+
+/// @brief Name of the stop, which is the end of the route (std::nullopt if there is no such stop)
+std::optional<std::string_view> FindRouteEndpointStop(const RouteEndpoint& endpoint, const RequestHandler& handler) {
+    if (const auto* name = std::get_if<std::string_view>(&endpoint)) {
+        if (!IsKnownStop(*name, handler))
+            return std::nullopt;
+        return *name;
+    }
+    return handler.FindNearestRouteStop(std::get<geo::Coordinates>(endpoint));
+}
+
+/// @brief Stat request, which is read completely before the processing, so the requests are answered in parallel, while
+/// the parser is used by one thread only (names are the views of the parser buffer)
+struct StatRequest {
+    int id{0};
+    std::string_view type;
+    std::string_view name;  // Bus, Stop
+    RouteEndpoint from;     // Route
+    RouteEndpoint to;
+    std::vector<std::string_view> stops_from;  // RouteMatrix
+    std::vector<std::string_view> stops_to;
+    geo::Coordinates point;  // NearestStops
+    size_t count{0u};
+    geo::Coordinates min;  // StopsInBox
+    geo::Coordinates max;
+};
+
+StatRequest ParseStatRequest(json::PullParser& parser) {
+    const RequestFields fields(parser);
+    StatRequest request;
+
+    request.id = fields.At("id"sv).ReadInt();
+    request.type = fields.At("type"sv).ReadString();
+
+    if (request.type == "Bus"sv || request.type == "Stop"sv) {
+        request.name = fields.At("name"sv).ReadString();
+    } else if (request.type == "Route"sv) {
+        request.from = ParseRouteEndpoint(fields.At("from"sv));
+        request.to = ParseRouteEndpoint(fields.At("to"sv));
+    } else if (request.type == "RouteMatrix"sv) {
+        request.stops_from = ParseStopNames(fields.At("from"sv));
+        request.stops_to = ParseStopNames(fields.At("to"sv));
+    } else if (request.type == "NearestStops"sv) {
+        request.point = ParseCoordinates(fields);
+        request.count = static_cast<size_t>(std::max(fields.At("count"sv).ReadInt(), 0));
+    } else if (request.type == "StopsInBox"sv) {
+        request.min = ParseCoordinates(fields, "min_"s);
+        request.max = ParseCoordinates(fields, "max_"s);
+    }
+
+    fields.SkipToEnd();
+    return request;
+}
+
+void MakeNearestStopsResponse(int request_id, const std::vector<RequestHandler::NearbyStop>& stops,
+                              json::Writer& json_writer) {
+    json_writer.StartDict();
+    json_writer.Key("request_id"sv).Value(request_id);
+
+    json_writer.Key("stops"sv).StartArray();
+    for (const auto& [name, distance] : stops) {
+        json_writer.StartDict();
+        json_writer.Key("distance"sv).Value(distance);
+        json_writer.Key("name"sv).Value(name);
+        json_writer.EndDict();
     }
+    json_writer.EndArray();
 
-    json_builder.EndArray();
+    json_writer.EndDict();
+}
+
+void MakeStopsInBoxResponse(int request_id, const std::vector<std::string_view>& stops, json::Writer& json_writer) {
+    json_writer.StartDict();
+    json_writer.Key("request_id"sv).Value(request_id);
+
+    json_writer.Key("stops"sv).StartArray();
+    for (std::string_view stop : stops)
+        json_writer.Value(stop);
+    json_writer.EndArray();
+
+    json_writer.EndDict();
+}
 
-    json_builder.EndDict();
+void MakeErrorResponse(int request_id, json::Writer& json_writer) {
+    json_writer.StartDict();
+    json_writer.Key("error_message"sv).Value("not found"sv);
+    json_writer.Key("request_id"sv).Value(request_id);
+    json_writer.EndDict();
 }
 
-void MakeErrorResponse(int request_id, json::Builder& json_builder) {
-    json_builder.StartDict();
-    json_builder.Key("request_id"s).Value(request_id);
-    json_builder.Key("error_message"s).Value("not found"s);
-    json_builder.EndDict();
+void MakeMapImageResponse(int request_id, const std::string& image, json::Writer& json_writer) {
+    json_writer.StartDict();
+    json_writer.Key("map"sv).Value(image);
+    json_writer.Key("request_id"sv).Value(request_id);
+    json_writer.EndDict();
 }
 
-void MakeMapImageResponse(int request_id, const std::string& image, json::Builder& json_builder) {
-    json_builder.StartDict();
-    json_builder.Key("request_id"s).Value(request_id);
-    json_builder.Key("map"s).Value(image);
-    json_builder.EndDict();
+/// @brief Writes the response to the request (nothing is written for the request of the unknown type)
+void MakeStatResponse(const StatRequest& request, const RequestHandler& handler, json::Writer& response) {
+    const int request_id = request.id;
+    const std::string_view type = request.type;
+
+    if (type == "Bus"sv) {
+        if (auto bus_statistics = handler.GetBusStat(request.name)) {
+            MakeBusResponse(request_id, *bus_statistics, response);
+        } else {
+            MakeErrorResponse(request_id, response);
+        }
+    } else if (type == "Stop"sv) {
+        if (auto buses = handler.GetBusesThroughTheStop(request.name)) {
+            MakeStopResponse(request_id, *buses, handler, response);
+        } else {
+            MakeErrorResponse(request_id, response);
+        }
+    } else if (type == "Map"sv) {
+        MakeMapImageResponse(request_id, handler.RenderMap(), response);
+    } else if (type == "Route"sv) {
+        const auto stop_name_from = FindRouteEndpointStop(request.from, handler);
+        const auto stop_name_to = FindRouteEndpointStop(request.to, handler);
+
+        if (!stop_name_from || !stop_name_to) {
+            MakeErrorResponse(request_id, response);
+        } else if (auto route_info = handler.BuildRoute(*stop_name_from, *stop_name_to)) {
+            MakeRouteResponse(request_id, *route_info, response);
+        } else {
+            MakeErrorResponse(request_id, response);
+        }
+    } else if (type == "RouteMatrix"sv) {
+        if (AreKnownStops(request.stops_from, handler) && AreKnownStops(request.stops_to, handler)) {
+            MakeRouteMatrixResponse(request_id, handler.BuildRouteMatrix(request.stops_from, request.stops_to),
+                                    response);
+        } else {
+            MakeErrorResponse(request_id, response);
+        }
+    } else if (type == "NearestStops"sv) {
+        MakeNearestStopsResponse(request_id, handler.FindNearestStops(request.point, request.count), response);
+    } else if (type == "StopsInBox"sv) {
+        MakeStopsInBoxResponse(request_id, handler.FindStopsInBox(request.min, request.max), response);
+    }
 }
 
 /* METHODS FOR MAP IMAGE RENDERING */
@@ -168,45 +432,47 @@ render::UnderLayer ParseLayer(const json::Dict& settings) {
 
 }  // namespace
 
-TransportCatalogue ProcessBaseRequest(const json::Array& requests) {
+TransportCatalogue ProcessBaseRequest(json::PullParser& requests) {
+    PROFILE_SCOPE("ProcessBaseRequest");
+
     TransportCatalogue catalogue;
 
     // We could add distances between stops ONLY when they EXIST in catalogue
-    std::vector<int> requests_ids_with_road_distances;
-    requests_ids_with_road_distances.reserve(requests.size());
-
-    std::vector<int> requests_ids_with_buses;
-    requests_ids_with_buses.reserve(requests.size());
+    std::vector<std::pair<std::string_view, size_t>> road_distances_positions;
+    std::vector<BaseRequest> buses_requests;
 
     // Step 1. Store all stops to the catalog and mark requests, needed to be processed afterward
-    for (int id = 0; id != static_cast<int>(requests.size()); ++id) {
-        const auto& request_dict_view = requests.at(id).AsDict();
+    requests.StartArray();
+    while (requests.NextItem()) {
+        auto request = ParseBaseRequest(requests);
 
-        if (request_dict_view.at("type"s) == "Stop"s) {
-            auto [stop, has_road_distances] = ParseBusStopInput(request_dict_view);
-            if (has_road_distances)
-                requests_ids_with_road_distances.emplace_back(id);
+        if (request.type == "Stop"sv) {
+            if (request.road_distances)
+                road_distances_positions.emplace_back(request.name, *request.road_distances);
 
-            catalogue.AddStop(std::move(stop));
-        } else if (request_dict_view.at("type"s) == "Bus"s) {
-            requests_ids_with_buses.emplace_back(id);
+            catalogue.AddStop({std::string(request.name), request.point});
+        } else if (request.type == "Bus"sv) {
+            buses_requests.push_back(request);
         }
     }
+    const size_t requests_end = requests.GetPosition();
 
     // Step 2. Add distances between all stops
-    for (int id : requests_ids_with_road_distances) {
-        const auto& request_dict_view = requests.at(id).AsDict();
-
-        std::string_view stop_from = request_dict_view.at("name"s).AsString();
-        for (const auto& [stop_to, distance] : request_dict_view.at("road_distances"s).AsDict())
-            catalogue.AddDistance(stop_from, stop_to, distance.AsInt());
+    for (const auto& [stop_from, position] : road_distances_positions) {
+        requests.SetPosition(position);
+        requests.StartDict();
+        while (const auto stop_to = requests.NextKey())
+            catalogue.AddDistance(stop_from, *stop_to, requests.ReadInt());
     }
 
     // Step 3. Add info about buses routes through stops
-    for (int id : requests_ids_with_buses) {
-        const auto& request_dict_view = requests.at(id).AsDict();
-        catalogue.AddBus(ParseBusRouteInput(request_dict_view));
-    }
+    for (const auto& request : buses_requests)
+        catalogue.AddBus(ParseBusRouteInput(request, requests));
+
+    requests.SetPosition(requests_end);
+
+    // Step 4. Precompute statistics of the buses, so it is stored in the base and not computed on the requests
+    catalogue.ComputeBusStatistics();
 
     return catalogue;
 }
@@ -239,48 +505,45 @@ std::string ParseSerializationSettings(const json::Dict& settings) {
     return settings.at("file"s).AsString();
 }
 
-json::Node MakeStatisticsResponse(RequestHandler& handler, const json::Array& requests) {
-    auto response = json::Builder();
-    response.StartArray();
+void MakeStatisticsResponse(const RequestHandler& handler, json::PullParser& requests, json::Writer& response) {
+    PROFILE_SCOPE("MakeStatisticsResponse");
 
-    for (const auto& request : requests) {
-        const auto& request_dict_view = request.AsDict();
+    // Requests are answered by the threads of the pool batch by batch. Each response is written into its own string
+    // (reorder buffer), and the strings are written into the output in the order of the requests
+    std::vector<StatRequest> batch;
+    std::vector<std::string> responses;
 
-        int request_id = request_dict_view.at("id"s).AsInt();
-        std::string type = request_dict_view.at("type"s).AsString();
-        std::string name;  //> Could be a name of bus or a stop
+    const auto process_batch = [&handler, &batch, &responses, &response] {
+        responses.resize(batch.size());
 
-        if (type == "Bus"s) {
-            name = request_dict_view.at("name"s).AsString();
-
-            if (auto bus_statistics = handler.GetBusStat(name)) {
-                MakeBusResponse(request_id, *bus_statistics, response);
-            } else {
-                MakeErrorResponse(request_id, response);
-            }
-        } else if (type == "Stop"s) {
-            name = request_dict_view.at("name"s).AsString();
-            if (auto buses = handler.GetBusesThroughTheStop(name)) {
-                MakeStopResponse(request_id, *buses, response);
-            } else {
-                MakeErrorResponse(request_id, response);
-            }
-        } else if (type == "Map"s) {
-            MakeMapImageResponse(request_id, handler.RenderMap(), response);
-        } else if (type == "Route"s) {
-            std::string stop_name_from = request_dict_view.at("from"s).AsString();
-            std::string stop_name_to = request_dict_view.at("to"s).AsString();
-
-            if (auto route_info = handler.BuildRoute(stop_name_from, stop_name_to)) {
-                MakeRouteResponse(request_id, *route_info, response);
-            } else {
-                MakeErrorResponse(request_id, response);
+        const size_t tasks_count = (batch.size() + kRequestsPerTask - 1) / kRequestsPerTask;
+        parallel::ThreadPool::Instance().Run(tasks_count, [&handler, &batch, &responses](size_t task_id) {
+            const size_t end = std::min((task_id + 1) * kRequestsPerTask, batch.size());
+            for (size_t index = task_id * kRequestsPerTask; index < end; ++index) {
+                responses[index].clear();
+                json::Writer writer(responses[index], 1u);
+                MakeStatResponse(batch[index], handler, writer);
             }
+        });
+
+        for (size_t index = 0; index < batch.size(); ++index) {
+            if (!responses[index].empty())
+                response.RawValue(responses[index]);
         }
+        batch.clear();
+    };
+
+    response.StartArray();
+
+    requests.StartArray();
+    while (requests.NextItem()) {
+        batch.push_back(ParseStatRequest(requests));
+        if (batch.size() == kRequestsBatchSize)
+            process_batch();
     }
+    process_batch();
 
     response.EndArray();
-    return std::move(response.Build());
 }
 
 routing::Settings ParseRoutingSettings(const json::Dict& requests) {
@@ -288,12 +551,32 @@ routing::Settings ParseRoutingSettings(const json::Dict& requests) {
 
     auto meter_per_min = [](double km_per_hour) { return 1'000. * km_per_hour / 60.; };
 
-    // clang-format off
-    Settings settings{
-        meter_per_min(requests.at("bus_velocity"s).AsDouble()),
-        requests.at("bus_wait_time"s).AsInt()
-    };
-    // clang-format on
+    Settings settings;
+    settings.bus_velocity_ = meter_per_min(requests.at("bus_velocity"s).AsDouble());
+    settings.bus_wait_time_ = requests.at("bus_wait_time"s).AsInt();
+
+    // Optional: algorithm of the shortest routes search
+    if (const auto type_position = requests.find("router_type"s); type_position != requests.end()) {
+        const auto& type = type_position->second.AsString();
+        if (type == "all_pairs"s)
+            settings.router_type_ = RouterType::AllPairs;
+        else if (type == "all_pairs_dijkstra"s)
+            settings.router_type_ = RouterType::AllPairsDijkstra;
+        else if (type == "dijkstra"s)
+            settings.router_type_ = RouterType::Dijkstra;
+        else if (type == "contraction_hierarchies"s)
+            settings.router_type_ = RouterType::ContractionHierarchies;
+        else if (type == "raptor"s)
+            settings.router_type_ = RouterType::Raptor;
+        else
+            throw std::invalid_argument("Unknown router type: "s + type);
+    }
+
+    if (const auto size_position = requests.find("router_cache_size"s); size_position != requests.end())
+        settings.router_cache_size_ = static_cast<size_t>(size_position->second.AsInt());
+
+    if (const auto float_position = requests.find("router_float_weights"s); float_position != requests.end())
+        settings.router_float_weights_ = float_position->second.AsBool();
 
     return settings;
 }
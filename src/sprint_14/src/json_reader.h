@@ -6,12 +6,15 @@
  */
 
 #include "json.h"
+#include "json_pull_parser.h"
+#include "json_writer.h"
 // #include "map_renderer.h"
 #include "request_handler.h"
 
 namespace request {
 
-catalogue::TransportCatalogue ProcessBaseRequest(const json::Array& requests);
+/// @brief Forms the catalogue from the array of the base requests, which is the next value of the parser
+catalogue::TransportCatalogue ProcessBaseRequest(json::PullParser& requests);
 
 render::Visualization ParseVisualizationSettings(const json::Dict& settings);
 
@@ -19,6 +22,8 @@ routing::Settings ParseRoutingSettings(const json::Dict& requests);
 
 std::string ParseSerializationSettings(const json::Dict& settings);
 
-json::Node MakeStatisticsResponse(RequestHandler& handler, const json::Array& requests);
+/// @brief Writes the responses to the array of the stat requests, which is the next value of the parser. Requests are
+/// answered in parallel, responses are written in the order of the requests
+void MakeStatisticsResponse(const RequestHandler& handler, json::PullParser& requests, json::Writer& response);
 
 }  // namespace request
\ No newline at end of file
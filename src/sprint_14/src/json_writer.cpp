@@ -0,0 +1,254 @@
+#include "json_writer.h"
+
+#include <charconv>
+#include <iterator>
+#include <stdexcept>
+
+namespace json {
+
+using namespace std::literals;
+
+Writer::Writer(std::ostream& output, size_t buffer_size)
+    : stream_(&output), buffer_(own_buffer_), buffer_size_(buffer_size) {
+    buffer_.reserve(buffer_size_);
+}
+
+Writer::Writer(std::string& output, size_t depth) : buffer_(output), depth_(depth) {}
+
+Writer::~Writer() {
+    try {
+        Flush();
+    } catch (...) {
+        // Destructor should not throw: the state of the output stream is checked by the caller
+    }
+}
+
+Writer& Writer::Key(std::string_view key) {
+    if (levels_.empty() || !levels_.back().is_dict || levels_.back().has_key)
+        throw std::logic_error("Incorrect attempt to add key :"s + std::string(key));
+
+    Level& level = levels_.back();
+    if (!level.is_empty)
+        Write(",\n"sv);
+    WriteIndent();
+    WriteEscaped(key);
+    Write(": "sv);
+
+    level.is_empty = false;
+    level.has_key = true;
+    return *this;
+}
+
+Writer& Writer::Value(std::nullptr_t) {
+    StartValue();
+    Write("null"sv);
+    EndValue();
+    return *this;
+}
+
+Writer& Writer::Value(bool value) {
+    StartValue();
+    Write(value ? "true"sv : "false"sv);
+    EndValue();
+    return *this;
+}
+
+Writer& Writer::Value(int value) {
+    StartValue();
+    char text[16];
+    const auto result = std::to_chars(std::begin(text), std::end(text), value);
+    Write(std::string_view(text, static_cast<size_t>(result.ptr - text)));
+    EndValue();
+    return *this;
+}
+
+Writer& Writer::Value(double value) {
+    StartValue();
+    // Format of std::ostream by default: the shortest of the fixed and scientific ones with 6 significant digits
+    char text[32];
+    const auto result = std::to_chars(std::begin(text), std::end(text), value, std::chars_format::general, 6);
+    Write(std::string_view(text, static_cast<size_t>(result.ptr - text)));
+    EndValue();
+    return *this;
+}
+
+Writer& Writer::Value(std::string_view value) {
+    StartValue();
+    WriteEscaped(value);
+    EndValue();
+    return *this;
+}
+
+Writer& Writer::Value(const std::string& value) {
+    return Value(std::string_view(value));
+}
+
+Writer& Writer::Value(const char* value) {
+    return Value(std::string_view(value));
+}
+
+Writer& Writer::Value(const Node& node) {
+    if (node.IsArray()) {
+        StartArray();
+        for (const Node& item : node.AsArray())
+            Value(item);
+        return EndArray();
+    }
+    if (node.IsDict()) {
+        StartDict();
+        for (const auto& [key, value] : node.AsDict())
+            Key(key).Value(value);
+        return EndDict();
+    }
+
+    if (node.IsNull())
+        return Value(nullptr);
+    if (node.IsBool())
+        return Value(node.AsBool());
+    if (node.IsInt())
+        return Value(node.AsInt());
+    if (node.IsPureDouble())
+        return Value(node.AsDouble());
+    return Value(node.AsString());
+}
+
+Writer& Writer::RawValue(std::string_view value) {
+    StartValue();
+    Write(value);
+    EndValue();
+    return *this;
+}
+
+Writer& Writer::StartDict() {
+    StartContainer(true, '{');
+    return *this;
+}
+
+Writer& Writer::EndDict() {
+    if (levels_.empty() || !levels_.back().is_dict || levels_.back().has_key)
+        throw std::logic_error("Incorrect attempt to end Dict()");
+
+    EndContainer('}');
+    return *this;
+}
+
+Writer& Writer::StartArray() {
+    StartContainer(false, '[');
+    return *this;
+}
+
+Writer& Writer::EndArray() {
+    if (levels_.empty() || levels_.back().is_dict)
+        throw std::logic_error("Incorrect attempt to end Array()");
+
+    EndContainer(']');
+    return *this;
+}
+
+void Writer::Flush() {
+    if (stream_ == nullptr)
+        return;
+
+    stream_->write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+}
+
+void Writer::StartValue() {
+    if (levels_.empty()) {
+        if (is_root_written_)
+            throw std::logic_error("Incorrect attempt to add Value after the end of JSON");
+        return;
+    }
+
+    Level& level = levels_.back();
+    if (level.is_dict) {
+        // Value of the dictionary follows its key
+        if (!level.has_key)
+            throw std::logic_error("Incorrect attempt to add Value without the key");
+        level.has_key = false;
+        return;
+    }
+
+    if (!level.is_empty)
+        Write(",\n"sv);
+    WriteIndent();
+    level.is_empty = false;
+}
+
+void Writer::EndValue() {
+    if (levels_.empty())
+        is_root_written_ = true;
+}
+
+void Writer::StartContainer(bool is_dict, char bracket) {
+    StartValue();
+    Write(bracket);
+    Write('\n');
+    levels_.push_back({is_dict});
+}
+
+void Writer::EndContainer(char bracket) {
+    levels_.pop_back();
+    Write('\n');
+    WriteIndent();
+    Write(bracket);
+    EndValue();
+}
+
+void Writer::Write(std::string_view text) {
+    if (stream_ != nullptr && buffer_.size() + text.size() > buffer_size_) {
+        Flush();
+        // Text, which is bigger than the buffer, is written directly
+        if (text.size() > buffer_size_) {
+            stream_->write(text.data(), static_cast<std::streamsize>(text.size()));
+            return;
+        }
+    }
+    buffer_.append(text);
+}
+
+void Writer::Write(char c) {
+    if (stream_ != nullptr && buffer_.size() >= buffer_size_)
+        Flush();
+    buffer_.push_back(c);
+}
+
+void Writer::WriteIndent() {
+    for (size_t indent = (depth_ + levels_.size()) * kIndentStep; indent > 0; --indent)
+        Write(' ');
+}
+
+void Writer::WriteEscaped(std::string_view value) {
+    Write('"');
+
+    // Characters between the escaped ones are written by the whole runs
+    size_t run_begin{0u};
+    for (size_t position = 0; position < value.size(); ++position) {
+        std::string_view escaped;
+        switch (value[position]) {
+            case '\r':
+                escaped = "\\r"sv;
+                break;
+            case '\n':
+                escaped = "\\n"sv;
+                break;
+            case '"':
+                escaped = "\\\""sv;
+                break;
+            case '\\':
+                escaped = "\\\\"sv;
+                break;
+            default:
+                continue;
+        }
+
+        Write(value.substr(run_begin, position - run_begin));
+        Write(escaped);
+        run_begin = position + 1u;
+    }
+    Write(value.substr(run_begin));
+
+    Write('"');
+}
+
+}  // namespace json
@@ -0,0 +1,96 @@
+#pragma once
+
+/*
+ * Description: streaming JSON writer. It has the interface of json::Builder (Key, Value, StartDict, EndDict,
+ * StartArray, EndArray with the same checks of the correct JSON creation), but the values are serialized at once into
+ * the big buffer, which is flushed into the output stream, when it is full. So the responses are not stored as the
+ * tree of nodes and are not copied before the printing.
+ *
+ * Output is the same as of json::Print for the document with the same keys order (json::Print sorts the keys).
+ *
+ * Parts of the document could be written separately (e.g. in the different threads) into the strings by the writers
+ * of the nested values and then inserted into the document by RawValue().
+ */
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "json.h"
+
+namespace json {
+
+class Writer {
+public:  // Constructors
+    explicit Writer(std::ostream& output, size_t buffer_size = kDefaultBufferSize);
+    /// @brief Writer of the value, which is nested into the document on the 'depth' level (indents are the same as of
+    /// the whole document), into the end of 'output'
+    explicit Writer(std::string& output, size_t depth = 0u);
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    /// @brief Flushes the rest of the buffer into the output
+    ~Writer();
+
+public:  // Methods
+    /// @throws std::logic_error in case of incorrect attempt of JSON creation (as json::Builder)
+    Writer& Key(std::string_view key);
+
+    Writer& Value(std::nullptr_t);
+    Writer& Value(bool value);
+    Writer& Value(int value);
+    Writer& Value(double value);
+    Writer& Value(std::string_view value);
+    Writer& Value(const std::string& value);
+    Writer& Value(const char* value);
+    /// @brief Writes the node with all nested ones
+    Writer& Value(const Node& node);
+    /// @brief Writes the value, which is already serialized by the writer of the same depth
+    Writer& RawValue(std::string_view value);
+
+    Writer& StartDict();
+    Writer& EndDict();
+
+    Writer& StartArray();
+    Writer& EndArray();
+
+    /// @brief Writes the buffer into the output stream
+    void Flush();
+
+private:  // Types
+    struct Level {
+        bool is_dict{false};
+        bool is_empty{true};
+        bool has_key{false};  // for the dictionary: key is written, value is expected
+    };
+
+private:  // Constants
+    static constexpr size_t kDefaultBufferSize{64u * 1024u};
+    static constexpr size_t kIndentStep{4u};
+
+private:  // Methods
+    void StartValue();
+    void EndValue();
+
+    void StartContainer(bool is_dict, char bracket);
+    void EndContainer(char bracket);
+
+    void Write(std::string_view text);
+    void Write(char c);
+    void WriteIndent();
+    void WriteEscaped(std::string_view value);
+
+private:  // Fields
+    std::ostream* stream_{nullptr};  // nullptr, if the output is the string
+    std::string own_buffer_;
+    std::string& buffer_;
+    size_t buffer_size_{kDefaultBufferSize};
+    size_t depth_{0u};
+
+    std::vector<Level> levels_;
+    bool is_root_written_{false};
+};
+
+}  // namespace json
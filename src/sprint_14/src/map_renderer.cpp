@@ -84,15 +84,15 @@ void MapImageRenderer::PutRouteLines() {
     int route_id{0};
     bool is_previous_route_empty{true};
 
-    for (std::string_view bus_name : catalogue_.GetOrderedBusList()) {
-        auto [bus, stops] = catalogue_.GetRouteInfo(bus_name);
+    for (catalogue::BusId bus : catalogue_.GetOrderedBuses()) {
+        const auto stops = catalogue_.GetRouteStops(bus);
 
         // If there are no stops on the route, the route following it must use the same index in the palette
         route_id = is_previous_route_empty ? route_id : route_id + 1;
 
         svg::Polyline route;
-        for (const auto& stop : stops)
-            route.AddPoint(ToScreenPosition(stop->point));
+        for (catalogue::StopId stop : stops)
+            route.AddPoint(ToScreenPosition(catalogue_.GetStopPoint(stop)));
 
         image_.Add(route.SetStrokeColor(TakeColorById(route_id))
                        .SetFillColor("none"s)
@@ -111,8 +111,8 @@ void MapImageRenderer::PutRouteNames() {
     int route_id{0};
     bool is_previous_route_empty{true};
 
-    for (std::string_view bus_name : catalogue_.GetOrderedBusList()) {
-        auto [bus, stops] = catalogue_.GetFinalStops(bus_name);
+    for (catalogue::BusId bus : catalogue_.GetOrderedBuses()) {
+        const auto stops = catalogue_.GetFinalStops(bus);
 
         // If there are no stops on the route, the route following it must use the same index in the palette
         route_id = is_previous_route_empty ? route_id : route_id + 1;
@@ -121,16 +121,16 @@ void MapImageRenderer::PutRouteNames() {
         if (stops.empty())
             continue;
 
-        for (const auto& stop : stops) {
+        for (catalogue::StopId stop : stops) {
             // Background - first
             image_.Add(svg::Text()
-                           .SetData(bus->number)
+                           .SetData(std::string(catalogue_.GetBusNumber(bus)))
                            .SetFillColor(under_layer_settings.color_)
                            .SetStrokeColor(under_layer_settings.color_)
                            .SetStrokeWidth(under_layer_settings.width_)
                            .SetStrokeLineCap(svg::StrokeLineCap::ROUND)
                            .SetStrokeLineJoin(svg::StrokeLineJoin::ROUND)
-                           .SetPosition(ToScreenPosition(stop->point))
+                           .SetPosition(ToScreenPosition(catalogue_.GetStopPoint(stop)))
                            .SetOffset(bus_settings.offset_)
                            .SetFontSize(bus_settings.font_size_)
                            .SetFontFamily("Verdana")
@@ -138,8 +138,8 @@ void MapImageRenderer::PutRouteNames() {
 
             // Text - second
             image_.Add(svg::Text()
-                           .SetData(bus->number)
-                           .SetPosition(ToScreenPosition(stop->point))
+                           .SetData(std::string(catalogue_.GetBusNumber(bus)))
+                           .SetPosition(ToScreenPosition(catalogue_.GetStopPoint(stop)))
                            .SetOffset(bus_settings.offset_)
                            .SetFontSize(bus_settings.font_size_)
                            .SetFontFamily("Verdana"s)
@@ -152,9 +152,9 @@ void MapImageRenderer::PutRouteNames() {
 }
 
 void MapImageRenderer::PutStopCircles() {
-    for (const auto& [_, stop] : catalogue_.GetAllStopsFromRoutes())
+    for (catalogue::StopId stop : catalogue_.GetAllStopsFromRoutes())
         image_.Add(svg::Circle()
-                       .SetCenter(ToScreenPosition(stop->point))
+                       .SetCenter(ToScreenPosition(catalogue_.GetStopPoint(stop)))
                        .SetRadius(settings_.stop_radius_)
                        .SetFillColor("white"s));
 }
@@ -163,25 +163,25 @@ void MapImageRenderer::PutStopNames() {
     const auto& stop_settings = settings_.labels_.at(LabelType::Stop);
     const auto& under_layer_settings = settings_.under_layer_;
 
-    for (const auto& [_, stop] : catalogue_.GetAllStopsFromRoutes()) {
+    for (catalogue::StopId stop : catalogue_.GetAllStopsFromRoutes()) {
         // Background - first
         image_.Add(svg::Text()
-                       .SetData(stop->name)
+                       .SetData(std::string(catalogue_.GetStopName(stop)))
                        .SetFillColor(under_layer_settings.color_)
                        .SetStrokeColor(under_layer_settings.color_)
                        .SetStrokeWidth(under_layer_settings.width_)
                        .SetStrokeLineCap(svg::StrokeLineCap::ROUND)
                        .SetStrokeLineJoin(svg::StrokeLineJoin::ROUND)
-                       .SetPosition(ToScreenPosition(stop->point))
+                       .SetPosition(ToScreenPosition(catalogue_.GetStopPoint(stop)))
                        .SetOffset(stop_settings.offset_)
                        .SetFontSize(stop_settings.font_size_)
                        .SetFontFamily("Verdana"s));
 
         // Text - second
         image_.Add(svg::Text()
-                       .SetData(stop->name)
+                       .SetData(std::string(catalogue_.GetStopName(stop)))
                        .SetFillColor("black"s)
-                       .SetPosition(ToScreenPosition(stop->point))
+                       .SetPosition(ToScreenPosition(catalogue_.GetStopPoint(stop)))
                        .SetOffset(stop_settings.offset_)
                        .SetFontSize(stop_settings.font_size_)
                        .SetFontFamily("Verdana"s));
@@ -0,0 +1,200 @@
+#include "raptor_router.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace routing {
+
+/// @brief State of the query: arrays are reused between the queries of the thread, only touched items are reset
+struct RaptorRouter::Search {
+    std::vector<double> labels;
+    std::vector<Parent> parents;
+    std::vector<StopId> touched;
+
+    // Stops improved on the current round
+    std::vector<bool> is_marked;
+    std::vector<StopId> marked;
+
+    // First position to scan in each pattern on the next round
+    std::vector<size_t> first_positions;
+    std::vector<PatternId> queued_patterns;
+
+    void Reset(size_t stops_count, size_t patterns_count) {
+        for (StopId stop : touched) {
+            labels[stop] = kInfinity;
+            is_marked[stop] = false;
+        }
+        touched.clear();
+        marked.clear();
+
+        if (labels.size() < stops_count) {
+            labels.resize(stops_count, kInfinity);
+            parents.resize(stops_count);
+            is_marked.resize(stops_count, false);
+        }
+        if (first_positions.size() < patterns_count)
+            first_positions.resize(patterns_count, kNoPosition);
+    }
+
+    void Improve(StopId stop, double label, Parent parent) {
+        if (labels[stop] == kInfinity)
+            touched.push_back(stop);
+        labels[stop] = label;
+        parents[stop] = parent;
+
+        if (!is_marked[stop]) {
+            is_marked[stop] = true;
+            marked.push_back(stop);
+        }
+    }
+};
+
+RaptorRouter::RaptorRouter(const catalogue::TransportCatalogue& catalogue, double bus_velocity, double wait_time)
+    : catalogue_(catalogue), wait_time_(wait_time) {
+    // Two-directional bus is the pair of patterns: forward and backward
+    for (catalogue::BusId bus = 0; bus < catalogue_.GetBusesCount(); ++bus) {
+        std::vector<StopId> stops = catalogue_.GetRouteStops(bus, false);
+        AddPattern(catalogue_.GetBusNumber(bus), stops, bus_velocity);
+        if (catalogue_.GetBusType(bus) == catalogue::RouteType::TWO_DIRECTIONAL) {
+            std::reverse(stops.begin(), stops.end());
+            AddPattern(catalogue_.GetBusNumber(bus), stops, bus_velocity);
+        }
+    }
+
+    BuildStopPatterns();
+}
+
+void RaptorRouter::AddPattern(std::string_view bus, const std::vector<StopId>& stops, double bus_velocity) {
+    if (stops.size() < 2)
+        return;
+
+    patterns_.push_back({bus, pattern_stops_.size(), pattern_stops_.size() + stops.size()});
+    for (size_t index = 0; index < stops.size(); ++index) {
+        pattern_stops_.push_back(stops[index]);
+        const double time = index == 0 ? 0. : catalogue_.GetDistance(stops[index - 1], stops[index]) / bus_velocity;
+        segment_times_.push_back(time);
+    }
+}
+
+void RaptorRouter::BuildStopPatterns() {
+    const size_t stops_count = catalogue_.GetStopsCount();
+
+    stop_offsets_.assign(stops_count + 1, 0u);
+    for (StopId stop : pattern_stops_)
+        ++stop_offsets_[stop + 1];
+    for (size_t stop = 0; stop < stops_count; ++stop)
+        stop_offsets_[stop + 1] += stop_offsets_[stop];
+
+    stop_patterns_.resize(pattern_stops_.size());
+    std::vector<size_t> next_positions(stop_offsets_.begin(), stop_offsets_.end() - 1);
+    for (PatternId pattern_id = 0; pattern_id < patterns_.size(); ++pattern_id) {
+        for (size_t position = patterns_[pattern_id].begin; position < patterns_[pattern_id].end; ++position)
+            stop_patterns_[next_positions[pattern_stops_[position]]++] = {pattern_id, position};
+    }
+}
+
+void RaptorRouter::ScanPattern(PatternId pattern_id, size_t first_position, StopId target, Search& search) const {
+    const auto& pattern = patterns_[pattern_id];
+
+    bool is_boarded{false};
+    size_t board_position{0u};
+    double board_label{0.};  // arrival to the boarding stop + wait time
+    double ride_time{0.};
+
+    for (size_t position = first_position; position < pattern.end; ++position) {
+        const StopId stop = pattern_stops_[position];
+
+        if (is_boarded) {
+            ride_time += segment_times_[position];
+            const double label = board_label + ride_time;
+            if (label < search.labels[stop] && (target == kNoStop || label < search.labels[target]))
+                search.Improve(stop, label, {pattern_id, board_position, position, ride_time});
+        }
+
+        // Passenger changes the boarding stop, if it is cheaper to wait for the same bus here
+        if (search.labels[stop] != kInfinity) {
+            const double label = search.labels[stop] + wait_time_;
+            if (!is_boarded || label < board_label + ride_time) {
+                is_boarded = true;
+                board_position = position;
+                board_label = label;
+                ride_time = 0.;
+            }
+        }
+    }
+}
+
+std::optional<RaptorRouter::Journey> RaptorRouter::BuildRoute(std::string_view from, std::string_view to) const {
+    const StopId source = catalogue_.GetStopId(from);
+    const StopId target = catalogue_.GetStopId(to);
+    if (source == target)
+        return Journey{};
+
+    return RestoreJourney(Run(source, target), source, target);
+}
+
+std::vector<std::optional<RaptorRouter::Journey>> RaptorRouter::BuildRoutes(
+    std::string_view from, const std::vector<std::string_view>& to) const {
+    const StopId source = catalogue_.GetStopId(from);
+    const Search& search = Run(source, kNoStop);
+
+    std::vector<std::optional<Journey>> journeys;
+    journeys.reserve(to.size());
+    for (std::string_view stop : to)
+        journeys.push_back(RestoreJourney(search, source, catalogue_.GetStopId(stop)));
+
+    return journeys;
+}
+
+RaptorRouter::Search& RaptorRouter::Run(StopId source, StopId target) const {
+    static thread_local Search search;
+    search.Reset(catalogue_.GetStopsCount(), patterns_.size());
+    search.Improve(source, 0., {});
+
+    while (!search.marked.empty()) {
+        // Step 1. Collect patterns through the marked stops with the first marked position in each of them
+        for (StopId stop : search.marked) {
+            search.is_marked[stop] = false;
+            for (size_t index = stop_offsets_[stop]; index < stop_offsets_[stop + 1]; ++index) {
+                const auto [pattern_id, position] = stop_patterns_[index];
+                auto& first_position = search.first_positions[pattern_id];
+                if (first_position == kNoPosition)
+                    search.queued_patterns.push_back(pattern_id);
+                first_position = std::min(first_position, position);
+            }
+        }
+        search.marked.clear();
+
+        // Step 2. Scan the patterns: improved stops are marked for the next round
+        for (PatternId pattern_id : search.queued_patterns) {
+            ScanPattern(pattern_id, search.first_positions[pattern_id], target, search);
+            search.first_positions[pattern_id] = kNoPosition;
+        }
+        search.queued_patterns.clear();
+    }
+
+    return search;
+}
+
+std::optional<RaptorRouter::Journey> RaptorRouter::RestoreJourney(const Search& search, StopId source,
+                                                                  StopId target) const {
+    if (source == target)
+        return Journey{};
+    if (search.labels[target] == kInfinity)
+        return std::nullopt;
+
+    Journey journey{search.labels[target], {}};
+    for (StopId stop = target; stop != source;) {
+        const auto& parent = search.parents[stop];
+        const StopId board_stop = pattern_stops_[parent.board_position];
+
+        journey.legs.push_back({catalogue_.GetStopName(board_stop), patterns_[parent.pattern].bus,
+                                static_cast<int>(parent.alight_position - parent.board_position), parent.ride_time});
+        stop = board_stop;
+    }
+    std::reverse(journey.legs.begin(), journey.legs.end());
+
+    return journey;
+}
+
+}  // namespace routing
@@ -0,0 +1,107 @@
+#pragma once
+
+/*
+ * Description: transit router, which works directly with the bus routes (RAPTOR-like, Round-bAsed Public Transit
+ * Optimized Router). In comparison with the graph routers there are no edges between each pair of stops of the bus
+ * route, which is O(L^2) for the route of length L: each route is stored as the sequence of its stops with the travel
+ * time between the neighbours, so the data is linear in the total length of the routes.
+ *
+ * Query works in rounds. Each round scans the routes, which pass through the stops improved on the previous round,
+ * starting from the first improved stop: passenger boards the bus at the stop with the cheapest "arrival + wait" and
+ * rides it to the next stops. The search stops, when no stop has been improved. Stops, which are not better than the
+ * best known time of the destination, are not marked (target pruning).
+ *
+ * Times are accumulated in the same order as on the graph (wait, then the ride time summed up stop by stop from the
+ * boarding stop), so the route time is the same as the one found by the graph routers.
+ */
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "transport_catalogue.h"
+
+namespace routing {
+
+class RaptorRouter {
+public:  // Types
+    /// @brief Part of the journey: wait for the 'bus' on the 'stop', then ride 'span_count' stops during 'time'
+    struct Leg {
+        std::string_view stop;
+        std::string_view bus;
+        int span_count{0};
+        double time{0.};
+    };
+
+    struct Journey {
+        double total_time{0.};
+        std::vector<Leg> legs;
+    };
+
+public:  // Constructor
+    RaptorRouter(const catalogue::TransportCatalogue& catalogue, double bus_velocity, double wait_time);
+
+public:  // Methods
+    [[nodiscard]] std::optional<Journey> BuildRoute(std::string_view from, std::string_view to) const;
+    /// @brief Journeys from one stop to each of the stops 'to': they are restored after one search without pruning
+    [[nodiscard]] std::vector<std::optional<Journey>> BuildRoutes(std::string_view from,
+                                                                  const std::vector<std::string_view>& to) const;
+
+private:  // Types
+    using StopId = catalogue::StopId;
+    using PatternId = uint32_t;
+
+    /// @brief Sequence of stops visited by the bus in one direction: positions [begin, end) of the flat arrays
+    struct Pattern {
+        std::string_view bus;
+        size_t begin{0u};
+        size_t end{0u};
+    };
+
+    struct PatternPosition {
+        PatternId pattern{0u};
+        size_t position{0u};
+    };
+
+    /// @brief How the stop has been reached: by the pattern from the boarding position to the alighting one
+    struct Parent {
+        PatternId pattern{0u};
+        size_t board_position{0u};
+        size_t alight_position{0u};
+        double ride_time{0.};
+    };
+
+    struct Search;
+
+private:  // Constants
+    static constexpr double kInfinity{std::numeric_limits<double>::infinity()};
+    static constexpr size_t kNoPosition{std::numeric_limits<size_t>::max()};
+    static constexpr StopId kNoStop{std::numeric_limits<StopId>::max()};
+
+private:  // Methods
+    void AddPattern(std::string_view bus, const std::vector<StopId>& stops, double bus_velocity);
+    void BuildStopPatterns();
+
+    /// @brief Runs the rounds from 'source' (stops are pruned by the 'target' label, if it is not kNoStop)
+    Search& Run(StopId source, StopId target) const;
+    void ScanPattern(PatternId pattern_id, size_t first_position, StopId target, Search& search) const;
+    std::optional<Journey> RestoreJourney(const Search& search, StopId source, StopId target) const;
+
+private:  // Fields
+    // Stops ids of the catalogue are used as is, names are resolved by the catalogue
+    const catalogue::TransportCatalogue& catalogue_;
+    double wait_time_{0.};
+
+    std::vector<Pattern> patterns_;
+    // pattern_stops_[i] is the stop on the position i, segment_times_[i] is the ride time from the previous position
+    std::vector<StopId> pattern_stops_;
+    std::vector<double> segment_times_;
+
+    // Patterns passing through the stop S: [stop_offsets_[S], stop_offsets_[S + 1]) of stop_patterns_
+    std::vector<size_t> stop_offsets_;
+    std::vector<PatternPosition> stop_patterns_;
+};
+
+}  // namespace routing
@@ -1,9 +1,13 @@
 #include "request_handler.h"
 
+#include <algorithm>
 #include <fstream>
+#include <optional>
+#include <stdexcept>
 #include <string>
 
 #include "json_reader.h"
+#include "profiler.h"
 #include "serialization.h"
 
 namespace request {
@@ -12,84 +16,192 @@ using namespace std::literals;
 using namespace catalogue;
 using namespace routing;
 
+namespace {
+/// @brief Index of the stops points: ids of the points are the positions of the stops in 'stops'
+geo::GridIndex MakeStopsIndex(const TransportCatalogue& db, const std::vector<StopId>& stops) {
+    std::vector<geo::Coordinates> points;
+    points.reserve(stops.size());
+    for (StopId stop : stops)
+        points.push_back(db.GetStopPoint(stop));
+    return geo::GridIndex(points);
+}
+
+std::vector<StopId> GetAllStops(const TransportCatalogue& db) {
+    std::vector<StopId> stops(db.GetStopsCount());
+    for (StopId stop = 0; stop < stops.size(); ++stop)
+        stops[stop] = stop;
+    return stops;
+}
+
+/// @brief Stops of the bus routes ordered by ids, so the nearest stops with the equal distances are ordered by ids
+std::vector<StopId> GetRouteStops(const TransportCatalogue& db) {
+    std::vector<StopId> stops = db.GetAllStopsFromRoutes();
+    std::sort(stops.begin(), stops.end());
+    return stops;
+}
+}  // namespace
+
 RequestHandler::RequestHandler(const catalogue::TransportCatalogue& db, request::ResponseSettings settings)
-    : db_(db), settings_(std::move(settings)) {}
+    : RequestHandler(db, [&db, routing = settings.routing] { return TransportRouter(db, routing); }, settings) {}
+
+RequestHandler::RequestHandler(const catalogue::TransportCatalogue& db, RouterBuilder builder,
+                               request::ResponseSettings settings)
+    : db_(db),
+      settings_(std::move(settings)),
+      stops_index_(MakeStopsIndex(db, GetAllStops(db))),
+      route_stops_(GetRouteStops(db)),
+      route_stops_index_(MakeStopsIndex(db, route_stops_)) {
+    router_ = std::async(std::launch::async, [builder = std::move(builder)] {
+                  PROFILE_SCOPE("RequestHandler::BuildRouter");
+                  return builder();
+              }).share();
+}
 
 RequestHandler::RequestHandler(const catalogue::TransportCatalogue& db, routing::TransportRouter router,
                                request::ResponseSettings settings)
-    : db_(db), settings_(std::move(settings)), router_(std::make_optional(std::move(router))) {}
+    : db_(db),
+      settings_(std::move(settings)),
+      stops_index_(MakeStopsIndex(db, GetAllStops(db))),
+      route_stops_(GetRouteStops(db)),
+      route_stops_index_(MakeStopsIndex(db, route_stops_)) {
+    std::promise<TransportRouter> ready_router;
+    ready_router.set_value(std::move(router));
+    router_ = ready_router.get_future().share();
+}
 
 std::optional<catalogue::BusStatistics> RequestHandler::GetBusStat(const std::string_view& bus_name) const {
     return db_.GetBusStatistics(bus_name);
 }
 
-std::unique_ptr<std::set<std::string_view>> RequestHandler::GetBusesThroughTheStop(
+std::optional<catalogue::TransportCatalogue::BusesRange> RequestHandler::GetBusesThroughTheStop(
     const std::string_view& stop_name) const {
     return db_.GetBusesPassingThroughTheStop(stop_name);
 }
 
+std::string_view RequestHandler::GetBusNumber(catalogue::BusId bus) const {
+    return db_.GetBusNumber(bus);
+}
+
 std::string RequestHandler::RenderMap() const {
     return render::RenderTransportMap(db_, settings_.visualization);
 }
 
+std::vector<RequestHandler::NearbyStop> RequestHandler::FindNearestStops(geo::Coordinates point, size_t count) const {
+    std::vector<NearbyStop> stops;
+    for (const auto& [stop, distance] : stops_index_.FindNearest(point, count))
+        stops.push_back({db_.GetStopName(stop), distance});
+    return stops;
+}
+
+std::vector<std::string_view> RequestHandler::FindStopsInBox(geo::Coordinates min, geo::Coordinates max) const {
+    std::vector<std::string_view> stops;
+    for (StopId stop : stops_index_.FindInBox(min, max))
+        stops.push_back(db_.GetStopName(stop));
+    std::sort(stops.begin(), stops.end());
+    return stops;
+}
+
+std::optional<std::string_view> RequestHandler::FindNearestRouteStop(geo::Coordinates point) const {
+    const auto stops = route_stops_index_.FindNearest(point, 1u);
+    if (stops.empty())
+        return std::nullopt;
+    return db_.GetStopName(route_stops_[stops.front().id]);
+}
+
 routing::ResponseDataOpt RequestHandler::BuildRoute(std::string_view from, std::string_view to) const {
-    // Create router if it is still empty - crete only once
-    if (!router_.has_value())
-        router_.emplace(routing::TransportRouter(db_, settings_.routing));
+    // Waits only if the router is still being built (rethrows the exception, if the building has failed)
+    return router_.get().BuildRoute(from, to);
+}
+
+std::vector<routing::ResponseDataOpt> RequestHandler::BuildRoutes(std::string_view from,
+                                                                  const std::vector<std::string_view>& to) const {
+    return router_.get().BuildRoutes(from, to);
+}
 
-    return router_->BuildRoute(from, to);
+routing::RouteTimesMatrix RequestHandler::BuildRouteMatrix(const std::vector<std::string_view>& from,
+                                                           const std::vector<std::string_view>& to) const {
+    return router_.get().BuildRouteMatrix(from, to);
 }
 
 void ProcessMakeBaseQuery(std::istream& input) {
+    PROFILE_SCOPE("ProcessMakeBaseQuery");
     ResponseSettings settings;
 
-    const auto request_body = json::Load(input).GetRoot();
+    // Base requests are processed while parsing (without the DOM), small settings objects are loaded as nodes
+    json::PullParser parser(input);
+    json::Dict settings_objects;
+    std::optional<TransportCatalogue> transport_catalogue;
+
+    parser.StartDict();
+    while (const auto key = parser.NextKey()) {
+        if (*key == "base_requests"sv)
+            transport_catalogue = ProcessBaseRequest(parser);
+        else
+            settings_objects.emplace(std::string(*key), parser.ReadNode());
+    }
 
     // Step 1. Get serialization path
-    const auto& serialization_object = request_body.AsDict().at("serialization_settings").AsDict();
+    const auto& serialization_object = settings_objects.at("serialization_settings"s).AsDict();
     settings.path_to_db = catalogue::Path(ParseSerializationSettings(serialization_object));
 
     // Step 2. Form catalogue, basing on the input
-    const auto& base_requests = request_body.AsDict().at("base_requests"s).AsArray();
-    auto transport_catalogue = ProcessBaseRequest(base_requests);
+    if (!transport_catalogue)
+        throw std::out_of_range("No base requests in the input");
 
     // Step 3. Parse rendering settings
-    const auto& render_object = request_body.AsDict().at("render_settings"s).AsDict();
+    const auto& render_object = settings_objects.at("render_settings"s).AsDict();
     settings.visualization = ParseVisualizationSettings(render_object);
 
     // Step 4. Parse routing settings
-    const auto& routing_object = request_body.AsDict().at("routing_settings"s).AsDict();
+    const auto& routing_object = settings_objects.at("routing_settings"s).AsDict();
     settings.routing = ParseRoutingSettings(routing_object);
 
     // Step 5. Serialization
     std::ofstream output(settings.path_to_db, std::ios::binary);
-    serialization::SerializeTransportCatalogue(output, transport_catalogue);
+    serialization::SerializeTransportCatalogue(output, *transport_catalogue);
     serialization::SerializeVisualizationSettings(output, settings.visualization);
-    serialization::SerializeTransportRouter(output, TransportRouter(transport_catalogue, settings.routing));
+    serialization::SerializeTransportRouter(output, TransportRouter(*transport_catalogue, settings.routing));
 }
 
 void ProcessRequestsQuery(std::istream& input, std::ostream& output) {
+    PROFILE_SCOPE("ProcessRequestsQuery");
     ResponseSettings settings;
 
-    const auto request_body = json::Load(input).GetRoot();
+    // Stat requests need the deserialized base, so they are only skipped here and read after the deserialization
+    json::PullParser parser(input);
+    json::Dict settings_objects;
+    std::optional<size_t> stat_requests_position;
+
+    parser.StartDict();
+    while (const auto key = parser.NextKey()) {
+        if (*key == "stat_requests"sv) {
+            stat_requests_position = parser.GetPosition();
+            parser.Skip();
+        } else {
+            settings_objects.emplace(std::string(*key), parser.ReadNode());
+        }
+    }
 
     // Step 1. Get deserialization path
-    const auto& serialization_object = request_body.AsDict().at("serialization_settings").AsDict();
+    const auto& serialization_object = settings_objects.at("serialization_settings"s).AsDict();
     settings.path_to_db = catalogue::Path(ParseSerializationSettings(serialization_object));
 
-    // Step 2. Deserialization
+    // Step 2. Deserialization (router is deserialized in the background, while the other requests are processed)
     const auto transport_catalogue = serialization::DeserializeTransportCatalogue(settings.path_to_db);
-    auto router = serialization::DeserializeTransportRouter(settings.path_to_db, transport_catalogue);
     settings.visualization = serialization::DeserializeVisualizationSettings(settings.path_to_db);
 
-    // Step 3. Form a response
-    const auto& stat_requests = request_body.AsDict().at("stat_requests"s).AsArray();
+    const auto deserialize_router = [&path = settings.path_to_db, &transport_catalogue] {
+        return serialization::DeserializeTransportRouter(path, transport_catalogue);
+    };
 
-    // TODO: add router here
-    RequestHandler handler_(transport_catalogue, std::move(router), settings);
-    auto response = MakeStatisticsResponse(handler_, stat_requests);
+    // Step 3. Form a response
+    if (!stat_requests_position)
+        throw std::out_of_range("No stat requests in the input");
+    parser.SetPosition(*stat_requests_position);
 
-    json::Print(json::Document{std::move(response)}, output);
+    RequestHandler handler_(transport_catalogue, deserialize_router, settings);
+    json::Writer response(output);
+    MakeStatisticsResponse(handler_, parser, response);
 }
 
 }  // namespace request
@@ -2,10 +2,21 @@
 
 /*
  * Description: module for the requests processing.
- * Acts as a Facade that simplifies interaction with the transport directory
+ * Acts as a Facade that simplifies interaction with the transport directory.
+ *
+ * Router is built (or deserialized) in the background thread, which is started in the constructor, so the requests,
+ * which do not need the router, are answered meanwhile. Only "Route" requests wait for the router, if it is not ready.
+ *
+ * Spatial indices of the stops are built in the constructor, after the catalogue has been loaded: they answer the
+ * queries by the coordinates (e.g. GPS position of the user). Points are snapped for the routing to the nearest stops
+ * of the bus routes, so the index of these stops is separate.
  */
 
+#include <functional>
+#include <future>
+
 #include "map_renderer.h"
+#include "spatial_index.h"
 #include "transport_catalogue.h"
 #include "transport_router.h"
 
@@ -19,21 +30,50 @@ struct ResponseSettings {
 
 /// @brief Class acts as a facade for the methods, required during the response creation
 class RequestHandler {
+public:  // Types
+    using RouterBuilder = std::function<routing::TransportRouter()>;
+
+    struct NearbyStop {
+        std::string_view name;
+        double distance{0.};
+    };
+
 public:  // Constructor
+    /// @brief Starts the router building from the catalogue in the background
     RequestHandler(const catalogue::TransportCatalogue& db, ResponseSettings settings);
+    /// @brief Starts the router building by 'builder' (e.g. deserialization) in the background
+    RequestHandler(const catalogue::TransportCatalogue& db, RouterBuilder builder, ResponseSettings settings);
     RequestHandler(const catalogue::TransportCatalogue& db, routing::TransportRouter router, ResponseSettings settings);
 
 public:  // Methods
     std::optional<catalogue::BusStatistics> GetBusStat(const std::string_view& bus_name) const;
-    std::unique_ptr<std::set<std::string_view>> GetBusesThroughTheStop(const std::string_view& stop_name) const;
+    std::optional<catalogue::TransportCatalogue::BusesRange> GetBusesThroughTheStop(
+        const std::string_view& stop_name) const;
+    std::string_view GetBusNumber(catalogue::BusId bus) const;
     std::string RenderMap() const;
+
+    /// @brief Up to 'count' stops nearest to the 'point' ordered by the distance
+    std::vector<NearbyStop> FindNearestStops(geo::Coordinates point, size_t count) const;
+    /// @brief Stops inside the box ordered by their names
+    std::vector<std::string_view> FindStopsInBox(geo::Coordinates min, geo::Coordinates max) const;
+    /// @brief Stop of any bus route nearest to the 'point' (std::nullopt if there are no such stops). Only these stops
+    /// could be the ends of the routes
+    std::optional<std::string_view> FindNearestRouteStop(geo::Coordinates point) const;
+
     routing::ResponseDataOpt BuildRoute(std::string_view from, std::string_view to) const;
+    std::vector<routing::ResponseDataOpt> BuildRoutes(std::string_view from,
+                                                      const std::vector<std::string_view>& to) const;
+    routing::RouteTimesMatrix BuildRouteMatrix(const std::vector<std::string_view>& from,
+                                               const std::vector<std::string_view>& to) const;
 
 private:  // Fields
     const catalogue::TransportCatalogue& db_;
     ResponseSettings settings_;
-    // Mutable, because it is "Lazy Evaluation" object, creates only in case there is at least one "Route" request
-    mutable routing::TransportRouterOpt router_{std::nullopt};
+    geo::GridIndex stops_index_;  // ids of the points are the ids of the stops
+    std::vector<catalogue::StopId> route_stops_;
+    geo::GridIndex route_stops_index_;  // ids of the points are the positions in route_stops_
+    // Router, which is being built in the background. Destructor waits for the building end
+    std::shared_future<routing::TransportRouter> router_;
 };
 
 void ProcessMakeBaseQuery(std::istream& input);
@@ -3,115 +3,308 @@
 /*
  * Description: class, which finds the graph path between two edges which has minimal weight.
  * Used to build the shortest route between the pair of stops in transport catalogue.
+ *
+ * All routes are precomputed in the constructor with one of the algorithms:
+ *  - FloydWarshall: O(V^3) relaxation through each vertex. The table is processed by the square tiles (blocked
+ *    Floyd-Warshall), so the relaxation works with the tiles in cache, and the independent tiles are processed by the
+ *    threads of the pool;
+ *  - ParallelDijkstra: independent Dijkstra search from each source vertex, O(V * E * log(V)) in total. Sources are
+ *    distributed between the threads of the pool, each search fills only its own row of the table.
+ *
+ * Table is stored as two flat row-major V x V arrays (structure of arrays): weights, where the absent route is
+ * encoded by the infinite weight, and 32-bit ids of the last route edges. Route reconstruction reads only one row of
+ * the edges array. 'TableWeight' could be narrower than 'Weight' (e.g. float for double): it halves the table, while
+ * the weight of the built route is still summed up from the original edges.
+ *
+ * Table could be taken from Data and restored by the constructor, so the precomputation is done only once for the
+ * graph (e.g. when the table is stored in the base).
+ *
+ * Graph should be frozen (see DirectedWeightedGraph::Freeze).
  */
 
 #include <algorithm>
-#include <cassert>
 #include <cstdint>
-#include <iterator>
+#include <functional>
+#include <limits>
 #include <optional>
 #include <stdexcept>
-#include <unordered_map>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "graph.h"
+#include "thread_pool.h"
 
 namespace graph {
 
+/// @brief Algorithm of the all-pairs shortest routes precomputation
+enum class AllPairsAlgorithm { FloydWarshall, ParallelDijkstra };
+
+/// @brief Shortest route: its weight and the edges in the order of the route
 template <typename Weight>
+struct RouteInfo {
+    Weight weight;
+    std::vector<EdgeId> edges;
+};
+
+template <typename Weight, typename TableWeight = Weight>
 class Router {
 private:
     using Graph = DirectedWeightedGraph<Weight>;
 
+    static_assert(std::numeric_limits<TableWeight>::has_infinity, "Absent routes are encoded by the infinite weight");
+
 public:
-    explicit Router(const Graph& graph);
+    using TableEdgeId = uint32_t;
 
-    struct RouteInfo {
-        Weight weight;
-        std::vector<EdgeId> edges;
+    /// @brief Routes table, which is enough to restore the router for the same graph
+    struct Data {
+        std::vector<TableWeight> weights;
+        std::vector<TableEdgeId> prev_edges;
     };
 
+    explicit Router(const Graph& graph, AllPairsAlgorithm algorithm = AllPairsAlgorithm::FloydWarshall);
+    Router(const Graph& graph, Data data);
+
+    using RouteInfo = graph::RouteInfo<Weight>;
+
     std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to) const;
+    /// @brief Routes from one vertex to each of the vertices 'to' (all of them are in the same row of the table)
+    std::vector<std::optional<RouteInfo>> BuildRoutes(VertexId from, const std::vector<VertexId>& to) const;
+
+    const Data& GetData() const;
 
 private:
-    struct RouteInternalData {
-        Weight weight;
-        std::optional<EdgeId> prev_edge;
-    };
-    using RoutesInternalData = std::vector<std::vector<std::optional<RouteInternalData>>>;
-
-    void InitializeRoutesInternalData(const Graph& graph) {
-        const size_t vertex_count = graph.GetVertexCount();
-        for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
-            routes_internal_data_[vertex][vertex] = RouteInternalData{ZERO_WEIGHT, std::nullopt};
-            for (const EdgeId edge_id : graph.GetIncidentEdges(vertex)) {
-                const auto& edge = graph.GetEdge(edge_id);
-                if (edge.weight < ZERO_WEIGHT) {
-                    throw std::domain_error("Edges' weights should be non-negative");
+    void CheckEdges(const Graph& graph) const;
+
+    static constexpr Weight ZERO_WEIGHT{};
+    static constexpr TableWeight kNoRoute{std::numeric_limits<TableWeight>::infinity()};
+    static constexpr TableEdgeId kNoEdge{std::numeric_limits<TableEdgeId>::max()};
+    static constexpr size_t kBlockSize{64u};
+
+    size_t GetIndex(VertexId from, VertexId to) const {
+        return from * vertex_count_ + to;
+    }
+
+    void InitializeRoutesInternalData() {
+        for (VertexId vertex = 0; vertex < vertex_count_; ++vertex) {
+            table_.weights[GetIndex(vertex, vertex)] = TableWeight{};
+            for (size_t arc = rows_.offsets[vertex]; arc < rows_.offsets[vertex + 1]; ++arc) {
+                const size_t index = GetIndex(vertex, rows_.targets[arc]);
+                const auto weight = static_cast<TableWeight>(rows_.weights[arc]);
+                if (weight < table_.weights[index]) {
+                    table_.weights[index] = weight;
+                    table_.prev_edges[index] = static_cast<TableEdgeId>(rows_.edge_ids[arc]);
+                }
+            }
+        }
+    }
+
+    /// @brief Relaxes routes [from_begin, from_end) x [to_begin, to_end) through vertices [through_begin, through_end)
+    void RelaxBlock(VertexId from_begin, VertexId from_end, VertexId to_begin, VertexId to_end, VertexId through_begin,
+                    VertexId through_end) {
+        for (VertexId vertex_through = through_begin; vertex_through < through_end; ++vertex_through) {
+            const TableWeight* weights_through = &table_.weights[GetIndex(vertex_through, 0)];
+            const TableEdgeId* prev_edges_through = &table_.prev_edges[GetIndex(vertex_through, 0)];
+
+            for (VertexId vertex_from = from_begin; vertex_from < from_end; ++vertex_from) {
+                const TableWeight weight_from = table_.weights[GetIndex(vertex_from, vertex_through)];
+                if (weight_from == kNoRoute) {
+                    continue;
                 }
-                auto& route_internal_data = routes_internal_data_[vertex][edge.to];
-                if (!route_internal_data || route_internal_data->weight > edge.weight) {
-                    route_internal_data = RouteInternalData{edge.weight, edge_id};
+                const TableEdgeId prev_edge_from = table_.prev_edges[GetIndex(vertex_from, vertex_through)];
+
+                TableWeight* weights_relaxing = &table_.weights[GetIndex(vertex_from, 0)];
+                TableEdgeId* prev_edges_relaxing = &table_.prev_edges[GetIndex(vertex_from, 0)];
+                // Branchless selects let the compiler vectorize the loop
+                for (VertexId vertex_to = to_begin; vertex_to < to_end; ++vertex_to) {
+                    const TableWeight candidate_weight = weight_from + weights_through[vertex_to];
+                    const TableEdgeId candidate_edge =
+                        prev_edges_through[vertex_to] != kNoEdge ? prev_edges_through[vertex_to] : prev_edge_from;
+                    const bool is_shorter = candidate_weight < weights_relaxing[vertex_to];
+                    weights_relaxing[vertex_to] = is_shorter ? candidate_weight : weights_relaxing[vertex_to];
+                    prev_edges_relaxing[vertex_to] = is_shorter ? candidate_edge : prev_edges_relaxing[vertex_to];
                 }
             }
         }
     }
 
-    void RelaxRoute(VertexId vertex_from, VertexId vertex_to, const RouteInternalData& route_from,
-                    const RouteInternalData& route_to) {
-        auto& route_relaxing = routes_internal_data_[vertex_from][vertex_to];
-        const Weight candidate_weight = route_from.weight + route_to.weight;
-        if (!route_relaxing || candidate_weight < route_relaxing->weight) {
-            route_relaxing = {candidate_weight, route_to.prev_edge ? route_to.prev_edge : route_from.prev_edge};
+    void BuildRoutesWithFloydWarshall() {
+        InitializeRoutesInternalData();
+
+        const size_t blocks_count = (vertex_count_ + kBlockSize - 1) / kBlockSize;
+        const auto block_begin = [](size_t block) { return block * kBlockSize; };
+        const auto block_end = [this](size_t block) { return std::min((block + 1) * kBlockSize, vertex_count_); };
+
+        auto& pool = parallel::ThreadPool::Instance();
+        for (size_t through = 0; through < blocks_count; ++through) {
+            const VertexId through_begin = block_begin(through);
+            const VertexId through_end = block_end(through);
+
+            // Phase 1. Diagonal block depends only on itself
+            RelaxBlock(through_begin, through_end, through_begin, through_end, through_begin, through_end);
+
+            // Phase 2. Blocks in the row and in the column of the diagonal block depend on it and on themselves
+            pool.Run(blocks_count, [&](size_t block) {
+                if (block == through)
+                    return;
+                RelaxBlock(through_begin, through_end, block_begin(block), block_end(block), through_begin, through_end);
+                RelaxBlock(block_begin(block), block_end(block), through_begin, through_end, through_begin, through_end);
+            });
+
+            // Phase 3. Remaining blocks depend only on the blocks of the phase 2, so the rows of blocks are independent
+            pool.Run(blocks_count, [&](size_t from) {
+                if (from == through)
+                    return;
+                for (size_t to = 0; to < blocks_count; ++to) {
+                    if (to != through)
+                        RelaxBlock(block_begin(from), block_end(from), block_begin(to), block_end(to), through_begin,
+                                   through_end);
+                }
+            });
         }
     }
 
-    void RelaxRoutesInternalDataThroughVertex(size_t vertex_count, VertexId vertex_through) {
-        for (VertexId vertex_from = 0; vertex_from < vertex_count; ++vertex_from) {
-            if (const auto& route_from = routes_internal_data_[vertex_from][vertex_through]) {
-                for (VertexId vertex_to = 0; vertex_to < vertex_count; ++vertex_to) {
-                    if (const auto& route_to = routes_internal_data_[vertex_through][vertex_to]) {
-                        RelaxRoute(vertex_from, vertex_to, *route_from, *route_to);
-                    }
+    void BuildRoutesFromSource(VertexId source) {
+        using QueueItem = std::pair<TableWeight, VertexId>;
+
+        // Binary heap storage is reused between the sources processed by the same thread
+        static thread_local std::vector<QueueItem> queue;
+        queue.clear();
+        const auto push = [](TableWeight weight, VertexId vertex) {
+            queue.emplace_back(weight, vertex);
+            std::push_heap(queue.begin(), queue.end(), std::greater<>{});
+        };
+
+        // Row of the table is used as the distances storage: prev_edge is the last edge of the route, as in Floyd's
+        TableWeight* weights_from_source = &table_.weights[GetIndex(source, 0)];
+        TableEdgeId* prev_edges_from_source = &table_.prev_edges[GetIndex(source, 0)];
+        weights_from_source[source] = TableWeight{};
+        push(TableWeight{}, source);
+
+        while (!queue.empty()) {
+            std::pop_heap(queue.begin(), queue.end(), std::greater<>{});
+            const auto [weight, vertex] = queue.back();
+            queue.pop_back();
+
+            if (weight > weights_from_source[vertex]) {
+                continue;
+            }
+
+            for (size_t arc = rows_.offsets[vertex]; arc < rows_.offsets[vertex + 1]; ++arc) {
+                const VertexId target = rows_.targets[arc];
+                const TableWeight candidate_weight = weight + static_cast<TableWeight>(rows_.weights[arc]);
+                if (candidate_weight < weights_from_source[target]) {
+                    weights_from_source[target] = candidate_weight;
+                    prev_edges_from_source[target] = static_cast<TableEdgeId>(rows_.edge_ids[arc]);
+                    push(candidate_weight, target);
                 }
             }
         }
     }
 
-    static constexpr Weight ZERO_WEIGHT{};
+    void BuildRoutesWithParallelDijkstra() {
+        // Sources are claimed by the threads one by one, so the long searches do not block the others
+        parallel::ThreadPool::Instance().Run(vertex_count_, [this](size_t source) { BuildRoutesFromSource(source); });
+    }
+
     const Graph& graph_;
-    RoutesInternalData routes_internal_data_;
+    const CompressedSparseRows<Weight>& rows_;
+    const size_t vertex_count_{0u};
+
+    Data table_;
 };
 
-template <typename Weight>
-Router<Weight>::Router(const Graph& graph)
+template <typename Weight, typename TableWeight>
+Router<Weight, TableWeight>::Router(const Graph& graph, AllPairsAlgorithm algorithm)
     : graph_(graph),
-      routes_internal_data_(graph.GetVertexCount(),
-                            std::vector<std::optional<RouteInternalData>>(graph.GetVertexCount())) {
-    InitializeRoutesInternalData(graph);
+      rows_(graph.GetCompressedSparseRows()),
+      vertex_count_(graph.GetVertexCount()),
+      table_{std::vector<TableWeight>(vertex_count_ * vertex_count_, kNoRoute),
+             std::vector<TableEdgeId>(vertex_count_ * vertex_count_, kNoEdge)} {
+    CheckEdges(graph);
 
-    const size_t vertex_count = graph.GetVertexCount();
-    for (VertexId vertex_through = 0; vertex_through < vertex_count; ++vertex_through) {
-        RelaxRoutesInternalDataThroughVertex(vertex_count, vertex_through);
+    switch (algorithm) {
+        case AllPairsAlgorithm::FloydWarshall:
+            BuildRoutesWithFloydWarshall();
+            break;
+        case AllPairsAlgorithm::ParallelDijkstra:
+            BuildRoutesWithParallelDijkstra();
+            break;
     }
 }
 
-template <typename Weight>
-std::optional<typename Router<Weight>::RouteInfo> Router<Weight>::BuildRoute(VertexId from, VertexId to) const {
-    const auto& route_internal_data = routes_internal_data_.at(from).at(to);
-    if (!route_internal_data) {
+template <typename Weight, typename TableWeight>
+Router<Weight, TableWeight>::Router(const Graph& graph, Data data)
+    : graph_(graph),
+      rows_(graph.GetCompressedSparseRows()),
+      vertex_count_(graph.GetVertexCount()),
+      table_(std::move(data)) {
+    CheckEdges(graph);
+
+    const size_t table_size = vertex_count_ * vertex_count_;
+    if (table_.weights.size() != table_size || table_.prev_edges.size() != table_size) {
+        throw std::invalid_argument("Routes table does not correspond to the graph");
+    }
+}
+
+template <typename Weight, typename TableWeight>
+void Router<Weight, TableWeight>::CheckEdges(const Graph& graph) const {
+    if (graph.GetEdgeCount() >= kNoEdge) {
+        throw std::length_error("Too many edges for the routes table");
+    }
+    for (const auto& edge : graph.GetEdges()) {
+        if (edge.weight < ZERO_WEIGHT) {
+            throw std::domain_error("Edges' weights should be non-negative");
+        }
+    }
+}
+
+template <typename Weight, typename TableWeight>
+std::optional<typename Router<Weight, TableWeight>::RouteInfo> Router<Weight, TableWeight>::BuildRoute(
+    VertexId from, VertexId to) const {
+    if (from >= vertex_count_ || to >= vertex_count_) {
+        throw std::out_of_range("Vertex is out of graph");
+    }
+
+    const TableWeight table_weight = table_.weights[GetIndex(from, to)];
+    if (table_weight == kNoRoute) {
         return std::nullopt;
     }
-    const Weight weight = route_internal_data->weight;
+
     std::vector<EdgeId> edges;
-    for (std::optional<EdgeId> edge_id = route_internal_data->prev_edge; edge_id;
-         edge_id = routes_internal_data_[from][graph_.GetEdge(*edge_id).from]->prev_edge) {
-        edges.push_back(*edge_id);
+    const TableEdgeId* prev_edges_from = &table_.prev_edges[GetIndex(from, 0)];
+    for (TableEdgeId edge_id = prev_edges_from[to]; edge_id != kNoEdge;
+         edge_id = prev_edges_from[graph_.GetEdge(edge_id).from]) {
+        edges.push_back(edge_id);
     }
     std::reverse(edges.begin(), edges.end());
 
-    return RouteInfo{weight, std::move(edges)};
+    if constexpr (std::is_same_v<Weight, TableWeight>) {
+        return RouteInfo{table_weight, std::move(edges)};
+    } else {
+        Weight weight = ZERO_WEIGHT;
+        for (EdgeId edge_id : edges) {
+            weight += graph_.GetEdge(edge_id).weight;
+        }
+        return RouteInfo{weight, std::move(edges)};
+    }
+}
+
+template <typename Weight, typename TableWeight>
+std::vector<std::optional<typename Router<Weight, TableWeight>::RouteInfo>> Router<Weight, TableWeight>::BuildRoutes(
+    VertexId from, const std::vector<VertexId>& to) const {
+    std::vector<std::optional<RouteInfo>> routes;
+    routes.reserve(to.size());
+    for (VertexId vertex_to : to) {
+        routes.push_back(BuildRoute(from, vertex_to));
+    }
+    return routes;
+}
+
+template <typename Weight, typename TableWeight>
+const typename Router<Weight, TableWeight>::Data& Router<Weight, TableWeight>::GetData() const {
+    return table_;
 }
 
-}  // namespace graph
\ No newline at end of file
+}  // namespace graph
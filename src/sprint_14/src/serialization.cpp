@@ -4,34 +4,126 @@
 #include <transport_catalogue.pb.h>
 #include <transport_router.pb.h>
 
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <google/protobuf/util/delimited_message_util.h>
+
+#include <algorithm>
 #include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
 
 namespace serialization {
 
-using StopNameToIdContaner = std::unordered_map<std::string_view, int>;
-using IdToStopNameContainer = std::unordered_map<int, std::string>;
-
 namespace {
-StopNameToIdContaner SetIdToEachStop(const std::deque<catalogue::Stop>& stops) {
-    // !!! IMPORTANT !!! Store IDs in the direct order for SERIALIZATION
-    StopNameToIdContaner result;
-    result.reserve(stops.size());
+/// @brief Version of the precomputed router data format: increase it on the changes of the routers, so the data stored
+/// by the previous versions is recomputed instead of the usage
+constexpr uint32_t kRouterDataVersion{2u};
+
+/// @brief Entries of the routes table in one message (about 50 MB), so the table of any size is far from the 2 GB limit
+/// of the protobuf message
+constexpr size_t kRoutesTableBlockSize{1u << 22};
+
+/// @brief Messages of the base file in the order of writing. Each message is prefixed with its size, so the readers
+/// parse only their own message and do not merge the fields of the other ones. Routes table of the all-pairs router is
+/// written after the router by the blocks of the whole rows
+enum class Section { TransportCatalogue = 0, Visualization = 1, TransportRouter = 2, RoutesTable = 3 };
+
+void WriteSection(std::ofstream& output, const google::protobuf::MessageLite& object) {
+    if (!google::protobuf::util::SerializeDelimitedToOstream(object, &output))
+        throw std::runtime_error("Failed to write the base file");
+}
+
+/// @brief Reads the sections one by one starting from the given one
+/// @details Each section is read by its own coded stream, because the stream limits the total count of the read bytes
+/// by 2 GB, while the base with the routes table is larger
+class SectionReader {
+public:
+    SectionReader(const catalogue::Path& path, Section section) : input_(path, std::ios::binary), stream_(&input_) {
+        for (int index = 0; index < static_cast<int>(section); ++index) {
+            google::protobuf::io::CodedInputStream coded_stream(&stream_);
+            if (!coded_stream.Skip(ReadSize(coded_stream)))
+                throw std::runtime_error("Broken base file");
+        }
+    }
+
+    void Read(google::protobuf::MessageLite& object) {
+        google::protobuf::io::CodedInputStream coded_stream(&stream_);
+
+        const auto limit = coded_stream.PushLimit(ReadSize(coded_stream));
+        if (!object.ParseFromCodedStream(&coded_stream) || !coded_stream.ConsumedEntireMessage())
+            throw std::runtime_error("Broken base file");
+        coded_stream.PopLimit(limit);
+    }
+
+private:
+    static int ReadSize(google::protobuf::io::CodedInputStream& coded_stream) {
+        uint32_t size{0u};
+        if (!coded_stream.ReadVarint32(&size) || size > static_cast<uint32_t>(std::numeric_limits<int>::max()))
+            throw std::runtime_error("Broken base file");
+        return static_cast<int>(size);
+    }
 
-    for (int id = 0; id < stops.size(); ++id)
-        result.emplace(stops[id].name, id);
+private:
+    std::ifstream input_;
+    google::protobuf::io::IstreamInputStream stream_;
+};
 
-    return result;
+void ReadSection(const catalogue::Path& path, Section section, google::protobuf::MessageLite& object) {
+    SectionReader(path, section).Read(object);
 }
 
-IdToStopNameContainer SetNameToEachStop(const std::deque<catalogue::Stop>& stops) {
-    // !!! IMPORTANT !!! Store IDs in the reverse order for DESERIALIZATION
-    IdToStopNameContainer result;
-    result.reserve(stops.size());
+/// @brief Entries of the routes table in one section: the whole rows, at least one
+size_t GetRoutesTableBlockSize(size_t vertex_count) {
+    return std::max<size_t>(kRoutesTableBlockSize / vertex_count, 1u) * vertex_count;
+}
+
+size_t GetRoutesTableBlocksCount(size_t vertex_count) {
+    if (vertex_count == 0)
+        return 0u;
+    const size_t block_size = GetRoutesTableBlockSize(vertex_count);
+    return (vertex_count * vertex_count + block_size - 1) / block_size;
+}
 
-    for (int id = 0; id < stops.size(); ++id)
-        result.emplace(id, stops[stops.size() - id - 1].name);
+template <typename Table>
+void SerializeRoutesTable(std::ofstream& output, const Table& table, size_t vertex_count) {
+    const size_t table_size = table.weights.size();
+    const size_t block_size = GetRoutesTableBlockSize(vertex_count);
 
-    return result;
+    for (size_t begin = 0; begin < table_size; begin += block_size) {
+        const auto end = static_cast<std::ptrdiff_t>(std::min(begin + block_size, table_size));
+        const auto offset = static_cast<std::ptrdiff_t>(begin);
+        proto_router::RoutesTable object;
+
+        if constexpr (std::is_same_v<typename decltype(table.weights)::value_type, float>)
+            object.mutable_float_weights()->Add(table.weights.begin() + offset, table.weights.begin() + end);
+        else
+            object.mutable_weights()->Add(table.weights.begin() + offset, table.weights.begin() + end);
+        object.mutable_prev_edges()->Add(table.prev_edges.begin() + offset, table.prev_edges.begin() + end);
+
+        WriteSection(output, object);
+    }
+}
+
+template <typename Table>
+Table DeserializeRoutesTable(const catalogue::Path& path, size_t blocks_count, size_t vertex_count) {
+    Table table;
+    table.weights.reserve(vertex_count * vertex_count);
+    table.prev_edges.reserve(vertex_count * vertex_count);
+
+    SectionReader reader(path, Section::RoutesTable);
+    for (size_t block = 0; block < blocks_count; ++block) {
+        proto_router::RoutesTable object;
+        reader.Read(object);
+
+        if constexpr (std::is_same_v<typename decltype(table.weights)::value_type, float>)
+            table.weights.insert(table.weights.end(), object.float_weights().begin(), object.float_weights().end());
+        else
+            table.weights.insert(table.weights.end(), object.weights().begin(), object.weights().end());
+        table.prev_edges.insert(table.prev_edges.end(), object.prev_edges().begin(), object.prev_edges().end());
+    }
+    return table;
 }
 
 }  // namespace
@@ -39,54 +131,56 @@ IdToStopNameContainer SetNameToEachStop(const std::deque<catalogue::Stop>& stops
 void SerializeTransportCatalogue(std::ofstream& output, const catalogue::TransportCatalogue& catalogue) {
     proto_tc::TransportCatalogue object;
 
-    const auto& stops = catalogue.GetStops();
-    const auto stop_to_id = SetIdToEachStop(stops);
+    // Stops and buses are written in the order of their ids, so the ids of the catalogue are used in the file as is
 
     // Step 1. Serialize stops
-    for (const auto& stop : stops) {
+    for (catalogue::StopId stop = 0; stop < catalogue.GetStopsCount(); ++stop) {
         proto_tc::Stop stop_object;
 
-        stop_object.set_name(stop.name);
-        stop_object.mutable_point()->set_lng(stop.point.lng);
-        stop_object.mutable_point()->set_lat(stop.point.lat);
+        const auto point = catalogue.GetStopPoint(stop);
+        stop_object.set_name(std::string(catalogue.GetStopName(stop)));
+        stop_object.mutable_point()->set_lng(point.lng);
+        stop_object.mutable_point()->set_lat(point.lat);
 
         object.mutable_stops()->Add(std::move(stop_object));
     }
 
-    // Step 2. Serialize distances between stops
-    const auto& distances = catalogue.GetDistancesBetweenStops();
-    for (const auto& [stops_pair, distance] : distances) {
-        proto_tc::DistanceBetweenStops distance_object;
+    // Step 2. Serialize distances between stops (only the explicit ones: the reverse ones are restored on adding)
+    catalogue.GetDistancesBetweenStops().ForEachExplicit(
+        [&object](catalogue::StopId from, catalogue::StopId to, int distance) {
+            proto_tc::DistanceBetweenStops distance_object;
 
-        distance_object.set_from(stop_to_id.at(stops_pair.first->name));
-        distance_object.set_to(stop_to_id.at(stops_pair.second->name));
-        distance_object.set_distance(distance);
+            distance_object.set_from(from);
+            distance_object.set_to(to);
+            distance_object.set_distance(distance);
 
-        object.mutable_distances()->Add(std::move(distance_object));
-    }
+            object.mutable_distances()->Add(std::move(distance_object));
+        });
 
     // Step 3. Serialize buses
-    const auto& buses = catalogue.GetBuses();
-    for (const auto& bus : buses) {
+    for (catalogue::BusId bus = 0; bus < catalogue.GetBusesCount(); ++bus) {
         proto_tc::Bus bus_object;
 
-        bus_object.set_name(bus.number);
-        bus_object.set_is_circle(bus.type == catalogue::RouteType::CIRCLE);
-        for (std::string_view stop : bus.stop_names)
-            bus_object.add_stops_ids(stop_to_id.at(stop));
+        bus_object.set_name(std::string(catalogue.GetBusNumber(bus)));
+        bus_object.set_is_circle(catalogue.GetBusType(bus) == catalogue::RouteType::CIRCLE);
+        for (catalogue::StopId stop : catalogue.GetBusStops(bus))
+            bus_object.add_stops_ids(stop);
+
+        const auto statistics = catalogue.GetBusStatistics(catalogue.GetBusNumber(bus));
+        bus_object.mutable_statistics()->set_route_length(statistics->rout_length);
+        bus_object.mutable_statistics()->set_curvature(statistics->curvature);
 
         object.mutable_buses()->Add(std::move(bus_object));
     }
 
-    object.SerializeToOstream(&output);
+    WriteSection(output, object);
 }
 
 catalogue::TransportCatalogue DeserializeTransportCatalogue(const catalogue::Path& path) {
     proto_tc::TransportCatalogue object;
     catalogue::TransportCatalogue catalogue;
 
-    std::ifstream input(path, std::ios::binary);
-    object.ParseFromIstream(&input);
+    ReadSection(path, Section::TransportCatalogue, object);
 
     auto to_int = [](uint32_t value) { return static_cast<int>(value); };
 
@@ -94,10 +188,6 @@ catalogue::TransportCatalogue DeserializeTransportCatalogue(const catalogue::Pat
     for (const auto& stop_object : object.stops()) {
         catalogue::Stop stop;
 
-        // TODO: find out why protobuf reads more stops than it really is
-        if (stop_object.name().empty())
-            continue;
-
         stop.name = stop_object.name();
         stop.point.lng = stop_object.point().lng();
         stop.point.lat = stop_object.point().lat();
@@ -105,12 +195,10 @@ catalogue::TransportCatalogue DeserializeTransportCatalogue(const catalogue::Pat
         catalogue.AddStop(std::move(stop));
     }
 
-    const auto id_to_stop = SetNameToEachStop(catalogue.GetStops());
-
     // Step 2. Parse all distances between stops
     for (const auto& distance_object : object.distances()) {
-        std::string_view from = id_to_stop.at(to_int(distance_object.from()));
-        std::string_view to = id_to_stop.at(to_int(distance_object.to()));
+        std::string_view from = catalogue.GetStopName(distance_object.from());
+        std::string_view to = catalogue.GetStopName(distance_object.to());
 
         catalogue.AddDistance(from, to, to_int(distance_object.distance()));
     }
@@ -120,21 +208,26 @@ catalogue::TransportCatalogue DeserializeTransportCatalogue(const catalogue::Pat
     for (const auto& bus_object : object.buses()) {
         catalogue::Bus bus;
 
-        // TODO: find out why protobuf reads more stops than it really is
-        if (bus_object.name().empty())
-            continue;
-
         bus.number = bus_object.name();
 
         bus.type = bus_object.is_circle() ? Route::CIRCLE : Route::TWO_DIRECTIONAL;
 
         bus.stop_names.reserve(bus_object.stops_ids_size());
         for (uint32_t stop_id : bus_object.stops_ids())
-            bus.stop_names.emplace_back(id_to_stop.at(to_int(stop_id)));
+            bus.stop_names.emplace_back(catalogue.GetStopName(stop_id));
 
         catalogue.AddBus(std::move(bus));
+
+        if (bus_object.has_statistics()) {
+            const auto& statistics = bus_object.statistics();
+            catalogue.SetBusStatistics(catalogue.GetBusId(bus_object.name()),
+                                       static_cast<int>(statistics.route_length()), statistics.curvature());
+        }
     }
 
+    // Step 4. Compute statistics of the buses, which are not stored in the base
+    catalogue.ComputeBusStatistics();
+
     return catalogue;
 }
 
@@ -195,7 +288,7 @@ void SerializeVisualizationSettings(std::ofstream& output, const render::Visuali
     for (const auto& color : settings.GetColors())
         object.mutable_color_palette()->Add(set_color(color));
 
-    object.SerializeToOstream(&output);
+    WriteSection(output, object);
 }
 
 render::Visualization DeserializeVisualizationSettings(const catalogue::Path& path) {
@@ -224,8 +317,7 @@ render::Visualization DeserializeVisualizationSettings(const catalogue::Path& pa
     };
 
     proto_render::MapRenderer object;
-    std::ifstream input(path, std::ios::binary);
-    object.ParseFromIstream(&input);
+    ReadSection(path, Section::Visualization, object);
 
     render::Visualization settings;
 
@@ -263,15 +355,6 @@ render::Visualization DeserializeVisualizationSettings(const catalogue::Path& pa
     return settings;
 }
 
-void SerializeRoutingSettings(std::ofstream& output, const routing::Settings& settings) {
-    proto_router::Settings object;
-
-    object.set_bus_velocity(settings.bus_velocity_);
-    object.set_bus_wait_time(settings.bus_wait_time_);
-
-    object.SerializeToOstream(&output);
-}
-
 void SerializeTransportRouter(std::ofstream& output, const routing::TransportRouter& router) {
     proto_router::TransportRouter object;
 
@@ -279,13 +362,18 @@ void SerializeTransportRouter(std::ofstream& output, const routing::TransportRou
     const auto& settings = router.GetSettings();
     object.mutable_settings()->set_bus_velocity(settings.bus_velocity_);
     object.mutable_settings()->set_bus_wait_time(settings.bus_wait_time_);
+    object.mutable_settings()->set_router_type(static_cast<proto_router::Settings::RouterType>(settings.router_type_));
+    object.mutable_settings()->set_router_cache_size(settings.router_cache_size_);
+    object.mutable_settings()->set_router_float_weights(settings.router_float_weights_);
 
-    // Step 1. Serialize graph & edge -> response at the same time because they use edges
+    // Step 2. Serialize graph & edge -> response at the same time because they use edges
     const auto& graph = router.GetGraph();
     object.mutable_routes()->set_vertices_count(graph.GetVertexCount());
 
-    for (int id = 0; id < graph.GetEdgeCount(); ++id) {
-        // Step 1.1 Add edge to graph
+    const auto& catalogue = router.GetTransportCatalogue();
+
+    for (graph::EdgeId id = 0; id < graph.GetEdgeCount(); ++id) {
+        // Step 2.1 Add edge to graph
         proto_router::Edge edge_object;
         const auto& edge = graph.GetEdge(id);
 
@@ -295,88 +383,140 @@ void SerializeTransportRouter(std::ofstream& output, const routing::TransportRou
 
         object.mutable_routes()->mutable_edges()->insert({static_cast<uint32_t>(id), edge_object});
 
-        // Step 1.2 Add corresponding to the edge response
+        // Step 2.2 Add corresponding to the edge response: names are stored as the ids of the stops and buses
         proto_router::Response response_object;
-        const auto& response = router.GetResponse(edge);
-        if (std::holds_alternative<routing::WaitResponse>(response)) {
-            const auto& tmp = std::get<routing::WaitResponse>(response);
+        const auto& response = router.GetResponse(id);
+        response_object.set_time(response.time);
+        if (response.type == routing::ResponseType::Wait) {
             response_object.set_type(proto_router::Response::ResponseType::Response_ResponseType_Wait);
-            response_object.set_time(tmp.time);
-            response_object.set_name(tmp.stop_name);
+            response_object.set_name_id(catalogue.GetStopId(response.name));
         } else {
-            const auto& tmp = std::get<routing::BusResponse>(response);
             response_object.set_type(proto_router::Response::ResponseType::Response_ResponseType_Bus);
-            response_object.set_time(tmp.time);
-            response_object.set_name(tmp.bus);
-            response_object.set_span_count(tmp.span_count);
+            response_object.set_name_id(catalogue.GetBusId(response.name));
+            response_object.set_span_count(response.span_count);
         }
 
         object.mutable_edge_id_to_response()->insert({static_cast<uint32_t>(id), response_object});
     }
 
     // Step 3. Serialize stop to vertex info
-    const auto& stops = router.GetTransportCatalogue().GetStops();
-    const auto stop_to_id = SetIdToEachStop(stops);
-
-    for (const auto& stop : stops) {
-        const auto& vertex = router.GetStopVertices(stop.name);
+    for (catalogue::StopId stop = 0; stop < catalogue.GetStopsCount(); ++stop) {
+        const auto& vertex = router.GetStopVertices(catalogue.GetStopName(stop));
 
         proto_router::StopVertices stop_object;
         stop_object.set_start(vertex.start);
         stop_object.set_end(vertex.end);
 
-        object.mutable_stop_to_vertex()->insert({static_cast<uint32_t>(stop_to_id.at(stop.name)), stop_object});
+        object.mutable_stop_to_vertex()->insert({stop, stop_object});
     }
 
-    object.SerializeToOstream(&output);
+    // Step 4. Serialize precomputed router data (if the router has it), so it is not computed on the requests
+    object.set_router_data_version(kRouterDataVersion);
+    object.set_graph_fingerprint(graph.GetFingerprint());
+
+    using routing::TransportRouter;
+    if (const auto* hierarchy = router.GetRouter<TransportRouter::ContractionHierarchy>()) {
+        const auto& data = hierarchy->GetData();
+        auto& hierarchy_object = *object.mutable_contraction_hierarchy();
+
+        hierarchy_object.mutable_ranks()->Reserve(static_cast<int>(data.ranks.size()));
+        for (size_t rank : data.ranks)
+            hierarchy_object.add_ranks(rank);
+
+        hierarchy_object.mutable_shortcuts()->Reserve(static_cast<int>(data.shortcuts.size()));
+        for (const auto& shortcut : data.shortcuts) {
+            auto& shortcut_object = *hierarchy_object.add_shortcuts();
+            shortcut_object.set_from(shortcut.from);
+            shortcut_object.set_to(shortcut.to);
+            shortcut_object.set_weight(shortcut.weight);
+            shortcut_object.set_first(shortcut.first);
+            shortcut_object.set_second(shortcut.second);
+        }
+    }
+
+    // Step 5. Serialize routes table of the all-pairs router in the sections after the router
+    const auto* all_pairs = router.GetRouter<TransportRouter::Router>();
+    const auto* compact = router.GetRouter<TransportRouter::CompactRouter>();
+    if (all_pairs || compact)
+        object.set_routes_table_blocks(GetRoutesTableBlocksCount(graph.GetVertexCount()));
+
+    WriteSection(output, object);
+
+    if (all_pairs)
+        SerializeRoutesTable(output, all_pairs->GetData(), graph.GetVertexCount());
+    else if (compact)
+        SerializeRoutesTable(output, compact->GetData(), graph.GetVertexCount());
 }
 
 routing::TransportRouter DeserializeTransportRouter(const catalogue::Path& path,
                                                     const catalogue::TransportCatalogue& catalogue) {
     using namespace routing;
-    std::ifstream input(path, std::ios::binary);
     proto_router::TransportRouter object;
-    object.ParseFromIstream(&input);
+    ReadSection(path, Section::TransportRouter, object);
 
     // Step 1. Parse settings
     Settings settings;
     settings.bus_wait_time_ = static_cast<int>(object.settings().bus_wait_time());
-    settings.bus_velocity_ = static_cast<int>(object.settings().bus_velocity());
+    settings.bus_velocity_ = object.settings().bus_velocity();
+    settings.router_type_ = static_cast<RouterType>(object.settings().router_type());
+    settings.router_cache_size_ = static_cast<size_t>(object.settings().router_cache_size());
+    settings.router_float_weights_ = object.settings().router_float_weights();
 
     // Step 2. Parse graph
     TransportRouter::Graph graph(object.routes().vertices_count());
 
+    // Names of the responses are restored as the views of the catalogue strings
     TransportRouter::EdgeToResponseStorage edge_to_response;
     edge_to_response.reserve(object.edge_id_to_response_size());
 
     for (int edge_id = 0; edge_id != object.edge_id_to_response_size(); ++edge_id) {
         auto& edge_object = object.routes().edges().at(edge_id);
         // Step 2.1 Add edge to the graph
-        graph::Edge<double> edge{edge_object.from(), edge_object.to(), edge_object.weight()};
-        graph.AddEdge(edge);
+        graph.AddEdge({edge_object.from(), edge_object.to(), edge_object.weight()});
 
         // Step 2.2 Add edge to response correspondence
-        proto_router::Response response = object.edge_id_to_response().at(edge_id);
-        if (response.type() == proto_router::Response_ResponseType_Wait) {
-            WaitResponse tmp(response.time(), response.name());
-            edge_to_response.insert({edge, std::move(tmp)});
-        } else {
-            BusResponse tmp(response.time(), response.name(), static_cast<int>(response.span_count()));
-            edge_to_response.insert({edge, std::move(tmp)});
-        }
+        const auto& response = object.edge_id_to_response().at(edge_id);
+        const uint32_t name_id = response.name_id();
+        if (response.type() == proto_router::Response_ResponseType_Wait)
+            edge_to_response.push_back({ResponseType::Wait, response.time(), catalogue.GetStopName(name_id)});
+        else
+            edge_to_response.push_back({ResponseType::Bus, response.time(), catalogue.GetBusNumber(name_id),
+                                        static_cast<int>(response.span_count())});
     }
 
     // Step 3. Add stops to vertex correspondence
-    const auto& stops = catalogue.GetStops();
-    const auto id_to_stop = SetNameToEachStop(stops);
-
     TransportRouter::StopToVertexStorage stop_to_vertex;
     stop_to_vertex.reserve(object.stop_to_vertex_size());
 
     for (const auto& [id, vertex] : object.stop_to_vertex())
-        stop_to_vertex.insert({id_to_stop.at(static_cast<int>(id)), {vertex.start(), vertex.end()}});
+        stop_to_vertex.insert({catalogue.GetStopName(id), {vertex.start(), vertex.end()}});
+
+    // Step 4. Restore precomputed router data (it is recomputed, if it has been stored for the other graph)
+    TransportRouter::RouterData router_data;
+    const bool is_data_valid = object.router_data_version() == kRouterDataVersion &&
+                               object.graph_fingerprint() == graph.GetFingerprint();
+
+    if (is_data_valid && object.has_contraction_hierarchy()) {
+        const auto& hierarchy_object = object.contraction_hierarchy();
+        auto& hierarchy = router_data.emplace<TransportRouter::ContractionHierarchy::Data>();
+
+        hierarchy.ranks.assign(hierarchy_object.ranks().begin(), hierarchy_object.ranks().end());
+        hierarchy.shortcuts.reserve(hierarchy_object.shortcuts_size());
+        for (const auto& shortcut : hierarchy_object.shortcuts())
+            hierarchy.shortcuts.push_back(
+                {shortcut.from(), shortcut.to(), shortcut.weight(), shortcut.first(), shortcut.second()});
+    } else if (is_data_valid && object.routes_table_blocks() > 0) {
+        const size_t blocks_count = object.routes_table_blocks();
+        const size_t vertex_count = graph.GetVertexCount();
+        if (settings.router_float_weights_)
+            router_data =
+                DeserializeRoutesTable<TransportRouter::CompactRouter::Data>(path, blocks_count, vertex_count);
+        else
+            router_data = DeserializeRoutesTable<TransportRouter::Router::Data>(path, blocks_count, vertex_count);
+    }
 
-    return TransportRouter{catalogue, graph, stop_to_vertex, edge_to_response, settings};
+    return TransportRouter{catalogue, std::move(graph), std::move(stop_to_vertex), std::move(edge_to_response),
+                           settings, std::move(router_data)};
 }
 
 }  // namespace serialization
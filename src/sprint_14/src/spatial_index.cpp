@@ -0,0 +1,183 @@
+#include "spatial_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace geo {
+
+namespace {
+constexpr double kPointsPerCell{2.};
+}  // namespace
+
+GridIndex::GridIndex(const std::vector<Coordinates>& points) : points_(points) {
+    if (points_.empty())
+        return;
+
+    Coordinates max = points_.front();
+    min_ = points_.front();
+    for (const auto& point : points_) {
+        terms_.Add(point);
+
+        min_.lat = std::min(min_.lat, point.lat);
+        min_.lng = std::min(min_.lng, point.lng);
+        max.lat = std::max(max.lat, point.lat);
+        max.lng = std::max(max.lng, point.lng);
+    }
+    min_cos_lat_ = std::min(std::cos(min_.lat * kDegreesToRadians), std::cos(max.lat * kDegreesToRadians));
+
+    // Cells are close to the squares on the surface: the width in degrees is scaled by the cosine of the latitude
+    const double height = max.lat - min_.lat;
+    const double width = (max.lng - min_.lng) * std::cos((min_.lat + max.lat) / 2. * kDegreesToRadians);
+    const double cells_count = std::max(1., static_cast<double>(points_.size()) / kPointsPerCell);
+
+    if (height <= 0. && width <= 0.) {
+        rows_ = columns_ = 1;
+    } else if (height <= 0.) {
+        rows_ = 1;
+        columns_ = static_cast<int>(cells_count);
+    } else if (width <= 0.) {
+        rows_ = static_cast<int>(cells_count);
+        columns_ = 1;
+    } else {
+        columns_ = std::max(1, static_cast<int>(std::lround(std::sqrt(cells_count * width / height))));
+        rows_ = std::max(1, static_cast<int>(cells_count / columns_));
+    }
+    cell_height_ = height > 0. ? height / rows_ : 1.;
+    cell_width_ = max.lng > min_.lng ? (max.lng - min_.lng) / columns_ : 1.;
+
+    // Counting sort of the points by the cells
+    std::vector<size_t> point_cells(points_.size());
+    cell_offsets_.assign(static_cast<size_t>(rows_) * columns_ + 1, 0u);
+    for (size_t id = 0; id < points_.size(); ++id) {
+        point_cells[id] = GetCell(GetColumn(points_[id].lng), GetRow(points_[id].lat));
+        ++cell_offsets_[point_cells[id] + 1];
+    }
+    for (size_t cell = 1; cell < cell_offsets_.size(); ++cell)
+        cell_offsets_[cell] += cell_offsets_[cell - 1];
+
+    cell_points_.resize(points_.size());
+    std::vector<size_t> next_positions(cell_offsets_.begin(), cell_offsets_.end() - 1);
+    for (size_t id = 0; id < points_.size(); ++id)
+        cell_points_[next_positions[point_cells[id]]++] = static_cast<uint32_t>(id);
+}
+
+std::vector<uint32_t> GridIndex::FindInBox(Coordinates min, Coordinates max) const {
+    std::vector<uint32_t> result;
+    if (points_.empty() || min.lat > max.lat || min.lng > max.lng)
+        return result;
+
+    for (int row = GetRow(min.lat); row <= GetRow(max.lat); ++row) {
+        for (int column = GetColumn(min.lng); column <= GetColumn(max.lng); ++column) {
+            const size_t cell = GetCell(column, row);
+            for (size_t index = cell_offsets_[cell]; index < cell_offsets_[cell + 1]; ++index) {
+                const auto& point = points_[cell_points_[index]];
+                if (min.lat <= point.lat && point.lat <= max.lat && min.lng <= point.lng && point.lng <= max.lng)
+                    result.push_back(cell_points_[index]);
+            }
+        }
+    }
+    std::sort(result.begin(), result.end());
+
+    return result;
+}
+
+std::vector<GridIndex::Neighbour> GridIndex::FindNearest(Coordinates point, size_t count) const {
+    std::vector<Neighbour> candidates;
+    if (points_.empty() || count == 0)
+        return candidates;
+
+    const auto is_closer = [](const Neighbour& lhs, const Neighbour& rhs) {
+        return lhs.distance < rhs.distance || (lhs.distance == rhs.distance && lhs.id < rhs.id);
+    };
+
+    const int center_column = GetColumn(point.lng);
+    const int center_row = GetRow(point.lat);
+
+    std::vector<uint32_t> ids;
+    std::vector<double> distances;
+
+    for (int radius = 0;; ++radius) {
+        const CellsRange range{std::max(center_column - radius, 0), std::min(center_column + radius, columns_ - 1),
+                               std::max(center_row - radius, 0), std::min(center_row + radius, rows_ - 1)};
+
+        // Step 1. Collect the points of the ring: cells on the distance 'radius' from the center one
+        ids.clear();
+        for (int row = range.row_begin; row <= range.row_end; ++row) {
+            const bool is_border_row = std::abs(row - center_row) == radius;
+            for (int column = range.column_begin; column <= range.column_end; ++column) {
+                if (!is_border_row && std::abs(column - center_column) != radius)
+                    continue;
+
+                const size_t cell = GetCell(column, row);
+                ids.insert(ids.end(), cell_points_.begin() + static_cast<std::ptrdiff_t>(cell_offsets_[cell]),
+                           cell_points_.begin() + static_cast<std::ptrdiff_t>(cell_offsets_[cell + 1]));
+            }
+        }
+
+        distances.resize(ids.size());
+        ComputeDistances(terms_, point, ids.data(), ids.size(), distances.data());
+        for (size_t index = 0; index < ids.size(); ++index)
+            candidates.push_back({ids[index], distances[index]});
+
+        // Step 2. Stop, when the whole grid is scanned or the not scanned cells could not contain closer points
+        const bool is_grid_scanned = range.column_begin == 0 && range.row_begin == 0 &&
+                                     range.column_end == columns_ - 1 && range.row_end == rows_ - 1;
+        if (is_grid_scanned)
+            break;
+
+        if (candidates.size() >= count) {
+            std::nth_element(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(count - 1),
+                             candidates.end(), is_closer);
+            if (candidates[count - 1].distance <= GetDistanceLowerBound(point, range))
+                break;
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), is_closer);
+    candidates.resize(std::min(count, candidates.size()));
+
+    return candidates;
+}
+
+int GridIndex::GetColumn(double lng) const {
+    // Clamping is done before the cast, so the points far from the grid do not overflow int
+    return static_cast<int>(std::clamp(std::floor((lng - min_.lng) / cell_width_), 0., columns_ - 1.));
+}
+
+int GridIndex::GetRow(double lat) const {
+    return static_cast<int>(std::clamp(std::floor((lat - min_.lat) / cell_height_), 0., rows_ - 1.));
+}
+
+size_t GridIndex::GetCell(int column, int row) const {
+    return static_cast<size_t>(row) * columns_ + column;
+}
+
+double GridIndex::GetDistanceLowerBound(Coordinates point, const CellsRange& range) const {
+    double bound = std::numeric_limits<double>::infinity();
+
+    // Along the meridian: the distance is not less than the difference of the latitudes
+    const auto update_by_latitude = [&bound](double difference) {
+        bound = std::min(bound, std::max(difference, 0.) * kDegreesToRadians * kEarthRadius);
+    };
+    // Along the parallel: haversine of the distance is not less than cos(lat1) * cos(lat2) * haversine(dlng)
+    const double min_cos = std::min(min_cos_lat_, std::cos(point.lat * kDegreesToRadians));
+    const auto update_by_longitude = [&bound, min_cos](double difference) {
+        const double half_angle = std::min(std::max(difference, 0.), 180.) * kDegreesToRadians / 2.;
+        bound = std::min(bound, 2. * kEarthRadius * std::asin(std::min(min_cos * std::sin(half_angle), 1.)));
+    };
+
+    // Only the sides of the range, which do not reach the border of the grid, have the not scanned cells behind them
+    if (range.row_begin > 0)
+        update_by_latitude(point.lat - (min_.lat + range.row_begin * cell_height_));
+    if (range.row_end < rows_ - 1)
+        update_by_latitude(min_.lat + (range.row_end + 1) * cell_height_ - point.lat);
+    if (range.column_begin > 0)
+        update_by_longitude(point.lng - (min_.lng + range.column_begin * cell_width_));
+    if (range.column_end < columns_ - 1)
+        update_by_longitude(min_.lng + (range.column_end + 1) * cell_width_ - point.lng);
+
+    return bound;
+}
+
+}  // namespace geo
@@ -0,0 +1,71 @@
+#pragma once
+
+/*
+ * Description: static spatial index of the points on the earth's surface. Bounding box of the points is split into the
+ * uniform grid of cells with about two points per cell, points of each cell are stored contiguously (CSR layout).
+ *
+ * Box query scans only the cells, which intersect the box. Nearest points query scans the rings of cells around the
+ * cell of the query point: the search stops, when there are 'k' candidates and the k-th distance is not greater than
+ * the lower bound of the distance to any not scanned cell.
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "geo.h"
+
+namespace geo {
+
+class GridIndex {
+public:  // Types
+    struct Neighbour {
+        uint32_t id{0u};
+        double distance{0.};
+    };
+
+public:  // Constructors
+    GridIndex() = default;
+    /// @brief Builds the index of the points: id of the point is its index in 'points'
+    explicit GridIndex(const std::vector<Coordinates>& points);
+
+public:  // Methods
+    /// @brief Ids of the points inside the box (borders are included) in the ascending order
+    [[nodiscard]] std::vector<uint32_t> FindInBox(Coordinates min, Coordinates max) const;
+    /// @brief Up to 'count' nearest points ordered by the distance (points with the equal distances - by the ids)
+    [[nodiscard]] std::vector<Neighbour> FindNearest(Coordinates point, size_t count) const;
+
+private:  // Types
+    /// @brief Cells [column_begin, column_end] x [row_begin, row_end]
+    struct CellsRange {
+        int column_begin{0};
+        int column_end{0};
+        int row_begin{0};
+        int row_end{0};
+    };
+
+private:  // Methods
+    [[nodiscard]] int GetColumn(double lng) const;
+    [[nodiscard]] int GetRow(double lat) const;
+    [[nodiscard]] size_t GetCell(int column, int row) const;
+
+    /// @brief Lower bound of the distance from 'point' to any point outside the 'range' of cells
+    [[nodiscard]] double GetDistanceLowerBound(Coordinates point, const CellsRange& range) const;
+
+private:  // Fields
+    std::vector<Coordinates> points_;
+    PointsTerms terms_;
+
+    Coordinates min_;
+    double cell_height_{1.};
+    double cell_width_{1.};
+    int rows_{0};
+    int columns_{0};
+    // Minimum of the cosine of the points latitudes (for the lower bound of the distance along the parallel)
+    double min_cos_lat_{1.};
+
+    // Points of the cell C are [cell_offsets_[C], cell_offsets_[C + 1]) of cell_points_
+    std::vector<size_t> cell_offsets_;
+    std::vector<uint32_t> cell_points_;
+};
+
+}  // namespace geo
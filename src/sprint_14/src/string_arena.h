@@ -0,0 +1,66 @@
+#pragma once
+
+/*
+ * Description: storage of the strings with the stable addresses. Strings are copied one after another into the big
+ * blocks, so there is one allocation per block instead of one per string, and the neighbour strings are close in
+ * memory. Returned views stay valid until the arena is destroyed (also after the move of the arena).
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace memory {
+
+class StringArena {
+public:  // Constructors
+    StringArena() = default;
+
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+    StringArena(StringArena&&) noexcept = default;
+    StringArena& operator=(StringArena&&) noexcept = default;
+
+public:  // Methods
+    /// @brief Copies the string into the arena and returns the view of the copy
+    std::string_view Store(std::string_view value) {
+        if (value.size() > block_capacity_ - block_size_) {
+            // Long strings get the block of their own size, so the space of the current block is not wasted
+            if (value.size() > kBlockCapacity / 4)
+                return Copy(value, AllocateBlock(value.size()));
+
+            block_capacity_ = kBlockCapacity;
+            block_size_ = 0u;
+            current_block_ = AllocateBlock(kBlockCapacity);
+        }
+
+        std::string_view result = Copy(value, current_block_ + block_size_);
+        block_size_ += value.size();
+        return result;
+    }
+
+private:  // Methods
+    char* AllocateBlock(size_t size) {
+        blocks_.push_back(std::make_unique<char[]>(std::max<size_t>(size, 1u)));
+        return blocks_.back().get();
+    }
+
+    static std::string_view Copy(std::string_view value, char* destination) {
+        if (!value.empty())
+            std::memcpy(destination, value.data(), value.size());
+        return {destination, value.size()};
+    }
+
+private:  // Constants
+    static constexpr size_t kBlockCapacity{64u * 1024u};
+
+private:  // Fields
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* current_block_{nullptr};
+    size_t block_size_{0u};
+    size_t block_capacity_{0u};
+};
+
+}  // namespace memory
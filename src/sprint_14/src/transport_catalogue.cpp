@@ -1,89 +1,150 @@
 #include "transport_catalogue.h"
 
+#include <algorithm>
 #include <numeric>
+#include <stdexcept>
+
+#include "profiler.h"
+#include "thread_pool.h"
 
 namespace catalogue {
 
 void TransportCatalogue::AddStop(Stop stop) {
-    // Add stop logic
-    const auto position = stops_storage_.insert(stops_storage_.begin(), std::move(stop));
-    stops_.insert({position->name, std::make_shared<Stop>(*position)});
+    if (stop_ids_.count(stop.name) > 0)
+        return;
+
+    const auto id = static_cast<StopId>(stop_names_.size());
+    const std::string_view name = names_.Store(stop.name);
+
+    stop_names_.push_back(name);
+    stop_latitudes_.push_back(stop.point.lat);
+    stop_longitudes_.push_back(stop.point.lng);
+    stop_terms_.Add(stop.point);
+    stop_ids_.emplace(name, id);
+
     // Add stop for <stop-bus> correspondence
     // TODO: !!! При вычислении коэффициентов масштабирования карты должны учитываться только те остановки, которые
     // входят в какой-либо маршрут. Остановки, которые не входят ни в один из маршрутов, учитываться не должны.
-    buses_through_stop_.insert({position->name, {}});
+    buses_through_stop_.emplace_back();
 }
 
 void TransportCatalogue::AddDistance(std::string_view stop_from, std::string_view stop_to, int distance) {
     //! On this step we suppose that ALL stops have been parsed
-    distances_between_stops_.insert({{stops_.at(stop_from), stops_.at(stop_to)}, distance});
+    const StopId from = GetStopId(stop_from);
+    const StopId to = GetStopId(stop_to);
+    distances_between_stops_.Add(from, to, distance);
+
+    // Distance changes the length of the routes through both stops only
+    for (StopId stop : {from, to}) {
+        for (BusId bus : buses_through_stop_[stop])
+            bus_statistics_[bus].reset();
+    }
 }
 
 void TransportCatalogue::AddBus(Bus bus) {
     //! On this step we suppose that ALL stops have been parsed
-    for (auto& stop : bus.stop_names) {
-        stop = stops_.find(stop)->first;
-        UpdateMinMaxStopCoordinates(stops_.at(stop)->point);
+    const auto id = static_cast<BusId>(bus_numbers_.size());
+    const std::string_view number = names_.Store(bus.number);
+
+    const size_t route_begin = route_stops_.size();
+    for (std::string_view stop_name : bus.stop_names) {
+        const StopId stop = GetStopId(stop_name);
+        route_stops_.push_back(stop);
+        UpdateMinMaxStopCoordinates(GetStopPoint(stop));
     }
-    bus.unique_stops = {bus.stop_names.begin(), bus.stop_names.end()};
+    route_offsets_.push_back(route_stops_.size());
+
+    std::vector<StopId> unique_stops(route_stops_.begin() + static_cast<std::ptrdiff_t>(route_begin),
+                                     route_stops_.end());
+    std::sort(unique_stops.begin(), unique_stops.end());
+    unique_stops.erase(std::unique(unique_stops.begin(), unique_stops.end()), unique_stops.end());
+
+    bus_numbers_.push_back(number);
+    bus_types_.push_back(bus.type);
+    bus_unique_stops_counts_.push_back(unique_stops.size());
+    bus_ids_.emplace(number, id);
+    bus_statistics_.emplace_back();
 
-    const auto position = buses_storage_.insert(buses_storage_.begin(), std::move(bus));
-    buses_.insert({position->number, std::make_shared<Bus>(*position)});
-    ordered_bus_list_.emplace(position->number);
+    const auto is_less = [this](BusId other, std::string_view value) { return bus_numbers_[other] < value; };
+    ordered_buses_.insert(std::lower_bound(ordered_buses_.begin(), ordered_buses_.end(), number, is_less), id);
 
     // Add stop for <stop-bus> correspondence
-    for (std::string_view stop : position->stop_names)
-        buses_through_stop_[stop].insert(position->number);
+    for (StopId stop : unique_stops) {
+        auto& buses = buses_through_stop_[stop];
+        buses.insert(std::lower_bound(buses.begin(), buses.end(), number, is_less), id);
+    }
+}
+
+void TransportCatalogue::ComputeBusStatistics() {
+    PROFILE_SCOPE("TransportCatalogue::ComputeBusStatistics");
+
+    std::vector<BusId> buses;
+    for (BusId bus = 0; bus < bus_statistics_.size(); ++bus) {
+        if (!bus_statistics_[bus])
+            buses.push_back(bus);
+    }
+
+    // Each task writes only the statistics of its own bus
+    parallel::ThreadPool::Instance().Run(buses.size(), [this, &buses](size_t index) {
+        bus_statistics_[buses[index]] = CalculateBusStatistics(buses[index]);
+    });
 }
 
 std::optional<BusStatistics> TransportCatalogue::GetBusStatistics(std::string_view bus_number) const {
-    if (buses_.count(bus_number) == 0)
+    const auto position = bus_ids_.find(bus_number);
+    if (position == bus_ids_.end())
         return std::nullopt;
 
-    auto bus_info = buses_.at(bus_number);
+    const BusId bus = position->second;
+    if (const auto& statistics = bus_statistics_[bus])
+        return statistics;
+    return CalculateBusStatistics(bus);
+}
+
+void TransportCatalogue::SetBusStatistics(BusId bus, int route_length, double curvature) {
+    bus_statistics_[bus] = MakeBusStatistics(bus, route_length, curvature);
+}
+
+BusStatistics TransportCatalogue::CalculateBusStatistics(BusId bus) const {
+    const int route_length = CalculateRouteLength(bus);
+    return MakeBusStatistics(bus, route_length, static_cast<double>(route_length) / CalculateGeographicLength(bus));
+}
+
+BusStatistics TransportCatalogue::MakeBusStatistics(BusId bus, int route_length, double curvature) const {
+    const size_t stops_count = route_offsets_[bus + 1] - route_offsets_[bus];
 
     BusStatistics result;
-    result.number = bus_info->number;
-    result.stops_count = bus_info->GetStopsCount();
-    result.unique_stops_count = bus_info->unique_stops.size();
-    result.rout_length = CalculateRouteLength(bus_info);
-    result.curvature = static_cast<double>(result.rout_length) / CalculateGeographicLength(bus_info);
+    result.number = bus_numbers_[bus];
+    result.stops_count = (bus_types_[bus] == RouteType::CIRCLE) ? stops_count : 2 * stops_count - 1;
+    result.unique_stops_count = bus_unique_stops_counts_[bus];
+    result.rout_length = route_length;
+    result.curvature = curvature;
 
     return result;
 }
 
-int TransportCatalogue::CalculateRouteLength(const std::shared_ptr<Bus>& bus_info) const {
-    auto get_route_length = [this](std::string_view from, std::string_view to) {
-        auto key = std::make_pair(stops_.at(from), stops_.at(to));
-        // If we not found 'from -> to' than we are looking for 'to -> from'
-        return (distances_between_stops_.count(key) > 0)
-                   ? distances_between_stops_.at(key)
-                   : distances_between_stops_.at({stops_.at(to), stops_.at(from)});
-    };
+int TransportCatalogue::CalculateRouteLength(BusId bus) const {
+    const auto stops = GetBusStops(bus);
+    const auto get_route_length = [this](StopId from, StopId to) { return GetDistance(from, to); };
 
-    int forward_route =
-        std::transform_reduce(bus_info->stop_names.begin(), std::prev(bus_info->stop_names.end()),
-                              std::next(bus_info->stop_names.begin()), 0, std::plus<>(), get_route_length);
-    if (bus_info->type == RouteType::CIRCLE)
+    int forward_route = std::transform_reduce(stops.begin(), std::prev(stops.end()), std::next(stops.begin()), 0,
+                                              std::plus<>(), get_route_length);
+    if (bus_types_[bus] == RouteType::CIRCLE)
         return forward_route;
 
     // Otherwise, this is a two-directional way, so we need to calculate the distance on backward way
-
-    int backward_route =
-        std::transform_reduce(bus_info->stop_names.rbegin(), std::prev(bus_info->stop_names.rend()),
-                              std::next(bus_info->stop_names.rbegin()), 0, std::plus<>(), get_route_length);
+    int backward_route = std::transform_reduce(std::next(stops.begin()), stops.end(), stops.begin(), 0,
+                                               std::plus<>(), get_route_length);
 
     return forward_route + backward_route;
 }
 
-double TransportCatalogue::CalculateGeographicLength(const std::shared_ptr<Bus>& bus_info) const {
-    double geographic_length = std::transform_reduce(
-        std::next(bus_info->stop_names.begin()), bus_info->stop_names.end(), bus_info->stop_names.begin(), 0.,
-        std::plus<>(), [this](std::string_view from, std::string_view to) {
-            return ComputeDistance(stops_.at(from)->point, stops_.at(to)->point);
-        });
+double TransportCatalogue::CalculateGeographicLength(BusId bus) const {
+    const auto stops = GetBusStops(bus);
+    const auto stops_count = static_cast<size_t>(stops.end() - stops.begin());
+    double geographic_length = geo::ComputePathLength(stop_terms_, stops.begin(), stops_count);
 
-    return (bus_info->type == RouteType::CIRCLE) ? geographic_length : geographic_length * 2.;
+    return (bus_types_[bus] == RouteType::CIRCLE) ? geographic_length : geographic_length * 2.;
 }
 
 void TransportCatalogue::UpdateMinMaxStopCoordinates(const geo::Coordinates& coordinates) {
@@ -94,6 +155,42 @@ void TransportCatalogue::UpdateMinMaxStopCoordinates(const geo::Coordinates& coo
     coordinates_max_.lng = std::max(coordinates_max_.lng, coordinates.lng);
 }
 
+size_t TransportCatalogue::GetStopsCount() const {
+    return stop_names_.size();
+}
+
+size_t TransportCatalogue::GetBusesCount() const {
+    return bus_numbers_.size();
+}
+
+StopId TransportCatalogue::GetStopId(std::string_view stop_name) const {
+    return stop_ids_.at(stop_name);
+}
+
+BusId TransportCatalogue::GetBusId(std::string_view bus_number) const {
+    return bus_ids_.at(bus_number);
+}
+
+std::string_view TransportCatalogue::GetStopName(StopId stop) const {
+    return stop_names_[stop];
+}
+
+geo::Coordinates TransportCatalogue::GetStopPoint(StopId stop) const {
+    return {stop_latitudes_[stop], stop_longitudes_[stop]};
+}
+
+std::string_view TransportCatalogue::GetBusNumber(BusId bus) const {
+    return bus_numbers_[bus];
+}
+
+RouteType TransportCatalogue::GetBusType(BusId bus) const {
+    return bus_types_[bus];
+}
+
+TransportCatalogue::StopsRange TransportCatalogue::GetBusStops(BusId bus) const {
+    return {route_stops_.data() + route_offsets_[bus], route_stops_.data() + route_offsets_[bus + 1]};
+}
+
 const geo::Coordinates& TransportCatalogue::GetMinStopCoordinates() const {
     return coordinates_min_;
 }
@@ -102,93 +199,77 @@ const geo::Coordinates& TransportCatalogue::GetMaxStopCoordinates() const {
     return coordinates_max_;
 }
 
-const std::set<std::string_view>& TransportCatalogue::GetOrderedBusList() const {
-    return ordered_bus_list_;
+const std::vector<BusId>& TransportCatalogue::GetOrderedBuses() const {
+    return ordered_buses_;
 }
 
-BusStopsStorage TransportCatalogue::GetFinalStops(std::string_view bus_name) const {
-    auto bus = buses_.at(bus_name);
+std::vector<StopId> TransportCatalogue::GetFinalStops(BusId bus) const {
+    const auto route = GetBusStops(bus);
 
-    std::vector<std::shared_ptr<Stop>> stops;
+    std::vector<StopId> stops;
 
-    if (bus->stop_names.empty())
-        return std::make_pair(bus, stops);
+    if (route.begin() == route.end())
+        return stops;
 
-    if (bus->type == RouteType::CIRCLE) {
-        // In a circular route, the first stop on the route is considered the final stop
-        stops.emplace_back(stops_.at(bus->stop_names.front()));
-    } else if (bus->type == RouteType::TWO_DIRECTIONAL) {
-        // In a non-circular route, the first and the last stops on the route are considered the final stops
-        stops.emplace_back(stops_.at(bus->stop_names.front()));
+    const StopId first = *route.begin();
+    const StopId last = *std::prev(route.end());
 
-        if (bus->stop_names.front() != bus->stop_names.back())
-            stops.emplace_back(stops_.at(bus->stop_names.back()));
-    }
+    // In a circular route, the first stop on the route is considered the final stop. In a non-circular route, the
+    // first and the last stops on the route are considered the final stops
+    stops.push_back(first);
+    if (bus_types_[bus] == RouteType::TWO_DIRECTIONAL && first != last)
+        stops.push_back(last);
 
-    return std::make_pair(bus, stops);
+    return stops;
 }
 
-BusStopsStorage TransportCatalogue::GetRouteInfo(std::string_view bus_name, bool include_backward_way) const {
-    auto bus = buses_.at(bus_name);
-
-    std::vector<std::shared_ptr<Stop>> stops;
-    stops.reserve(bus->GetStopsCount());
+std::vector<StopId> TransportCatalogue::GetRouteStops(BusId bus, bool include_backward_way) const {
+    const auto route = GetBusStops(bus);
 
     // Forward way
-    for (std::string_view stop : bus->stop_names)
-        stops.emplace_back(stops_.at(stop));
+    std::vector<StopId> stops(route.begin(), route.end());
 
-    // Backward way
-    if (include_backward_way && bus->type == catalogue::RouteType::TWO_DIRECTIONAL) {
-        for (auto stop = std::next(bus->stop_names.rbegin()); stop != bus->stop_names.rend(); ++stop)
-            stops.emplace_back(stops_.at(*stop));
+    // Backward way (it is taken from the route, because the range of the vector could not be inserted into itself)
+    if (include_backward_way && bus_types_[bus] == RouteType::TWO_DIRECTIONAL && !stops.empty()) {
+        stops.reserve(2 * stops.size() - 1);
+        stops.insert(stops.end(), std::next(std::make_reverse_iterator(route.end())),
+                     std::make_reverse_iterator(route.begin()));
     }
 
-    return std::make_pair(std::move(bus), std::move(stops));
+    return stops;
 }
 
-StopsStorage TransportCatalogue::GetAllStopsFromRoutes() const {
-    std::unordered_map<std::string_view, std::shared_ptr<Stop>> stops;
-
+std::vector<StopId> TransportCatalogue::GetAllStopsFromRoutes() const {
     // Take only stops, which are part of any bus route
-    for (const auto& [_, bus] : buses_) {
-        for (std::string_view stop : bus->stop_names) {
-            if (stops.count(stop) == 0)
-                stops.emplace(stop, stops_.at(stop));
-        }
+    std::vector<bool> is_on_route(stop_names_.size(), false);
+    for (StopId stop : route_stops_)
+        is_on_route[stop] = true;
+
+    std::vector<StopId> stops;
+    for (StopId stop = 0; stop < stop_names_.size(); ++stop) {
+        if (is_on_route[stop])
+            stops.push_back(stop);
     }
-
-    return {stops.begin(), stops.end()};
-}
-
-std::set<std::string_view> TransportCatalogue::GetUniqueStops() const {
-    std::set<std::string_view> stops;
-
-    for (auto [stop_name, _] : stops_)
-        stops.emplace(stop_name);
+    std::sort(stops.begin(), stops.end(),
+              [this](StopId lhs, StopId rhs) { return stop_names_[lhs] < stop_names_[rhs]; });
 
     return stops;
 }
 
-const std::deque<Bus>& TransportCatalogue::GetBuses() const {
-    return buses_storage_;
+std::set<std::string_view> TransportCatalogue::GetUniqueStops() const {
+    return {stop_names_.begin(), stop_names_.end()};
 }
 
-StringViewPairStorage<Info> TransportCatalogue::GetAllDistancesOnTheRoute(std::string_view bus_number,
-                                                                          double bus_velocity) const {
+StringViewPairStorage<Info> TransportCatalogue::GetAllDistancesOnTheRoute(BusId bus, double bus_velocity) const {
     StringViewPairStorage<Info> distances;
 
     // Calculates the time necessary for the bus to get from stop 'from` to stop `to`
-    auto get_time = [this, &bus_velocity](std::string_view from, std::string_view to) -> double {
-        auto key = std::make_pair(stops_.at(from), stops_.at(to));
-        // If we not found 'from -> to' than we are looking for 'to -> from'
-        return (distances_between_stops_.count(key) > 0)
-                   ? distances_between_stops_.at(key) / bus_velocity
-                   : distances_between_stops_.at({stops_.at(to), stops_.at(from)}) / bus_velocity;
+    auto get_time = [this, &bus_velocity](StopId from, StopId to) -> double {
+        return GetDistance(from, to) / bus_velocity;
     };
 
     // Collects time between each pair of stops on the bus route
-    auto add_info = [&distances, &get_time](auto begin, auto end) {
+    auto add_info = [this, &distances, &get_time](auto begin, auto end) {
         double cumulative_time{0.};
         StringViewPair key;
         Info current_info;
@@ -200,7 +281,7 @@ StringViewPairStorage<Info> TransportCatalogue::GetAllDistancesOnTheRoute(std::s
 
             for (auto to = std::next(from); to != end; ++to) {
                 cumulative_time += get_time(*previous, *to);
-                key = StringViewPair{*from, *to};
+                key = StringViewPair{stop_names_[*from], stop_names_[*to]};
                 current_info = Info{cumulative_time, static_cast<int>(std::distance(from, to))};
 
                 // If bus could go through one stop several time - store only path with minimal time
@@ -215,34 +296,37 @@ StringViewPairStorage<Info> TransportCatalogue::GetAllDistancesOnTheRoute(std::s
         }
     };
 
-    const auto& bus = buses_.at(bus_number);
-    const auto& stops = bus->stop_names;
+    const auto stops = GetBusStops(bus);
 
-    if (bus->type == RouteType::TWO_DIRECTIONAL) {
+    if (bus_types_[bus] == RouteType::TWO_DIRECTIONAL) {
         // Add information about FORWARD and BACKWARD routes
         add_info(stops.begin(), stops.end());
-        add_info(stops.rbegin(), stops.rend());
+        add_info(std::make_reverse_iterator(stops.end()), std::make_reverse_iterator(stops.begin()));
 
-    } else if (bus->type == RouteType::CIRCLE) {
+    } else if (bus_types_[bus] == RouteType::CIRCLE) {
         add_info(stops.begin(), stops.end());
     }
 
     return distances;
 }
 
-std::unique_ptr<std::set<std::string_view>> TransportCatalogue::GetBusesPassingThroughTheStop(
-    std::string_view stop_name) const {
-    if (const auto position = buses_through_stop_.find(stop_name); position != buses_through_stop_.end())
-        return std::make_unique<std::set<std::string_view>>(position->second);
-    return nullptr;
+int TransportCatalogue::GetDistance(StopId from, StopId to) const {
+    // Distance 'to -> from' is used instead of the missing 'from -> to' already on adding
+    return distances_between_stops_.Get(from, to);
 }
 
-const std::deque<Stop>& TransportCatalogue::GetStops() const {
-    return stops_storage_;
+std::optional<TransportCatalogue::BusesRange> TransportCatalogue::GetBusesPassingThroughTheStop(
+    std::string_view stop_name) const {
+    const auto position = stop_ids_.find(stop_name);
+    if (position == stop_ids_.end())
+        return std::nullopt;
+
+    const auto& buses = buses_through_stop_[position->second];
+    return BusesRange{buses.data(), buses.data() + buses.size()};
 }
 
-const TransportCatalogue::InterStopsStorage<int>& TransportCatalogue::GetDistancesBetweenStops() const {
+const DistanceTable& TransportCatalogue::GetDistancesBetweenStops() const {
     return distances_between_stops_;
 }
 
-}  // namespace catalogue
\ No newline at end of file
+}  // namespace catalogue
@@ -1,21 +1,25 @@
 #pragma once
 
 /*
- * Description: transport directory module
+ * Description: transport directory module.
+ *
+ * Stops and buses get dense ids (StopId, BusId) in the order of adding, which are the indices in the structure of
+ * arrays storage: names are stored in the string arena, coordinates in the latitudes and longitudes arrays, routes of
+ * the buses are the consecutive ranges of the stops ids in one flat array. Names are resolved to ids only at the API
+ * boundary, so the internal computations (e.g. route length) work with the arrays only.
  */
 
-#include <deque>
-#include <map>
+#include <limits>
 #include <optional>
 #include <unordered_map>
 
+#include "distance_table.h"
 #include "domain.h"
+#include "ranges.h"
+#include "string_arena.h"
 
 namespace catalogue {
 
-using BusStopsStorage = std::pair<std::shared_ptr<Bus>, std::vector<std::shared_ptr<Stop>>>;
-using StopsStorage = std::map<std::string_view, std::shared_ptr<Stop>>;
-
 struct Info {
     double time{0.};
     int stops_count{0};
@@ -23,19 +27,8 @@ struct Info {
 
 class TransportCatalogue {
 public:  // Types
-    using StopPointersPair = std::pair<std::shared_ptr<Stop>, std::shared_ptr<Stop>>;
-
-    struct StopPointersPairHash {
-        size_t operator()(const StopPointersPair& pair) const {
-            return pair.first->Hash() + kPrimeValue * pair.second->Hash();
-        }
-
-    private:
-        static const int kPrimeValue{31};
-    };
-
-    template <class Type>
-    using InterStopsStorage = std::unordered_map<StopPointersPair, Type, StopPointersPairHash>;
+    using StopsRange = ranges::Range<const StopId*>;
+    using BusesRange = ranges::Range<const BusId*>;
 
 public:  // Constructors
     TransportCatalogue() = default;
@@ -45,9 +38,30 @@ public:  // Methods
     void AddBus(Bus bus);
     void AddDistance(std::string_view stop_from, std::string_view stop_to, int distance);
 
+    /// @brief Computes the statistics of the buses, which have not been computed yet or have been invalidated by the
+    /// adding of the distances (buses are processed in parallel)
+    void ComputeBusStatistics();
+    /// @brief Returns the precomputed statistics, if it is up to date, otherwise computes it on the fly
     [[nodiscard]] std::optional<BusStatistics> GetBusStatistics(std::string_view bus_number) const;
-    [[nodiscard]] std::unique_ptr<std::set<std::string_view>> GetBusesPassingThroughTheStop(
-        std::string_view stop_name) const;
+    /// @brief Buses through the stop ordered by their numbers (std::nullopt if there is no such stop)
+    /// @details Range is the view of the catalogue storage, so it is valid until the next bus adding
+    [[nodiscard]] std::optional<BusesRange> GetBusesPassingThroughTheStop(std::string_view stop_name) const;
+
+    /* METHODS FOR ACCESS BY IDS */
+
+    [[nodiscard]] size_t GetStopsCount() const;
+    [[nodiscard]] size_t GetBusesCount() const;
+    /// @brief Returns id of the stop or the bus by its name (throws std::out_of_range if there is no such one)
+    [[nodiscard]] StopId GetStopId(std::string_view stop_name) const;
+    [[nodiscard]] BusId GetBusId(std::string_view bus_number) const;
+
+    [[nodiscard]] std::string_view GetStopName(StopId stop) const;
+    [[nodiscard]] geo::Coordinates GetStopPoint(StopId stop) const;
+
+    [[nodiscard]] std::string_view GetBusNumber(BusId bus) const;
+    [[nodiscard]] RouteType GetBusType(BusId bus) const;
+    /// @brief Stops of the bus in the order of the input (without the backward way of the two-directional bus)
+    [[nodiscard]] StopsRange GetBusStops(BusId bus) const;
 
     /* METHODS FOR MAP IMAGE RENDERING */
 
@@ -56,36 +70,56 @@ public:  // Methods
 
     /* METHODS FOR REQUESTS RESPONSE */
 
-    [[nodiscard]] const std::set<std::string_view>& GetOrderedBusList() const;
-    [[nodiscard]] BusStopsStorage GetFinalStops(std::string_view bus_name) const;
-    [[nodiscard]] BusStopsStorage GetRouteInfo(std::string_view bus_name, bool include_backward_way = true) const;
-    [[nodiscard]] StopsStorage GetAllStopsFromRoutes() const;
+    /// @brief Buses ordered by their numbers
+    [[nodiscard]] const std::vector<BusId>& GetOrderedBuses() const;
+    [[nodiscard]] std::vector<StopId> GetFinalStops(BusId bus) const;
+    [[nodiscard]] std::vector<StopId> GetRouteStops(BusId bus, bool include_backward_way = true) const;
+    /// @brief Stops, which are the part of any bus route, ordered by their names
+    [[nodiscard]] std::vector<StopId> GetAllStopsFromRoutes() const;
 
     /* METHODS FOR TRANSPORT ROUTING */
     [[nodiscard]] std::set<std::string_view> GetUniqueStops() const;
-    [[nodiscard]] const std::deque<Bus>& GetBuses() const;
-    [[nodiscard]] StringViewPairStorage<Info> GetAllDistancesOnTheRoute(std::string_view bus_number,
-                                                                        double bus_velocity) const;
+    [[nodiscard]] StringViewPairStorage<Info> GetAllDistancesOnTheRoute(BusId bus, double bus_velocity) const;
+    /// @brief Road distance 'from' -> 'to' (if it is not set, the distance 'to' -> 'from' is used)
+    /// @details Throws std::out_of_range if there is no distance in any direction
+    [[nodiscard]] int GetDistance(StopId from, StopId to) const;
 
     /* METHODS USED FOR SERIALIZATION */
-    [[nodiscard]] const std::deque<Stop>& GetStops() const;
-    [[nodiscard]] const InterStopsStorage<int>& GetDistancesBetweenStops() const;
+    [[nodiscard]] const DistanceTable& GetDistancesBetweenStops() const;
+    void SetBusStatistics(BusId bus, int route_length, double curvature);
 
 private:  // Methods
-    [[nodiscard]] int CalculateRouteLength(const std::shared_ptr<Bus>& bus_info) const;
-    [[nodiscard]] double CalculateGeographicLength(const std::shared_ptr<Bus>& bus_info) const;
+    [[nodiscard]] BusStatistics CalculateBusStatistics(BusId bus) const;
+    [[nodiscard]] BusStatistics MakeBusStatistics(BusId bus, int route_length, double curvature) const;
+    [[nodiscard]] int CalculateRouteLength(BusId bus) const;
+    [[nodiscard]] double CalculateGeographicLength(BusId bus) const;
 
     void UpdateMinMaxStopCoordinates(const geo::Coordinates& coordinates);
 
 private:  // Fields
-    std::deque<Stop> stops_storage_;
-    std::unordered_map<std::string_view, std::shared_ptr<Stop>> stops_;
-
-    std::deque<Bus> buses_storage_;
-    std::unordered_map<std::string_view, std::shared_ptr<Bus>> buses_;
-
-    std::unordered_map<std::string_view, std::set<std::string_view>> buses_through_stop_;
-    InterStopsStorage<int> distances_between_stops_;
+    memory::StringArena names_;
+
+    // Stops: structure of arrays, indexed by StopId
+    std::vector<std::string_view> stop_names_;
+    std::vector<double> stop_latitudes_;
+    std::vector<double> stop_longitudes_;
+    geo::PointsTerms stop_terms_;  // for the batch computation of the geographic distances
+    std::unordered_map<std::string_view, StopId> stop_ids_;
+
+    // Buses: structure of arrays, indexed by BusId. Stops of the bus B are [route_offsets_[B], route_offsets_[B + 1])
+    // of route_stops_
+    std::vector<std::string_view> bus_numbers_;
+    std::vector<RouteType> bus_types_;
+    std::vector<size_t> bus_unique_stops_counts_;
+    std::vector<size_t> route_offsets_{0u};
+    std::vector<StopId> route_stops_;
+    std::unordered_map<std::string_view, BusId> bus_ids_;
+    // Precomputed statistics (std::nullopt, if it has not been computed or it is out of date)
+    std::vector<std::optional<BusStatistics>> bus_statistics_;
+
+    // Buses through each stop, ordered by their numbers (indexed by StopId)
+    std::vector<std::vector<BusId>> buses_through_stop_;
+    DistanceTable distances_between_stops_;
 
     // Fields required for map image rendering
     geo::Coordinates coordinates_min_{std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
@@ -93,7 +127,7 @@ private:  // Fields
 
     // We use unordered containers for faster search in queries.
     // Ordered list in necessary for image rendering only
-    std::set<std::string_view> ordered_bus_list_;
+    std::vector<BusId> ordered_buses_;
 };
 
-}  // namespace catalogue
\ No newline at end of file
+}  // namespace catalogue
@@ -1,15 +1,19 @@
 #include "transport_router.h"
 
 #include <iostream>
+#include <type_traits>
+
+#include "profiler.h"
 
 namespace routing {
 
 TransportRouter::TransportRouter(const catalogue::TransportCatalogue& catalogue, Settings settings)
     : catalogue_(catalogue), settings_(settings) {
-    BuildVerticesForStops(catalogue.GetUniqueStops());
-    BuildRoutesGraph(catalogue.GetBuses());
+    PROFILE_SCOPE("TransportRouter::TransportRouter");
 
-    router_ = std::make_unique<Router>(*routes_);
+    BuildVerticesForStops(catalogue.GetUniqueStops());
+    BuildRoutesGraph();
+    BuildRouter();
 }
 
 // clang-format off
@@ -17,13 +21,15 @@ TransportRouter::TransportRouter(const catalogue::TransportCatalogue& catalogue,
                                  Graph graph,
                                  StopToVertexStorage stop_to_vertex,
                                  EdgeToResponseStorage edge_to_response,
-                                 Settings settings)
+                                 Settings settings,
+                                 RouterData router_data)
     : catalogue_(catalogue),
-      routes_(std::make_unique<Graph>(std::move(graph))),
-      router_(std::make_unique<Router>(*routes_)),
+      settings_(settings),
       stop_to_vertex_(std::move(stop_to_vertex)),
       edge_to_response_(std::move(edge_to_response)),
-      settings_(settings) {}
+      routes_(std::make_unique<Graph>(std::move(graph))) {
+    BuildRouter(std::move(router_data));
+}
 // clang-format on
 
 void TransportRouter::BuildVerticesForStops(const std::set<std::string_view>& stops) {
@@ -41,8 +47,9 @@ void TransportRouter::BuildVerticesForStops(const std::set<std::string_view>& st
     }
 }
 
-void TransportRouter::AddBusRouteEdges(const catalogue::Bus& bus) {
-    const auto& distances = catalogue_.GetAllDistancesOnTheRoute(bus.number, settings_.bus_velocity_);
+void TransportRouter::AddBusRouteEdges(catalogue::BusId bus) {
+    const std::string_view number = catalogue_.GetBusNumber(bus);
+    const auto& distances = catalogue_.GetAllDistancesOnTheRoute(bus, settings_.bus_velocity_);
 
     graph::VertexId from{0};
     graph::VertexId to{0};
@@ -51,47 +58,183 @@ void TransportRouter::AddBusRouteEdges(const catalogue::Bus& bus) {
         from = stop_to_vertex_[route.first].end;
         to = stop_to_vertex_[route.second].start;
 
-        auto edge = graph::Edge<Weight>{from, to, info.time};
-
-        routes_->AddEdge(edge);
-        edge_to_response_.emplace(edge, BusResponse(info.time, bus.number, info.stops_count));
+        routes_->AddEdge({from, to, info.time});
+        edge_to_response_.push_back({ResponseType::Bus, info.time, number, info.stops_count});
     }
 }
 
-void TransportRouter::BuildRoutesGraph(const std::deque<catalogue::Bus>& buses) {
+void TransportRouter::BuildRoutesGraph() {
+    PROFILE_SCOPE("TransportRouter::BuildRoutesGraph");
+
     routes_ = std::make_unique<Graph>(stop_to_vertex_.size() * 2);
 
     // Step 1. Create "wait"-type edges for each stop
     auto wait_time = static_cast<double>(settings_.bus_wait_time_);
-    auto stop_edge = graph::Edge<Weight>{};
 
     for (auto [stop_name, stop_vertices] : stop_to_vertex_) {
-        stop_edge = graph::Edge<Weight>{stop_vertices.start, stop_vertices.end, wait_time};
-
-        routes_->AddEdge(stop_edge);
-        edge_to_response_.emplace(stop_edge, WaitResponse(wait_time, stop_name));
+        routes_->AddEdge({stop_vertices.start, stop_vertices.end, wait_time});
+        edge_to_response_.push_back({ResponseType::Wait, wait_time, stop_name});
     }
 
-    // Step 2. Add "bus"-type edges for each stop in bus route
-    for (const auto& bus : buses)
+    // Step 2. Add "bus"-type edges for each stop in bus route (RaptorRouter works with the routes themselves)
+    if (settings_.router_type_ == RouterType::Raptor)
+        return;
+
+    for (catalogue::BusId bus = 0; bus < catalogue_.GetBusesCount(); ++bus)
         AddBusRouteEdges(bus);
 }
 
+void TransportRouter::BuildRouter(RouterData router_data) {
+    // All routers work with the CSR representation of the graph
+    routes_->Freeze();
+
+    switch (settings_.router_type_) {
+        case RouterType::AllPairs:
+            BuildAllPairsRouter(graph::AllPairsAlgorithm::FloydWarshall, router_data);
+            break;
+        case RouterType::AllPairsDijkstra:
+            BuildAllPairsRouter(graph::AllPairsAlgorithm::ParallelDijkstra, router_data);
+            break;
+        case RouterType::Dijkstra:
+            router_ = std::make_unique<DijkstraRouter>(*routes_, settings_.router_cache_size_);
+            break;
+        case RouterType::ContractionHierarchies: {
+            // Hierarchy is preprocessed only if it has not been restored from the base
+            PROFILE_SCOPE("graph::ContractionHierarchy::ContractionHierarchy");
+            auto* hierarchy = std::get_if<ContractionHierarchy::Data>(&router_data);
+            router_ = hierarchy ? std::make_unique<ContractionHierarchy>(*routes_, std::move(*hierarchy))
+                                : std::make_unique<ContractionHierarchy>(*routes_);
+            break;
+        }
+        case RouterType::Raptor: {
+            // Routes data is linear in the routes length, so it is not stored in the base
+            PROFILE_SCOPE("RaptorRouter::RaptorRouter");
+            router_ = std::make_unique<RaptorRouter>(catalogue_, settings_.bus_velocity_,
+                                                     static_cast<double>(settings_.bus_wait_time_));
+            break;
+        }
+    }
+}
+
+void TransportRouter::BuildAllPairsRouter(graph::AllPairsAlgorithm algorithm, RouterData& router_data) {
+    PROFILE_SCOPE("graph::Router::Router");
+
+    // Routes table is computed only if it has not been restored from the base
+    if (settings_.router_float_weights_) {
+        auto* table = std::get_if<CompactRouter::Data>(&router_data);
+        router_ = table ? std::make_unique<CompactRouter>(*routes_, std::move(*table))
+                        : std::make_unique<CompactRouter>(*routes_, algorithm);
+    } else {
+        auto* table = std::get_if<Router::Data>(&router_data);
+        router_ = table ? std::make_unique<Router>(*routes_, std::move(*table))
+                        : std::make_unique<Router>(*routes_, algorithm);
+    }
+}
+
 ResponseDataOpt TransportRouter::BuildRoute(std::string_view from, std::string_view to) const {
-    ResponseDataOpt response{std::nullopt};
+    PROFILE_SCOPE("TransportRouter::BuildRoute");
+
+    if (const auto* raptor = std::get_if<std::unique_ptr<RaptorRouter>>(&router_)) {
+        auto journey = (*raptor)->BuildRoute(from, to);
+        return journey ? std::make_optional(MakeTransitResponse(*journey)) : std::nullopt;
+    }
 
     graph::VertexId id_from = stop_to_vertex_.at(from).start;
     graph::VertexId id_to = stop_to_vertex_.at(to).start;
 
-    if (auto route = router_->BuildRoute(id_from, id_to)) {
-        response.emplace(ResponseData{});
-        response->total_time = route->weight;
+    auto route = std::visit(
+        [id_from, id_to](const auto& router) -> std::optional<graph::RouteInfo<Weight>> {
+            // RaptorRouter does not work with the graph (see above)
+            if constexpr (std::is_same_v<std::decay_t<decltype(router)>, std::unique_ptr<RaptorRouter>>)
+                return std::nullopt;
+            else
+                return router->BuildRoute(id_from, id_to);
+        },
+        router_);
 
-        for (auto edge_id : route->edges) {
-            graph::Edge<Weight> edge = routes_->GetEdge(edge_id);
+    return route ? std::make_optional(MakeResponse(*route)) : std::nullopt;
+}
 
-            response->items.emplace_back(edge_to_response_.at(edge));
-        }
+std::vector<ResponseDataOpt> TransportRouter::BuildRoutes(std::string_view from,
+                                                          const std::vector<std::string_view>& to) const {
+    PROFILE_SCOPE("TransportRouter::BuildRoutes");
+
+    std::vector<ResponseDataOpt> responses;
+    responses.reserve(to.size());
+
+    if (const auto* raptor = std::get_if<std::unique_ptr<RaptorRouter>>(&router_)) {
+        for (auto& journey : (*raptor)->BuildRoutes(from, to))
+            responses.push_back(journey ? std::make_optional(MakeTransitResponse(*journey)) : std::nullopt);
+        return responses;
+    }
+
+    graph::VertexId id_from = stop_to_vertex_.at(from).start;
+    const auto ids_to = GetStartVertices(to);
+
+    auto routes = std::visit(
+        [id_from, &ids_to](const auto& router) -> std::vector<std::optional<graph::RouteInfo<Weight>>> {
+            if constexpr (std::is_same_v<std::decay_t<decltype(router)>, std::unique_ptr<RaptorRouter>>)
+                return {};
+            else
+                return router->BuildRoutes(id_from, ids_to);
+        },
+        router_);
+
+    for (const auto& route : routes)
+        responses.push_back(route ? std::make_optional(MakeResponse(*route)) : std::nullopt);
+    return responses;
+}
+
+RouteTimesMatrix TransportRouter::BuildRouteMatrix(const std::vector<std::string_view>& from,
+                                                   const std::vector<std::string_view>& to) const {
+    PROFILE_SCOPE("TransportRouter::BuildRouteMatrix");
+
+    RouteTimesMatrix matrix;
+    matrix.reserve(from.size());
+
+    if (const auto* hierarchy = GetRouter<ContractionHierarchy>()) {
+        // Weights are returned as the row-major matrix
+        const auto weights = hierarchy->BuildWeightsMatrix(GetStartVertices(from), GetStartVertices(to));
+        for (size_t row = 0; row < from.size(); ++row)
+            matrix.emplace_back(weights.begin() + row * to.size(), weights.begin() + (row + 1) * to.size());
+        return matrix;
+    }
+
+    for (std::string_view stop_from : from) {
+        auto& row = matrix.emplace_back();
+        row.reserve(to.size());
+        for (const auto& response : BuildRoutes(stop_from, to))
+            row.push_back(response ? std::make_optional(response->total_time) : std::nullopt);
+    }
+    return matrix;
+}
+
+std::vector<graph::VertexId> TransportRouter::GetStartVertices(const std::vector<std::string_view>& stops) const {
+    std::vector<graph::VertexId> vertices;
+    vertices.reserve(stops.size());
+    for (std::string_view stop : stops)
+        vertices.push_back(stop_to_vertex_.at(stop).start);
+    return vertices;
+}
+
+ResponseData TransportRouter::MakeResponse(const graph::RouteInfo<Weight>& route) const {
+    ResponseData response{route.weight, {}};
+    response.items.reserve(route.edges.size());
+
+    for (auto edge_id : route.edges)
+        response.items.push_back(edge_to_response_[edge_id]);
+
+    return response;
+}
+
+ResponseData TransportRouter::MakeTransitResponse(const RaptorRouter::Journey& journey) const {
+    ResponseData response{journey.total_time, {}};
+    response.items.reserve(journey.legs.size() * 2);
+
+    const auto wait_time = static_cast<double>(settings_.bus_wait_time_);
+    for (const auto& leg : journey.legs) {
+        response.items.push_back({ResponseType::Wait, wait_time, leg.stop});
+        response.items.push_back({ResponseType::Bus, leg.time, leg.bus, leg.span_count});
     }
 
     return response;
@@ -109,8 +252,8 @@ const TransportRouter::Graph& TransportRouter::GetGraph() const {
     return *routes_;
 }
 
-const ResponseItem& TransportRouter::GetResponse(const graph::Edge<TransportRouter::Weight>& edge) const {
-    return edge_to_response_.at(edge);
+const ResponseItem& TransportRouter::GetResponse(graph::EdgeId edge_id) const {
+    return edge_to_response_.at(edge_id);
 }
 
 const TransportRouter::StopVertices& TransportRouter::GetStopVertices(std::string_view stop) const {
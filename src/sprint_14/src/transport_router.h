@@ -5,44 +5,53 @@
  * possibility to build routes between two stops
  */
 
+#include <cstdint>
+#include <memory>
+#include <string_view>
 #include <variant>
+#include <vector>
 
+#include "contraction_hierarchy.h"
+#include "dijkstra_router.h"
 #include "domain.h"
+#include "raptor_router.h"
 #include "router.h"
 #include "transport_catalogue.h"
 
 namespace routing {
 
+/// @brief Algorithm, used to find the shortest routes in the graph
+enum class RouterType {
+    AllPairs,                // graph::Router: all routes are precomputed in O(V^3) time and O(V^2) memory
+    Dijkstra,                // graph::DijkstraRouter: routes are found on demand, trees are cached per source stop
+    ContractionHierarchies,  // graph::ContractionHierarchy: preprocessed hierarchy, which is stored in the base
+    AllPairsDijkstra,        // graph::Router: all routes are precomputed by the parallel Dijkstra search per source
+    Raptor                   // RaptorRouter: rounds over the bus routes, no graph edges between the pairs of stops
+};
+
 struct Settings {
     double bus_velocity_{0};  // velocity in meters to minutes
     int bus_wait_time_{0};    // time in minutes
+
+    RouterType router_type_{RouterType::AllPairs};
+    size_t router_cache_size_{graph::DijkstraRouter<double>::kDefaultCacheSize};  // only for RouterType::Dijkstra
+    bool router_float_weights_{false};  // only for the all-pairs routers: store table weights as float
 };
 
 /* TRANSPORT ROUTER RESPONSE FORMAT */
 
-/// @brief Response in the route corresponding to the stop
-struct WaitResponse {
-    double time{0.};
-    std::string type{"Wait"};
-
-    std::string stop_name;
-
-    WaitResponse(double time, std::string_view stop) : time(time), stop_name(stop) {}
-};
+enum class ResponseType : uint8_t { Wait, Bus };
 
-/// @brief Response in the route corresponding to the bus
-struct BusResponse {
+/// @brief Item of the route: wait for the bus on the stop or ride the bus through 'span_count' stops
+/// @details Name is the view of the stop name (Wait) or of the bus number (Bus) stored in the catalogue, so the items
+/// are copied without the allocations
+struct ResponseItem {
+    ResponseType type{ResponseType::Wait};
     double time{0.};
-    std::string type{"Bus"};
-
-    std::string bus;
-    int span_count{0};
-
-    BusResponse(double time, const std::string& bus, int stops_count) : time(time), bus(bus), span_count(stops_count) {}
+    std::string_view name;
+    int span_count{0};  // only for ResponseType::Bus
 };
 
-using ResponseItem = std::variant<WaitResponse, BusResponse>;
-
 struct ResponseData {
     double total_time{0.};
     std::vector<ResponseItem> items;
@@ -50,6 +59,9 @@ struct ResponseData {
 
 using ResponseDataOpt = std::optional<ResponseData>;
 
+/// @brief Times of the routes between the stops: matrix[i][j] is the time from the i-th stop to the j-th one
+using RouteTimesMatrix = std::vector<std::vector<std::optional<double>>>;
+
 /* TRANSPORT ROUTER CLASS */
 
 class TransportRouter {
@@ -57,6 +69,9 @@ public:
     using Weight = double;
     using Graph = graph::DirectedWeightedGraph<Weight>;
     using Router = graph::Router<Weight>;
+    using CompactRouter = graph::Router<Weight, float>;
+    using DijkstraRouter = graph::DijkstraRouter<Weight>;
+    using ContractionHierarchy = graph::ContractionHierarchy<Weight>;
 
     struct StopVertices {
         graph::VertexId start{0};
@@ -64,19 +79,11 @@ public:
     };
     using StopToVertexStorage = std::unordered_map<std::string_view, StopVertices>;
 
-    struct EdgeHash {
-        inline size_t operator()(const graph::Edge<Weight>& edge) const {
-            // clang-format off
-            return kPrimeValue * std::hash<size_t>{}(edge.from) +
-                   kPrimeValue * kPrimeValue * std::hash<size_t>{}(edge.to) +
-                   kPrimeValue * kPrimeValue * kPrimeValue * std::hash<Weight>{}(edge.weight);
-            // clang-format on
-        }
-
-    private:
-        static constexpr int kPrimeValue{41};
-    };
-    using EdgeToResponseStorage = std::unordered_map<graph::Edge<Weight>, ResponseItem, EdgeHash>;
+    /// @brief Precomputed data of the router (e.g. restored from the base), which is used instead of the computation
+    using RouterData = std::variant<std::monostate, Router::Data, CompactRouter::Data, ContractionHierarchy::Data>;
+
+    /// @brief Route items of the graph edges: response of the edge E is stored in the position E
+    using EdgeToResponseStorage = std::vector<ResponseItem>;
 
 public:  // Constructor
     TransportRouter(const catalogue::TransportCatalogue& catalogue, Settings settings);
@@ -84,25 +91,45 @@ public:  // Constructor
     TransportRouter(const catalogue::TransportCatalogue& catalogue,
                     Graph graph,
                     StopToVertexStorage stop_to_vertex,
-                    EdgeToResponseStorage edge_to_response, Settings settings);
+                    EdgeToResponseStorage edge_to_response, Settings settings,
+                    RouterData router_data = {});
     // clang-format on
 
 public:  // Methods
     [[nodiscard]] ResponseDataOpt BuildRoute(std::string_view from, std::string_view to) const;
+    /// @brief Routes from one stop to each of the stops 'to', which share the search from 'from' (if the router has it)
+    [[nodiscard]] std::vector<ResponseDataOpt> BuildRoutes(std::string_view from,
+                                                           const std::vector<std::string_view>& to) const;
+    /// @brief Times of the routes from each of the stops 'from' to each of the stops 'to'. Contraction hierarchy
+    /// finds them with the many-to-many bucket search, the other routers with one search per stop 'from'
+    [[nodiscard]] RouteTimesMatrix BuildRouteMatrix(const std::vector<std::string_view>& from,
+                                                    const std::vector<std::string_view>& to) const;
 
     /* METHODS USED FOR SERIALIZATION */
 
     const Settings& GetSettings() const;
     const catalogue::TransportCatalogue& GetTransportCatalogue() const;
     const Graph& GetGraph() const;
-    const ResponseItem& GetResponse(const graph::Edge<Weight>& edge) const;
+    const ResponseItem& GetResponse(graph::EdgeId edge_id) const;
     const StopVertices& GetStopVertices(std::string_view stop) const;
+    /// @brief Returns the router of the given type (nullptr if the router uses the other algorithm)
+    template <typename Type>
+    const Type* GetRouter() const {
+        const auto* router = std::get_if<std::unique_ptr<Type>>(&router_);
+        return router ? router->get() : nullptr;
+    }
 
 private:  // Methods
     void BuildVerticesForStops(const std::set<std::string_view>& stops);
-    void AddBusRouteEdges(const catalogue::Bus& bus);
+    void AddBusRouteEdges(catalogue::BusId bus);
+
+    void BuildRoutesGraph();
+    void BuildRouter(RouterData router_data = {});
+    void BuildAllPairsRouter(graph::AllPairsAlgorithm algorithm, RouterData& router_data);
 
-    void BuildRoutesGraph(const std::deque<catalogue::Bus>& buses);
+    std::vector<graph::VertexId> GetStartVertices(const std::vector<std::string_view>& stops) const;
+    ResponseData MakeResponse(const graph::RouteInfo<Weight>& route) const;
+    ResponseData MakeTransitResponse(const RaptorRouter::Journey& journey) const;
 
 private:  // Fields
     const catalogue::TransportCatalogue& catalogue_;
@@ -116,7 +143,9 @@ private:  // Fields
     /// the bus on the stop.
     /// @example Passenger arrives to stop A and moves to the stop B: A_start -> wait for the bus -> A_end -> B_start
     std::unique_ptr<Graph> routes_{nullptr};
-    std::unique_ptr<Router> router_{nullptr};
+    std::variant<std::unique_ptr<Router>, std::unique_ptr<CompactRouter>, std::unique_ptr<DijkstraRouter>,
+                 std::unique_ptr<ContractionHierarchy>, std::unique_ptr<RaptorRouter>>
+        router_;
 };
 
 using TransportRouterOpt = std::optional<TransportRouter>;
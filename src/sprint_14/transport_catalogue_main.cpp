@@ -1,8 +1,10 @@
 #include <chrono>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 
 #include "src/json_reader.h"
+#include "src/profiler.h"
 #include "src/request_handler.h"
 
 using namespace catalogue;
@@ -22,6 +24,12 @@ int main() {
         auto end = std::chrono::system_clock::now();
         auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
         std::cout << elapsed.count() << "ms." << '\n';
+
+        // Profile is written only on demand into the file, which path is set in the environment variable
+        if (const char* profile_path = std::getenv("TRANSPORT_CATALOGUE_PROFILE")) {
+            std::ofstream profile{profile_path};
+            profiling::Profiler::Instance().DumpJson(profile);
+        }
     } catch (std::exception& e) {
         std::cout << "Exception: " << e.what() << std::endl;
     }
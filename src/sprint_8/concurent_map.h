@@ -4,76 +4,16 @@
 
 #pragma once
 
-#include <algorithm>
-#include <execution>
-#include <future>
+#include <cstdint>
+#include <map>
 #include <mutex>
+#include <thread>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace sprint_8::server {
 
-template <typename ForwardRangeContainer>
-auto CalculateBucketsBoundariesForContainer(ForwardRangeContainer& container, int buckets_count, int bucket_size) {
-    using InteratorType = typename ForwardRangeContainer::iterator;
-
-    std::vector<std::pair<InteratorType, InteratorType>> buckets_boundaries;
-    buckets_boundaries.reserve(buckets_count);
-
-    auto begin = container.begin();
-    auto end = container.begin();
-    for (int page_id = 0; page_id < buckets_count; ++page_id) {
-        end = begin;
-        for (int element_id = 0; element_id < bucket_size; ++element_id) {
-            end = std::next(end);
-            if (end == container.end())
-                break;
-        }
-        buckets_boundaries.emplace_back(std::make_pair(begin, end));
-        begin = end;
-    }
-
-    return buckets_boundaries;
-}
-
-template <class ExecutionPolicy, typename ForwardRangeContainer, typename Function>
-void ForEach(ExecutionPolicy policy, ForwardRangeContainer& container, Function function) {
-    if (container.empty())
-        return;
-
-    using InteratorType = typename ForwardRangeContainer::iterator;
-    using IteratorCategory = typename std::iterator_traits<InteratorType>::iterator_category;
-
-    // Calculates number of buckets & bucket size, depending on processors count
-    // !!! Trick with Container of non-random access iterator - use .size() to get bucket boundaries in one O(n) loop
-    auto calculate_buckets_sizes = [](int container_size) {
-        const auto processor_count = static_cast<int>(std::thread::hardware_concurrency());
-        int bucket_size = container_size > processor_count ? container_size / processor_count : container_size;
-        int buckets_count = container_size / bucket_size;
-        buckets_count += (container_size % bucket_size == 0) ? 0 : 1;
-
-        return std::make_pair(buckets_count, bucket_size);
-    };
-
-    // If ExecutionPolicy is parallel and Container with non-random access iterator - split function between threads
-    if constexpr (std::is_same_v<std::decay_t<ExecutionPolicy>, std::execution::parallel_policy> &&
-                  !std::is_same<IteratorCategory, std::random_access_iterator_tag>::value) {
-        const auto [buckets_count, bucket_size] = calculate_buckets_sizes(container.size());
-
-        std::vector<std::future<void>> futures_vector;
-        futures_vector.reserve(buckets_count);
-        auto buckets_boundaries = CalculateBucketsBoundariesForContainer(container, buckets_count, bucket_size);
-
-        for (const auto& boundary : buckets_boundaries)
-            futures_vector.emplace_back(std::async(
-                [&policy, &boundary, &function] { std::for_each(policy, boundary.first, boundary.second, function); }));
-
-        for (auto& future : futures_vector)
-            future.get();
-    } else
-        std::for_each(policy, container.begin(), container.end(), function);
-}
-
 template <typename Key, typename Value>
 class ConcurrentMap {
 public:  // Types
@@ -108,10 +48,8 @@ public:  // Methods
     std::map<Key, Value> BuildOrdinaryMap() {
         MapType result;
         for (auto& bucket : buckets_) {
-            for (auto& [key, value] : bucket.map_) {
-                std::lock_guard<std::mutex> guard(bucket.mutex_);
-                result[key] = value;
-            }
+            std::lock_guard<std::mutex> guard(bucket.mutex_);
+            result.insert(bucket.map_.begin(), bucket.map_.end());
         }
         return result;
     }
@@ -126,4 +64,194 @@ private:  // Fields
     std::vector<ThreadSafeMap> buckets_;
 };
 
+/*
+ * Concurrent hash map for the integer keys. Keys are distributed between the independent stripes (by the high bits of
+ * the hash), each stripe is an open-addressing table with linear probing, guarded by its own mutex. In comparison with
+ * ConcurrentMap it does not allocate memory per key and keeps the data of the neighbour keys in one cache line.
+ *
+ * Stripes are resized independently, when they become 70% full. Erased elements are removed with the backward shift,
+ * so there are no tombstones and the probing sequences stay short.
+ */
+
+template <typename Key, typename Value>
+class ConcurrentHashMap {
+public:  // Types
+    static_assert(std::is_integral_v<Key>, "ConcurrentHashMap supports only integer keys");
+
+public:  // Constructors
+    explicit ConcurrentHashMap(size_t stripes_count = GetDefaultStripesCount(), size_t expected_size = 0u)
+        : stripe_bits_(GetPowerOfTwoBits(stripes_count)), stripes_(size_t{1} << stripe_bits_) {
+        const size_t stripe_capacity = GetPowerOfTwo(std::max(kMinStripeCapacity, expected_size * 2 / stripes_.size()));
+        for (auto& stripe : stripes_)
+            stripe.slots.resize(stripe_capacity);
+    }
+
+public:  // Methods
+    /// @brief Adds 'delta' to the value of the key (the new key starts with the value-initialized Value)
+    void Accumulate(Key key, const Value& delta) {
+        Update(key, [&delta](Value& value) { value += delta; });
+    }
+
+    /// @brief Calls function(value) for the value of the key under the stripe lock (the key is inserted if needed)
+    template <typename Function>
+    void Update(Key key, Function function) {
+        const uint64_t hash = GetHash(key);
+        auto& stripe = GetStripe(hash);
+
+        std::lock_guard guard(stripe.mutex);
+        function(stripe.FindOrInsert(key, hash));
+    }
+
+    /// @brief Removes the key. Returns true if the key has been found
+    bool Erase(Key key) {
+        const uint64_t hash = GetHash(key);
+        auto& stripe = GetStripe(hash);
+
+        std::lock_guard guard(stripe.mutex);
+        return stripe.Erase(key, hash);
+    }
+
+    [[nodiscard]] size_t Size() const {
+        size_t size{0u};
+        for (auto& stripe : stripes_) {
+            std::lock_guard guard(stripe.mutex);
+            size += stripe.size;
+        }
+        return size;
+    }
+
+    /// @brief Moves all elements out of the map (in unspecified order) and leaves the map empty
+    std::vector<std::pair<Key, Value>> Drain() {
+        std::vector<std::pair<Key, Value>> result;
+        result.reserve(Size());
+
+        for (auto& stripe : stripes_) {
+            std::lock_guard guard(stripe.mutex);
+            for (auto& slot : stripe.slots) {
+                if (slot.is_used)
+                    result.emplace_back(slot.key, std::move(slot.value));
+                slot = {};
+            }
+            stripe.size = 0u;
+        }
+
+        return result;
+    }
+
+private:  // Types
+    struct Slot {
+        Key key{};
+        Value value{};
+        bool is_used{false};
+    };
+
+    struct alignas(64) Stripe {
+        mutable std::mutex mutex;
+        std::vector<Slot> slots;
+        size_t size{0u};
+
+        size_t GetHomeIndex(uint64_t hash) const {
+            return static_cast<size_t>(hash) & (slots.size() - 1);
+        }
+
+        Value& FindOrInsert(Key key, uint64_t hash) {
+            const size_t mask = slots.size() - 1;
+            for (size_t index = GetHomeIndex(hash);; index = (index + 1) & mask) {
+                auto& slot = slots[index];
+                if (slot.is_used && slot.key == key)
+                    return slot.value;
+
+                if (!slot.is_used) {
+                    if ((size + 1) * 10 > slots.size() * 7) {
+                        Grow();
+                        return FindOrInsert(key, hash);
+                    }
+
+                    ++size;
+                    slot.key = key;
+                    slot.is_used = true;
+                    return slot.value;
+                }
+            }
+        }
+
+        bool Erase(Key key, uint64_t hash) {
+            const size_t mask = slots.size() - 1;
+
+            size_t index = GetHomeIndex(hash);
+            for (; slots[index].is_used && slots[index].key != key; index = (index + 1) & mask)
+                continue;
+            if (!slots[index].is_used)
+                return false;
+
+            // Backward shift: move the next elements of the cluster to the hole, if their home is not in (hole, next]
+            for (size_t next = (index + 1) & mask; slots[next].is_used; next = (next + 1) & mask) {
+                const size_t home = GetHomeIndex(GetHash(slots[next].key));
+                const bool is_home_between = (index <= next) ? (index < home && home <= next)
+                                                             : (index < home || home <= next);
+                if (!is_home_between) {
+                    slots[index] = std::move(slots[next]);
+                    index = next;
+                }
+            }
+
+            slots[index] = {};
+            --size;
+            return true;
+        }
+
+        void Grow() {
+            std::vector<Slot> old_slots(slots.size() * 2);
+            std::swap(slots, old_slots);
+
+            const size_t mask = slots.size() - 1;
+            for (auto& old_slot : old_slots) {
+                if (!old_slot.is_used)
+                    continue;
+
+                size_t index = GetHomeIndex(GetHash(old_slot.key));
+                while (slots[index].is_used)
+                    index = (index + 1) & mask;
+                slots[index] = std::move(old_slot);
+            }
+        }
+    };
+
+private:  // Constants
+    static constexpr size_t kMinStripeCapacity{16u};
+
+private:  // Methods
+    static size_t GetDefaultStripesCount() {
+        return 4u * std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    static size_t GetPowerOfTwoBits(size_t value) {
+        size_t bits{0u};
+        while ((size_t{1} << bits) < value)
+            ++bits;
+        return bits;
+    }
+
+    static size_t GetPowerOfTwo(size_t value) {
+        return size_t{1} << GetPowerOfTwoBits(value);
+    }
+
+    /// @brief Integer keys (like document ids) are usually sequential, so they are mixed to fill the table uniformly
+    static uint64_t GetHash(Key key) {
+        auto hash = static_cast<uint64_t>(key);
+        hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+        hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+        return hash ^ (hash >> 31);
+    }
+
+    Stripe& GetStripe(uint64_t hash) {
+        // High bits choose the stripe, low bits - the slot inside the stripe
+        return stripes_[stripe_bits_ == 0 ? 0 : static_cast<size_t>(hash >> (64 - stripe_bits_))];
+    }
+
+private:  // Fields
+    size_t stripe_bits_{0u};
+    std::vector<Stripe> stripes_;
+};
+
 }  // namespace sprint_8::server
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "document.h"
 
+#include <cmath>
 #include <string>
 
 namespace sprint_8::server {
@@ -16,4 +17,11 @@ std::ostream &operator<<(std::ostream &os, const Document &document) {
               << "rating = "s << document.rating << " }"s;
 }
 
+bool IsMoreRelevant(const Document &lhs, const Document &rhs) {
+    static constexpr double kEqualityThreshold{1e-6};
+
+    return std::abs(lhs.relevance - rhs.relevance) < kEqualityThreshold ? lhs.rating > rhs.rating
+                                                                        : lhs.relevance > rhs.relevance;
+}
+
 }  // namespace sprint_8::server
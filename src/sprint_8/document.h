@@ -23,4 +23,8 @@ struct Document {
 
 std::ostream &operator<<(std::ostream &os, const Document &document);
 
+/// @brief Order of documents in search results: by relevance (descending), documents with the same relevance - by
+/// rating (descending)
+bool IsMoreRelevant(const Document &lhs, const Document &rhs);
+
 }  // namespace sprint_8::server
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include "documents_generator.h"
+
+#include <algorithm>
+
+namespace sprint_8::server {
+
+DocumentsGenerator::DocumentsGenerator(std::vector<Document> documents) : documents_(std::move(documents)) {}
+
+const Document& DocumentsGenerator::At(size_t position) const {
+    if (position >= sorted_count_)
+        SortPrefix(position + 1);
+
+    return documents_.at(position);
+}
+
+DocumentsGenerator::Iterator DocumentsGenerator::begin() const {
+    return {this, 0u};
+}
+
+DocumentsGenerator::Iterator DocumentsGenerator::end() const {
+    return {this, documents_.size()};
+}
+
+size_t DocumentsGenerator::size() const {
+    return documents_.size();
+}
+
+bool DocumentsGenerator::empty() const {
+    return documents_.empty();
+}
+
+void DocumentsGenerator::SortPrefix(size_t prefix_size) const {
+    // Sort at least twice more documents than before, so that the sequential iteration costs O(D * log(D)) in total
+    prefix_size = std::min(documents_.size(), std::max({prefix_size, 2 * sorted_count_, kMinSortedChunkSize}));
+    if (prefix_size <= sorted_count_)
+        return;
+
+    const auto chunk_begin = documents_.begin() + static_cast<std::ptrdiff_t>(sorted_count_);
+    const auto chunk_end = documents_.begin() + static_cast<std::ptrdiff_t>(prefix_size);
+
+    // All documents before 'chunk_begin' are more relevant than the rest, so we select the next chunk among the rest
+    std::nth_element(chunk_begin, std::prev(chunk_end), documents_.end(), IsMoreRelevant);
+    std::sort(chunk_begin, chunk_end, IsMoreRelevant);
+
+    sorted_count_ = prefix_size;
+}
+
+}  // namespace sprint_8::server
@@ -0,0 +1,88 @@
+#pragma once
+
+/*
+ * Description: streaming generator of the search results. Documents are ordered lazily: only the prefix, which has
+ * been requested by the caller, is sorted, so the page N of size M costs O(D + (N + 1) * M * log((N + 1) * M)) instead
+ * of O(D * log(D)) for the full sort of D found documents.
+ */
+
+#include <iterator>
+#include <vector>
+
+#include "document.h"
+
+namespace sprint_8::server {
+
+class DocumentsGenerator {
+public:  // Types
+    class Iterator {
+    public:  // Types
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Document;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Document*;
+        using reference = const Document&;
+
+    public:  // Constructor
+        Iterator() = default;
+
+        Iterator(const DocumentsGenerator* generator, size_t position) : generator_(generator), position_(position) {}
+
+    public:  // Methods
+        reference operator*() const {
+            return generator_->At(position_);
+        }
+
+        pointer operator->() const {
+            return &generator_->At(position_);
+        }
+
+        Iterator& operator++() {
+            ++position_;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            auto previous = *this;
+            ++position_;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return generator_ == other.generator_ && position_ == other.position_;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:  // Fields
+        const DocumentsGenerator* generator_{nullptr};
+        size_t position_{0u};
+    };
+
+public:  // Constructor
+    explicit DocumentsGenerator(std::vector<Document> documents);
+
+public:  // Methods
+    /// @brief Returns document on the given position in the order of IsMoreRelevant()
+    [[nodiscard]] const Document& At(size_t position) const;
+
+    [[nodiscard]] Iterator begin() const;
+    [[nodiscard]] Iterator end() const;
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] bool empty() const;
+
+private:  // Constants
+    static constexpr size_t kMinSortedChunkSize{16u};
+
+private:  // Methods
+    void SortPrefix(size_t prefix_size) const;
+
+private:  // Fields
+    // Lazy evaluation: documents in range [0, sorted_count_) are already in their final positions
+    mutable std::vector<Document> documents_;
+    mutable size_t sorted_count_{0u};
+};
+
+}  // namespace sprint_8::server
@@ -21,8 +21,7 @@ public:  // Destructors
 
         const auto end_time = Clock::now();
         const auto duration = end_time - start_time_;
-        out_stream_ << code_block_name_ << ": "s << duration_cast<milliseconds>(duration).count() << " ms"s
-                    << std::endl;
+        out_stream_ << code_block_name_ << ": "s << duration_cast<milliseconds>(duration).count() << " ms\n"s;
     }
 
 private:  // Fields
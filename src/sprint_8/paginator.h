@@ -2,6 +2,8 @@
 
 #include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <type_traits>
 #include <vector>
 
 namespace sprint_8::server::utils {
@@ -21,39 +23,114 @@ std::ostream& operator<<(std::ostream& os, const IteratorsRange<Iterator>& range
     return os;
 }
 
+/// @brief Moves iterator forward on 'steps' elements, but not further than 'end'
+template <class Iterator>
+Iterator AdvanceNoFurther(Iterator position, Iterator end, size_t steps) {
+    using IteratorCategory = typename std::iterator_traits<Iterator>::iterator_category;
+
+    if constexpr (std::is_base_of_v<std::random_access_iterator_tag, IteratorCategory>) {
+        return position + std::min<typename std::iterator_traits<Iterator>::difference_type>(end - position, steps);
+    } else {
+        for (; steps > 0 && position != end; --steps)
+            ++position;
+        return position;
+    }
+}
+
+/*
+ * Lazy paginator: pages are not stored, but computed during the iteration, so it works with any forward iterators
+ * (including the generators, which compute the elements on dereference) and never touches the elements of the pages,
+ * which have not been requested.
+ */
+
 template <class Iterator>
 class Paginator {
+public:  // Types
+    class PageIterator {
+    public:  // Types
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = IteratorsRange<Iterator>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+    public:  // Constructor
+        PageIterator(Iterator page_start, Iterator end, size_t page_size)
+            : page_(page_start, AdvanceNoFurther(page_start, end, page_size)), end_(end), page_size_(page_size) {}
+
+    public:  // Methods
+        reference operator*() const {
+            return page_;
+        }
+
+        pointer operator->() const {
+            return &page_;
+        }
+
+        PageIterator& operator++() {
+            page_ = IteratorsRange<Iterator>(page_.end, AdvanceNoFurther(page_.end, end_, page_size_));
+            return *this;
+        }
+
+        PageIterator operator++(int) {
+            auto previous = *this;
+            ++(*this);
+            return previous;
+        }
+
+        bool operator==(const PageIterator& other) const {
+            return page_.start == other.page_.start;
+        }
+
+        bool operator!=(const PageIterator& other) const {
+            return !(*this == other);
+        }
+
+    private:  // Fields
+        IteratorsRange<Iterator> page_;
+        Iterator end_;
+        size_t page_size_{1u};
+    };
+
 public:  // Constructor
     Paginator() = default;
 
+    Paginator(Iterator begin, Iterator end, int page_size) {
+        Init(begin, end, page_size);
+    }
+
 public:  // Methods
     void Init(Iterator begin, Iterator end, int page_size) {
-        int elements_left{static_cast<int>(std::distance(begin, end))};
-        int elements_fit_page{0};
-
-        while (elements_left > 0) {
-            elements_fit_page = std::min(page_size, elements_left);
-            pages_.emplace_back(begin, begin + elements_fit_page);
-
-            begin += elements_fit_page;
-            elements_left -= elements_fit_page;
-        }
+        begin_ = begin;
+        end_ = end;
+        page_size_ = static_cast<size_t>(std::max(page_size, 1));
     }
 
     auto begin() const {
-        return pages_.begin();
+        return PageIterator(begin_, end_, page_size_);
     }
 
     auto end() const {
-        return pages_.end();
+        return PageIterator(end_, end_, page_size_);
+    }
+
+    /// @brief Returns page with the given index (empty range if there is no such page)
+    /// @details Skips previous pages without dereferencing of their elements
+    IteratorsRange<Iterator> GetPage(size_t page_id) const {
+        const auto page_start = AdvanceNoFurther(begin_, end_, page_id * page_size_);
+        return IteratorsRange<Iterator>(page_start, AdvanceNoFurther(page_start, end_, page_size_));
     }
 
+    /// @brief Number of pages. Takes O(N) time for the non-random access iterators
     size_t size() const {
-        return pages_.size();
+        const auto elements_count = static_cast<size_t>(std::distance(begin_, end_));
+        return (elements_count + page_size_ - 1) / page_size_;
     }
 
 private:  // fields
-    std::vector<IteratorsRange<Iterator>> pages_;
+    Iterator begin_;
+    Iterator end_;
+    size_t page_size_{1u};
 };
 
 template <typename Container>
@@ -64,4 +141,4 @@ auto Paginate(const Container& container, int page_size) {
     return paginator;
 }
 
-}  // namespace sprint_8::server::utils
\ No newline at end of file
+}  // namespace sprint_8::server::utils
@@ -0,0 +1,129 @@
+#pragma once
+
+/*
+ * Description: parallel algorithms on top of the shared ThreadPool. This is the single parallel primitive of the
+ * search server: all loops with the execution policy should go through ForEach / TransformReduce.
+ *
+ * Range is split into chunks in one O(n) pass (even for the forward iterators), then the chunks are processed by the
+ * pool. Two schedules are supported:
+ *  - Static: one chunk per thread, the lowest overhead for the uniform work;
+ *  - Dynamic: many small chunks, which are claimed by the threads on demand, for the non-uniform work.
+ *
+ * With the sequential policy all algorithms are ordinary loops in the calling thread.
+ */
+
+#include <algorithm>
+#include <execution>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "thread_pool.h"
+
+namespace sprint_8::server::utils {
+
+enum class Schedule { Static, Dynamic };
+
+template <class ExecutionPolicy>
+inline constexpr bool kIsParallelPolicy =
+    std::is_same_v<std::decay_t<ExecutionPolicy>, std::execution::parallel_policy> ||
+    std::is_same_v<std::decay_t<ExecutionPolicy>, std::execution::parallel_unsequenced_policy>;
+
+/// @brief Splits range on 'chunks_count' (or less) chunks of almost equal size in one pass
+/// @details For the forward iterators takes O(n) time in total (distance + one pass through the range)
+template <class Iterator>
+std::vector<std::pair<Iterator, Iterator>> SplitIntoChunks(Iterator begin, Iterator end, size_t chunks_count) {
+    const auto elements_count = static_cast<size_t>(std::distance(begin, end));
+    chunks_count = std::max<size_t>(std::min(chunks_count, elements_count), 1u);
+
+    std::vector<std::pair<Iterator, Iterator>> chunks;
+    chunks.reserve(chunks_count);
+
+    // First 'elements_count % chunks_count' chunks have one element more
+    const size_t chunk_size = elements_count / chunks_count;
+    const size_t extended_chunks_count = elements_count % chunks_count;
+
+    for (size_t chunk_id = 0; chunk_id < chunks_count; ++chunk_id) {
+        auto chunk_end = std::next(begin, chunk_size + (chunk_id < extended_chunks_count ? 1 : 0));
+        chunks.emplace_back(begin, chunk_end);
+        begin = chunk_end;
+    }
+
+    return chunks;
+}
+
+/// @brief Number of chunks for the given schedule: dynamic schedule uses several chunks per thread
+inline size_t GetChunksCount(size_t elements_count, Schedule schedule) {
+    static constexpr size_t kDynamicChunksPerThread{8u};
+    static constexpr size_t kMinDynamicChunkSize{16u};
+
+    const size_t threads_count = ThreadPool::Instance().GetThreadsCount();
+    if (schedule == Schedule::Static)
+        return threads_count;
+
+    return std::max<size_t>(std::min(threads_count * kDynamicChunksPerThread, elements_count / kMinDynamicChunkSize),
+                            threads_count);
+}
+
+/// @brief Calls function(element) for each element of the range
+template <class ExecutionPolicy, class Iterator, class Function>
+void ParallelFor(ExecutionPolicy, Iterator begin, Iterator end, Function function,
+                 Schedule schedule = Schedule::Static) {
+    if constexpr (kIsParallelPolicy<ExecutionPolicy>) {
+        if (begin == end)
+            return;
+
+        const size_t elements_count = static_cast<size_t>(std::distance(begin, end));
+        const auto chunks = SplitIntoChunks(begin, end, GetChunksCount(elements_count, schedule));
+
+        ThreadPool::Instance().Run(chunks.size(), [&chunks, &function](size_t chunk_id) {
+            std::for_each(chunks[chunk_id].first, chunks[chunk_id].second, function);
+        });
+    } else {
+        std::for_each(begin, end, function);
+    }
+}
+
+template <class ExecutionPolicy, class Container, class Function>
+void ForEach(ExecutionPolicy policy, Container& container, Function function, Schedule schedule = Schedule::Static) {
+    ParallelFor(policy, container.begin(), container.end(), function, schedule);
+}
+
+/// @brief Returns reduce(init, transform(element_1), ..., transform(element_n))
+/// @details Partial results of the chunks are combined in the order of the chunks, so 'reduce' should be associative,
+/// but not necessarily commutative
+template <class ExecutionPolicy, class Iterator, class Type, class ReduceFunction, class TransformFunction>
+Type TransformReduce(ExecutionPolicy, Iterator begin, Iterator end, Type init, ReduceFunction reduce,
+                     TransformFunction transform, Schedule schedule = Schedule::Static) {
+    if constexpr (kIsParallelPolicy<ExecutionPolicy>) {
+        if (begin == end)
+            return init;
+
+        const size_t elements_count = static_cast<size_t>(std::distance(begin, end));
+        const auto chunks = SplitIntoChunks(begin, end, GetChunksCount(elements_count, schedule));
+
+        // Each chunk starts from its first element, so no identity element for 'reduce' is required. Results are
+        // wrapped into the optional to avoid the packed std::vector<bool>, which can't be written concurrently
+        std::vector<std::optional<Type>> partial_results(chunks.size());
+        ThreadPool::Instance().Run(chunks.size(), [&](size_t chunk_id) {
+            auto [chunk_begin, chunk_end] = chunks[chunk_id];
+
+            Type result = transform(*chunk_begin);
+            for (++chunk_begin; chunk_begin != chunk_end; ++chunk_begin)
+                result = reduce(std::move(result), transform(*chunk_begin));
+            partial_results[chunk_id] = std::move(result);
+        });
+
+        for (auto& partial_result : partial_results)
+            init = reduce(std::move(init), std::move(*partial_result));
+        return init;
+    } else {
+        for (; begin != end; ++begin)
+            init = reduce(std::move(init), transform(*begin));
+        return init;
+    }
+}
+
+}  // namespace sprint_8::server::utils
@@ -5,7 +5,9 @@
 #pragma once
 
 #include <functional>
+#include <numeric>
 
+#include "parallel_for.h"
 #include "search_server.h"
 
 namespace sprint_8::server {
@@ -13,20 +15,28 @@ namespace sprint_8::server {
 std::vector<std::vector<Document>> ProcessQueries(const SearchServer& search_server,
                                                   const std::vector<std::string>& queries) {
     std::vector<std::vector<Document>> responses(queries.size());
-    std::transform(std::execution::par, queries.begin(), queries.end(), responses.begin(),
-                   [&search_server](const std::string& query) { return search_server.FindTopDocuments(query); });
+
+    // Queries have different cost, so they are distributed between the threads dynamically. Parallel algorithms inside
+    // FindTopDocuments() are executed sequentially by the pool workers, so there is no nested parallelism
+    std::vector<size_t> query_ids(queries.size());
+    std::iota(query_ids.begin(), query_ids.end(), 0u);
+    utils::ForEach(
+        std::execution::par, query_ids,
+        [&](size_t query_id) { responses[query_id] = search_server.FindTopDocuments(queries[query_id]); },
+        utils::Schedule::Dynamic);
+
     return responses;
 }
 
 std::vector<Document> ProcessQueriesJoined(const SearchServer& search_server, const std::vector<std::string>& queries) {
     auto responses = ProcessQueries(search_server, queries);
     size_t total_documents_count =
-        std::transform_reduce(std::execution::par, responses.begin(), responses.end(), 0, std::plus<>(),
-                              [](const auto& response) { return response.size(); });
+        utils::TransformReduce(std::execution::par, responses.begin(), responses.end(), size_t{0}, std::plus<>(),
+                               [](const auto& response) { return response.size(); });
 
     std::vector<Document> result;
     result.reserve(total_documents_count);
-    for (auto response : responses)
+    for (auto& response : responses)
         std::move(response.begin(), response.end(), std::back_inserter(result));
 
     return result;
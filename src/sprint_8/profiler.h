@@ -0,0 +1,530 @@
+#pragma once
+
+/*
+ * Description: low-overhead hierarchical profiler, used instead of LogDuration on hot paths.
+ *
+ * Each thread accumulates statistics of its scopes into its own call tree (only the owner thread writes there, so no
+ * locks or read-modify-write atomics are required), statistics of all threads are merged only on dump.
+ * For each call path profiler stores: number of calls, total / min / max time and HDR-style latency histogram.
+ * Results could be dumped to JSON or to the Chrome trace format (chrome://tracing, https://ui.perfetto.dev).
+ *
+ * Usage:
+ *      void Function() {
+ *          PROFILE_SCOPE("Function");
+ *          ...
+ *      }
+ *      Profiler::Instance().DumpJson(std::cout);
+ *
+ * Define PROFILE_DISABLED to remove all measurements from the build.
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace sprint_8::server::utils {
+
+/// @brief HDR-style latency histogram: each power of two range is split into kSubBucketsCount linear buckets, so the
+/// relative error of any percentile is less than 1 / kSubBucketsCount for the whole uint64_t range of values
+class LatencyHistogram {
+public:  // Constants
+    static constexpr int kSubBucketBits{3};
+    static constexpr int kSubBucketsCount{1 << kSubBucketBits};
+    static constexpr int kBucketsCount{(64 - kSubBucketBits + 1) * kSubBucketsCount};
+
+public:  // Methods
+    static int GetBucketId(uint64_t value) {
+        if (value < kSubBucketsCount)
+            return static_cast<int>(value);
+
+        const int shift = GetMostSignificantBit(value) - kSubBucketBits;
+        return (shift + 1) * kSubBucketsCount + static_cast<int>((value >> shift) - kSubBucketsCount);
+    }
+
+    /// @brief Returns the highest value, which falls into the bucket
+    static uint64_t GetBucketUpperBound(int bucket_id) {
+        if (bucket_id < kSubBucketsCount)
+            return static_cast<uint64_t>(bucket_id);
+
+        const int shift = bucket_id / kSubBucketsCount - 1;
+        const uint64_t lower_bound = static_cast<uint64_t>(bucket_id % kSubBucketsCount + kSubBucketsCount) << shift;
+        return lower_bound + ((uint64_t{1} << shift) - 1);
+    }
+
+    void Add(int bucket_id, uint64_t count) {
+        counts_[bucket_id] += count;
+        total_count_ += count;
+    }
+
+    void Record(uint64_t value) {
+        Add(GetBucketId(value), 1);
+    }
+
+    void Merge(const LatencyHistogram& other) {
+        for (int bucket_id = 0; bucket_id < kBucketsCount; ++bucket_id)
+            counts_[bucket_id] += other.counts_[bucket_id];
+        total_count_ += other.total_count_;
+    }
+
+    [[nodiscard]] uint64_t GetTotalCount() const {
+        return total_count_;
+    }
+
+    /// @brief Returns value, which is greater or equal than 'percentile' (in range [0, 100]) of recorded values
+    [[nodiscard]] uint64_t GetValueAtPercentile(double percentile) const {
+        if (total_count_ == 0)
+            return 0;
+
+        const double clamped_percentile = std::clamp(percentile, 0., 100.);
+        const auto required_count =
+            std::max<uint64_t>(1, static_cast<uint64_t>(clamped_percentile / 100. * total_count_ + 0.5));
+
+        uint64_t cumulative_count{0};
+        for (int bucket_id = 0; bucket_id < kBucketsCount; ++bucket_id) {
+            cumulative_count += counts_[bucket_id];
+            if (cumulative_count >= required_count)
+                return GetBucketUpperBound(bucket_id);
+        }
+
+        return GetBucketUpperBound(kBucketsCount - 1);
+    }
+
+private:  // Methods
+    static int GetMostSignificantBit(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(value);
+#else
+        int bit{0};
+        while (value >>= 1)
+            ++bit;
+        return bit;
+#endif
+    }
+
+private:  // Fields
+    std::array<uint64_t, kBucketsCount> counts_{};
+    uint64_t total_count_{0};
+};
+
+/// @brief Per-thread profiling data: call tree of the scopes & trace events (if tracing is enabled)
+/// @details All the methods, except the ones marked as "reader", are called from the owner thread only. Values are
+/// stored in relaxed atomics only to make concurrent dump well-defined, their update costs as a plain store.
+class ThreadProfile {
+public:  // Types
+    using Clock = std::chrono::steady_clock;
+
+    struct ScopeNode {
+        size_t scope_id{0};
+        int parent_id{kRootNodeId};
+
+        std::atomic<uint64_t> calls_count{0};
+        std::atomic<uint64_t> total_time{0};
+        std::atomic<uint64_t> min_time{std::numeric_limits<uint64_t>::max()};
+        std::atomic<uint64_t> max_time{0};
+        std::array<std::atomic<uint64_t>, LatencyHistogram::kBucketsCount> histogram{};
+
+        ScopeNode(size_t scope_id, int parent_id) : scope_id(scope_id), parent_id(parent_id) {}
+    };
+
+    struct TraceEvent {
+        size_t scope_id{0};
+        uint64_t start_time{0};
+        uint64_t duration{0};
+    };
+
+public:  // Constants
+    static constexpr int kRootNodeId{-1};
+    static constexpr int kMaxNodesCount{1024};
+    static constexpr size_t kMaxTraceEventsCount{1u << 16u};
+
+public:  // Constructor
+    explicit ThreadProfile(int thread_id) : thread_id_(thread_id) {}
+
+public:  // Methods
+    /// @brief Moves down the call tree to the child scope, returns its node id (or kRootNodeId if the tree is full)
+    int Enter(size_t scope_id) {
+        const auto& children = GetChildren(current_node_id_);
+        const auto position = std::find_if(children.begin(), children.end(),
+                                           [scope_id](const auto& child) { return child.first == scope_id; });
+
+        const int node_id = position != children.end() ? position->second : AddNode(scope_id);
+        if (node_id != kRootNodeId)
+            current_node_id_ = node_id;
+
+        return node_id;
+    }
+
+    void Leave(int node_id, uint64_t start_time, uint64_t duration, bool is_tracing) {
+        if (node_id == kRootNodeId)
+            return;
+
+        auto& node = *nodes_[node_id].load(std::memory_order_relaxed);
+        Increase(node.calls_count, 1);
+        Increase(node.total_time, duration);
+        Increase(node.histogram[LatencyHistogram::GetBucketId(duration)], 1);
+        if (duration < node.min_time.load(std::memory_order_relaxed))
+            node.min_time.store(duration, std::memory_order_relaxed);
+        if (duration > node.max_time.load(std::memory_order_relaxed))
+            node.max_time.store(duration, std::memory_order_relaxed);
+
+        if (is_tracing)
+            AddTraceEvent({node.scope_id, start_time, duration});
+
+        current_node_id_ = node.parent_id;
+    }
+
+    /* READER METHODS: could be called from any thread */
+
+    [[nodiscard]] int GetThreadId() const {
+        return thread_id_;
+    }
+
+    [[nodiscard]] int GetNodesCount() const {
+        return nodes_count_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] const ScopeNode& GetNode(int node_id) const {
+        return *nodes_[node_id].load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] size_t GetTraceEventsCount() const {
+        return trace_events_count_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] const TraceEvent& GetTraceEvent(size_t event_id) const {
+        return trace_events_.load(std::memory_order_relaxed)[event_id];
+    }
+
+private:  // Methods
+    static void Increase(std::atomic<uint64_t>& value, uint64_t delta) {
+        value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    std::vector<std::pair<size_t, int>>& GetChildren(int node_id) {
+        return node_id == kRootNodeId ? root_children_ : children_[node_id];
+    }
+
+    int AddNode(size_t scope_id) {
+        const int node_id = nodes_count_.load(std::memory_order_relaxed);
+        if (node_id == kMaxNodesCount)
+            return kRootNodeId;
+
+        owned_nodes_.emplace_back(std::make_unique<ScopeNode>(scope_id, current_node_id_));
+        nodes_[node_id].store(owned_nodes_.back().get(), std::memory_order_relaxed);
+        children_.emplace_back();
+        GetChildren(current_node_id_).emplace_back(scope_id, node_id);
+
+        // Publish the node for the readers only when it is completely initialized
+        nodes_count_.store(node_id + 1, std::memory_order_release);
+        return node_id;
+    }
+
+    void AddTraceEvent(const TraceEvent& event) {
+        if (!trace_events_storage_) {
+            trace_events_storage_ = std::make_unique<TraceEvent[]>(kMaxTraceEventsCount);
+            trace_events_.store(trace_events_storage_.get(), std::memory_order_relaxed);
+        }
+
+        const size_t event_id = trace_events_count_.load(std::memory_order_relaxed);
+        if (event_id == kMaxTraceEventsCount)
+            return;
+
+        trace_events_storage_[event_id] = event;
+        trace_events_count_.store(event_id + 1, std::memory_order_release);
+    }
+
+private:  // Fields
+    const int thread_id_{0};
+    int current_node_id_{kRootNodeId};
+
+    // Call tree: node ids are indices in 'nodes_', children lists are used by owner thread only to find the node
+    std::array<std::atomic<ScopeNode*>, kMaxNodesCount> nodes_{};
+    std::atomic<int> nodes_count_{0};
+    std::vector<std::unique_ptr<ScopeNode>> owned_nodes_;
+    std::vector<std::vector<std::pair<size_t, int>>> children_;
+    std::vector<std::pair<size_t, int>> root_children_;
+
+    std::unique_ptr<TraceEvent[]> trace_events_storage_;
+    std::atomic<TraceEvent*> trace_events_{nullptr};
+    std::atomic<size_t> trace_events_count_{0};
+};
+
+/// @brief Registry of the named scopes & per-thread profiles
+class Profiler {
+public:  // Types
+    using Clock = ThreadProfile::Clock;
+
+    /// @brief Statistics of the single call path, merged from all threads (time in nanoseconds)
+    struct ScopeStatistics {
+        std::vector<std::string> path;
+        uint64_t calls_count{0};
+        uint64_t total_time{0};
+        uint64_t self_time{0};
+        uint64_t min_time{std::numeric_limits<uint64_t>::max()};
+        uint64_t max_time{0};
+        LatencyHistogram histogram;
+    };
+
+public:  // Constructors
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    static Profiler& Instance() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+public:  // Methods
+    /// @brief Returns id of the scope with the given name. Called once per call site (see PROFILE_SCOPE)
+    size_t RegisterScope(std::string_view name) {
+        std::lock_guard guard(mutex_);
+
+        if (const auto position = scope_name_to_id_.find(std::string(name)); position != scope_name_to_id_.end())
+            return position->second;
+
+        scope_names_.emplace_back(name);
+        scope_name_to_id_.emplace(scope_names_.back(), scope_names_.size() - 1);
+        return scope_names_.size() - 1;
+    }
+
+    void SetEnabled(bool is_enabled) {
+        is_enabled_.store(is_enabled, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool IsEnabled() const {
+        return is_enabled_.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Enables recording of each scope call for the Chrome trace (limited by the buffer size per thread)
+    void SetTracing(bool is_tracing) {
+        is_tracing_.store(is_tracing, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool IsTracing() const {
+        return is_tracing_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint64_t GetTimeSinceStart(Clock::time_point time) const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time - start_time_).count();
+    }
+
+    ThreadProfile& GetThreadProfile() {
+        thread_local ThreadProfileHolder holder;
+        if (!holder.profile)
+            holder.profile = AcquireThreadProfile();
+        return *holder.profile;
+    }
+
+    /// @brief Merges statistics of all threads, result is ordered as the depth-first traversal of the call tree
+    [[nodiscard]] std::vector<ScopeStatistics> GetStatistics() const {
+        std::lock_guard guard(mutex_);
+
+        std::map<std::vector<std::string>, ScopeStatistics> path_to_statistics;
+        for (const auto& profile : profiles_) {
+            std::vector<std::vector<std::string>> node_paths;
+            node_paths.reserve(profile->GetNodesCount());
+
+            for (int node_id = 0; node_id < profile->GetNodesCount(); ++node_id) {
+                const auto& node = profile->GetNode(node_id);
+                // Parent node is always created before its children
+                auto path = node.parent_id == ThreadProfile::kRootNodeId ? std::vector<std::string>{}
+                                                                          : node_paths[node.parent_id];
+                path.emplace_back(scope_names_[node.scope_id]);
+
+                auto& statistics = path_to_statistics[path];
+                statistics.path = path;
+                statistics.calls_count += node.calls_count.load(std::memory_order_relaxed);
+                statistics.total_time += node.total_time.load(std::memory_order_relaxed);
+                statistics.min_time = std::min(statistics.min_time, node.min_time.load(std::memory_order_relaxed));
+                statistics.max_time = std::max(statistics.max_time, node.max_time.load(std::memory_order_relaxed));
+                for (int bucket_id = 0; bucket_id < LatencyHistogram::kBucketsCount; ++bucket_id) {
+                    if (const uint64_t count = node.histogram[bucket_id].load(std::memory_order_relaxed))
+                        statistics.histogram.Add(bucket_id, count);
+                }
+
+                node_paths.emplace_back(std::move(path));
+            }
+        }
+
+        // Self time is the time spent in the scope itself, excluding the time of the nested scopes
+        for (auto& [path, statistics] : path_to_statistics)
+            statistics.self_time = statistics.total_time;
+        for (const auto& [path, statistics] : path_to_statistics) {
+            if (path.size() < 2)
+                continue;
+            auto& parent = path_to_statistics.at({path.begin(), std::prev(path.end())});
+            parent.self_time -= std::min(parent.self_time, statistics.total_time);
+        }
+
+        std::vector<ScopeStatistics> result;
+        result.reserve(path_to_statistics.size());
+        for (auto& [_, statistics] : path_to_statistics)
+            result.emplace_back(std::move(statistics));
+        return result;
+    }
+
+    /// @brief Prints statistics of all call paths in JSON format (time in nanoseconds)
+    void DumpJson(std::ostream& output) const {
+        output << "{\n    \"scopes\": [";
+
+        bool is_first{true};
+        for (const auto& statistics : GetStatistics()) {
+            output << (is_first ? "\n" : ",\n") << "        {\"path\": \"";
+            for (size_t id = 0; id < statistics.path.size(); ++id)
+                PrintEscaped((id == 0 ? "" : "/") + statistics.path[id], output);
+
+            output << "\", \"depth\": " << statistics.path.size() - 1;
+            output << ", \"calls\": " << statistics.calls_count;
+            output << ", \"total_ns\": " << statistics.total_time;
+            output << ", \"self_ns\": " << statistics.self_time;
+            output << ", \"min_ns\": " << statistics.min_time;
+            output << ", \"max_ns\": " << statistics.max_time;
+            output << ", \"mean_ns\": " << statistics.total_time / std::max<uint64_t>(statistics.calls_count, 1);
+            output << ", \"p50_ns\": " << statistics.histogram.GetValueAtPercentile(50.);
+            output << ", \"p90_ns\": " << statistics.histogram.GetValueAtPercentile(90.);
+            output << ", \"p99_ns\": " << statistics.histogram.GetValueAtPercentile(99.);
+            output << ", \"p999_ns\": " << statistics.histogram.GetValueAtPercentile(99.9) << "}";
+            is_first = false;
+        }
+
+        output << "\n    ]\n}\n";
+    }
+
+    /// @brief Prints recorded trace events in Chrome trace event format (requires SetTracing(true) before the run)
+    void DumpChromeTrace(std::ostream& output) const {
+        std::lock_guard guard(mutex_);
+
+        output << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+
+        bool is_first{true};
+        for (const auto& profile : profiles_) {
+            for (size_t event_id = 0; event_id < profile->GetTraceEventsCount(); ++event_id) {
+                const auto& event = profile->GetTraceEvent(event_id);
+
+                output << (is_first ? "\n" : ",\n") << "{\"name\": \"";
+                PrintEscaped(scope_names_[event.scope_id], output);
+                output << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << profile->GetThreadId();
+                // Chrome trace format expects time in microseconds
+                output << ", \"ts\": " << static_cast<double>(event.start_time) / 1'000.;
+                output << ", \"dur\": " << static_cast<double>(event.duration) / 1'000. << "}";
+                is_first = false;
+            }
+        }
+
+        output << "\n]}\n";
+    }
+
+private:  // Types
+    /// @brief Returns the profile back to the profiler on thread exit, so that short-living threads (std::async) reuse
+    /// the profiles instead of creating the new one each time
+    struct ThreadProfileHolder {
+        ThreadProfile* profile{nullptr};
+
+        ~ThreadProfileHolder() {
+            if (profile)
+                Profiler::Instance().ReleaseThreadProfile(profile);
+        }
+    };
+
+private:  // Constructor
+    Profiler() = default;
+
+private:  // Methods
+    ThreadProfile* AcquireThreadProfile() {
+        std::lock_guard guard(mutex_);
+
+        if (!free_profiles_.empty()) {
+            auto* profile = free_profiles_.back();
+            free_profiles_.pop_back();
+            return profile;
+        }
+
+        profiles_.emplace_back(std::make_unique<ThreadProfile>(static_cast<int>(profiles_.size())));
+        return profiles_.back().get();
+    }
+
+    void ReleaseThreadProfile(ThreadProfile* profile) {
+        std::lock_guard guard(mutex_);
+        free_profiles_.emplace_back(profile);
+    }
+
+    static void PrintEscaped(std::string_view text, std::ostream& output) {
+        for (const char symbol : text) {
+            if (symbol == '"' || symbol == '\\')
+                output.put('\\');
+            output.put(symbol);
+        }
+    }
+
+private:  // Fields
+    const Clock::time_point start_time_{Clock::now()};
+    std::atomic<bool> is_enabled_{true};
+    std::atomic<bool> is_tracing_{false};
+
+    mutable std::mutex mutex_;
+    std::vector<std::string> scope_names_;
+    std::unordered_map<std::string, size_t> scope_name_to_id_;
+    std::vector<std::unique_ptr<ThreadProfile>> profiles_;
+    std::vector<ThreadProfile*> free_profiles_;
+};
+
+/// @brief Measures the time of the scope and stores it in the profile of the current thread
+class ScopedTimer {
+public:  // Constructor
+    explicit ScopedTimer(size_t scope_id) {
+        auto& profiler = Profiler::Instance();
+        if (!profiler.IsEnabled())
+            return;
+
+        profile_ = &profiler.GetThreadProfile();
+        node_id_ = profile_->Enter(scope_id);
+        start_time_ = Profiler::Clock::now();
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+public:  // Destructor
+    ~ScopedTimer() {
+        if (!profile_)
+            return;
+
+        const auto end_time = Profiler::Clock::now();
+        const auto& profiler = Profiler::Instance();
+        const uint64_t start_time = profiler.GetTimeSinceStart(start_time_);
+
+        profile_->Leave(node_id_, start_time, profiler.GetTimeSinceStart(end_time) - start_time,
+                        profiler.IsTracing());
+    }
+
+private:  // Fields
+    ThreadProfile* profile_{nullptr};
+    int node_id_{ThreadProfile::kRootNodeId};
+    Profiler::Clock::time_point start_time_;
+};
+
+}  // namespace sprint_8::server::utils
+
+#define PROFILER_CONCAT_INTERNAL(X, Y) X##Y
+#define PROFILER_CONCAT(X, Y) PROFILER_CONCAT_INTERNAL(X, Y)
+
+#ifdef PROFILE_DISABLED
+#define PROFILE_SCOPE(scope_name)
+#else
+#define PROFILE_SCOPE(scope_name)                                                                                      \
+    static const size_t PROFILER_CONCAT(profileScopeId, __LINE__) =                                                    \
+        sprint_8::server::utils::Profiler::Instance().RegisterScope(scope_name);                                       \
+    sprint_8::server::utils::ScopedTimer PROFILER_CONCAT(profileScopeGuard, __LINE__)(                                 \
+        PROFILER_CONCAT(profileScopeId, __LINE__))
+#endif
@@ -24,6 +24,8 @@ void SearchServer::SetStopWords(std::string_view text) {
 
 void SearchServer::AddDocument(int document_id, std::string_view document, DocumentStatus status,
                                const std::vector<int> &ratings) {
+    PROFILE_SCOPE("SearchServer::AddDocument");
+
     if (const auto &error_message = CheckDocumentInput(document_id, document);
         error_message && !error_message->empty()) {
         throw std::invalid_argument(*error_message);
@@ -52,11 +54,24 @@ std::vector<Document> SearchServer::FindTopDocuments(std::string_view raw_query,
     // clang-format on
 }
 
+DocumentsGenerator SearchServer::FindDocumentsGenerator(std::string_view raw_query,
+                                                       DocumentStatus document_status) const {
+    // clang-format off
+    return FindDocumentsGenerator(std::execution::par, raw_query,
+                                  [document_status](
+                                      [[maybe_unused]] int document_id, DocumentStatus status, [[maybe_unused]] int rating) {
+                                      return status == document_status;
+                                  });
+    // clang-format on
+}
+
 int SearchServer::GetDocumentCount() const {
     return static_cast<int>(documents_.size());
 }
 
 SearchServer::WordsInDocumentInfo SearchServer::MatchDocument(std::string_view raw_query, int document_id) const {
+    PROFILE_SCOPE("SearchServer::MatchDocument");
+
     const Query query = ParseQuery(raw_query);
     std::vector<std::string_view> matched_words;
     matched_words.reserve(query.plus_words.size() + query.minus_words.size());
@@ -126,6 +141,8 @@ bool SearchServer::ParseQueryWord(std::string_view word, QueryWord &query_word)
 }
 
 SearchServer::Query SearchServer::ParseQuery(std::string_view query_text) const {
+    PROFILE_SCOPE("SearchServer::ParseQuery");
+
     Query query;
 
     for (std::string_view word : SplitIntoWords(query_text)) {
@@ -192,6 +209,8 @@ const std::map<std::string_view, double> &SearchServer::GetWordFrequencies(Docum
 }
 
 void SearchServer::RemoveDocument(DocumentId index) {
+    PROFILE_SCOPE("SearchServer::RemoveDocument");
+
     auto document_position = document_ids_.find(index);
     if (document_position == document_ids_.end())
         return;
@@ -207,6 +226,8 @@ void SearchServer::RemoveDocument(DocumentId index) {
 }
 
 void RemoveDuplicates(SearchServer &search_server) {
+    PROFILE_SCOPE("RemoveDuplicates");
+
     std::map<std::set<Word>, DocumentId> storage;
     std::vector<DocumentId> indices_for_removal;
 
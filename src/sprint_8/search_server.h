@@ -11,6 +11,9 @@
 
 #include "concurent_map.h"
 #include "document.h"
+#include "documents_generator.h"
+#include "parallel_for.h"
+#include "profiler.h"
 #include "string_processing.h"
 
 namespace sprint_8::server {
@@ -38,18 +41,17 @@ public:  // Public methods
     std::vector<Document> FindTopDocuments(ExecutionPolicy policy, std::string_view raw_query,
                                            DocumentFilterFunction filter_function) const {
         using namespace std::execution;
+        PROFILE_SCOPE("SearchServer::FindTopDocuments");
 
         const Query query = ParseQuery(raw_query);
         auto matched_documents = FindAllDocuments(policy, query, filter_function);
 
-        std::sort(
-            policy, matched_documents.begin(), matched_documents.end(), [](const Document &lhs, const Document &rhs) {
-                return std::abs(lhs.relevance - rhs.relevance) < kEqualityThreshold ? lhs.rating > rhs.rating
-                                                                                    : lhs.relevance > rhs.relevance;
-            });
-
-        if (matched_documents.size() > static_cast<size_t>(kMaxDocumentsCount))
-            matched_documents.resize(static_cast<size_t>(kMaxDocumentsCount));
+        // Only the top documents are ordered, the rest are just dropped. Selection of a few top documents is one pass
+        // through the documents, so it is sequential for any policy
+        const auto top_count = std::min(matched_documents.size(), static_cast<size_t>(kMaxDocumentsCount));
+        std::partial_sort(matched_documents.begin(), matched_documents.begin() + top_count, matched_documents.end(),
+                          IsMoreRelevant);
+        matched_documents.resize(top_count);
 
         return matched_documents;
     }
@@ -73,6 +75,20 @@ public:  // Public methods
     [[nodiscard]] std::vector<Document> FindTopDocuments(std::string_view raw_query,
                                                          DocumentStatus document_status = DocumentStatus::ACTUAL) const;
 
+    /// @brief Returns all found documents, which are ordered lazily on the iteration (see DocumentsGenerator)
+    /// @details Use it with Paginator to get the pages beyond the top documents without the full sort
+    template <class ExecutionPolicy, class DocumentFilterFunction>
+    DocumentsGenerator FindDocumentsGenerator(ExecutionPolicy policy, std::string_view raw_query,
+                                              DocumentFilterFunction filter_function) const {
+        PROFILE_SCOPE("SearchServer::FindDocumentsGenerator");
+
+        const Query query = ParseQuery(raw_query);
+        return DocumentsGenerator(FindAllDocuments(policy, query, filter_function));
+    }
+
+    [[nodiscard]] DocumentsGenerator FindDocumentsGenerator(
+        std::string_view raw_query, DocumentStatus document_status = DocumentStatus::ACTUAL) const;
+
     [[nodiscard]] int GetDocumentCount() const;
 
     void SetStopWords(std::string_view text);
@@ -86,6 +102,7 @@ public:  // Public methods
     [[nodiscard]] WordsInDocumentInfo MatchDocument(ExecutionPolicy policy, std::string_view raw_query,
                                                     int document_id) const {
         using namespace std::execution;
+        PROFILE_SCOPE("SearchServer::MatchDocument");
 
         const auto word_checker = [this, document_id](std::string_view word) {
             const auto position = word_to_document_frequency_.find(word);
@@ -97,20 +114,20 @@ public:  // Public methods
         std::vector<std::string_view> matched_words(plus_words.size());
 
         std::atomic<int> current_size{0};
-        std::for_each(policy, plus_words.begin(), plus_words.end(),
-                      [this, document_id, &matched_words, &current_size, &word_checker](std::string_view word) {
-                          if (word_checker(word))
-                              matched_words[current_size++] = word;
-                      });
+        utils::ForEach(policy, plus_words, [&matched_words, &current_size, &word_checker](std::string_view word) {
+            if (word_checker(word))
+                matched_words[current_size++] = word;
+        });
 
-        // Remove duplicates
-        std::sort(policy, matched_words.begin(), matched_words.end());
-        matched_words.erase(std::unique(policy, matched_words.begin(), matched_words.end()), matched_words.end());
+        // Plus words are unique, but the threads write them in any order: restore the order of the query words
+        matched_words.resize(current_size);
+        std::sort(matched_words.begin(), matched_words.end());
 
         // clang-format off
         const auto &minus_words = query.minus_words;
-        if (std::any_of(policy, minus_words.begin(), minus_words.end(), word_checker))
-            return {{}, documents_.at(document_id).status};
+        // Query has a few minus words, so the sequential check, which stops on the first match, is the fastest
+        if (std::any_of(minus_words.begin(), minus_words.end(), word_checker))
+            return {std::vector<std::string_view>{}, documents_.at(document_id).status};
 
         return {matched_words, documents_.at(document_id).status};
     }
@@ -122,6 +139,7 @@ public:  // Public methods
     template <class ExecutionPolicy>
     void RemoveDocument(ExecutionPolicy policy, DocumentId index) {
         using namespace std::execution;
+        PROFILE_SCOPE("SearchServer::RemoveDocument");
 
         auto document_position = document_ids_.find(index);
         if (document_position == document_ids_.end())
@@ -129,7 +147,7 @@ public:  // Public methods
         document_ids_.erase(document_position);
 
         auto &words_in_document = words_frequency_by_documents_.at(index);
-        std::for_each(policy, words_in_document.begin(), words_in_document.end(), [this, index](const auto &pair) {
+        utils::ForEach(policy, words_in_document, [this, index](const auto &pair) {
             auto position = word_to_document_frequency_.find(pair.first);
             position->second.erase(index);
         });
@@ -168,7 +186,6 @@ private:  // Types
     };
 
 private:  // Constants
-    static constexpr double kEqualityThreshold{1e-6};
     static constexpr int kMaxDocumentsCount{5};
 
 private:  // Class methods
@@ -177,9 +194,9 @@ private:  // Class methods
                                            DocumentFilterFunction filter_function) const {
         using namespace sprint_8::server::utils;
         using namespace std::execution;
+        PROFILE_SCOPE("SearchServer::FindAllDocuments");
 
-        const auto processor_count = static_cast<int>(std::thread::hardware_concurrency());
-        ConcurrentMap<int, double> document_relevancy(processor_count);
+        ConcurrentHashMap<int, double> document_relevancy;
 
         // Multi-threading approach to insert plus words
         auto insert_frequencies = [this, &filter_function, &document_relevancy](std::string_view word) {
@@ -188,33 +205,32 @@ private:  // Class methods
             if (word_position != word_to_document_frequency_.cend()) {
                 const double inverse_document_freq = ComputeWordInverseDocumentFrequency(word);
 
-                for (const auto [document_id, term_freq] : word_position->second) {
+                for (const auto &[document_id, term_freq] : word_position->second) {
                     const auto &[rating, status] = documents_.at(document_id);
                     if (filter_function(document_id, status, rating))
-                        document_relevancy[document_id].ref_to_value += term_freq * inverse_document_freq;
+                        document_relevancy.Accumulate(document_id, term_freq * inverse_document_freq);
                 }
             }
         };
         auto &plus_words = query.plus_words;
-        ForEach(policy, plus_words, insert_frequencies);
+        ForEach(policy, plus_words, insert_frequencies, Schedule::Dynamic);
 
         // Multithreading approach to erase minus words
         auto erase_minus_words = [this, &document_relevancy](std::string_view word) {
             const auto word_position = word_to_document_frequency_.find(word);
             if (word_position != word_to_document_frequency_.cend()) {
-                for (const auto [document_id, _] : word_position->second)
+                for (const auto &[document_id, _] : word_position->second)
                     document_relevancy.Erase(document_id);
             }
         };
         auto &minus_words = query.minus_words;
-        ForEach(policy, minus_words, erase_minus_words);
+        ForEach(policy, minus_words, erase_minus_words, Schedule::Dynamic);
 
-        // Move ConcurrentMap<k,v> to std::map<k,v>
-        auto document_to_relevance = document_relevancy.BuildOrdinaryMap();
+        auto document_to_relevance = document_relevancy.Drain();
 
         std::vector<Document> matched_documents;
         matched_documents.reserve(document_to_relevance.size());
-        for (const auto [document_id, relevance] : document_to_relevance)
+        for (const auto &[document_id, relevance] : document_to_relevance)
             matched_documents.emplace_back(document_id, relevance, documents_.at(document_id).rating);
 
         return matched_documents;
@@ -222,6 +238,8 @@ private:  // Class methods
 
     template <class DocumentFilterFunction>
     std::vector<Document> FindAllDocuments(const Query &query, DocumentFilterFunction filter_function) const {
+        PROFILE_SCOPE("SearchServer::FindAllDocuments");
+
         std::map<int, double> document_to_relevance;
         for (std::string_view word : query.plus_words) {
             const auto word_position = word_to_document_frequency_.find(word);
@@ -229,7 +247,7 @@ private:  // Class methods
                 continue;
 
             const double inverse_document_freq = ComputeWordInverseDocumentFrequency(word);
-            for (const auto [document_id, term_freq] : word_position->second) {
+            for (const auto &[document_id, term_freq] : word_position->second) {
                 const auto &[rating, status] = documents_.at(document_id);
                 if (filter_function(document_id, status, rating))
                     document_to_relevance[document_id] += term_freq * inverse_document_freq;
@@ -241,13 +259,13 @@ private:  // Class methods
             if (word_position == word_to_document_frequency_.cend())
                 continue;
 
-            for (const auto [document_id, _] : word_position->second)
+            for (const auto &[document_id, _] : word_position->second)
                 document_to_relevance.erase(document_id);
         }
 
         std::vector<Document> matched_documents;
         matched_documents.reserve(document_to_relevance.size());
-        for (const auto [document_id, relevance] : document_to_relevance)
+        for (const auto &[document_id, relevance] : document_to_relevance)
             matched_documents.emplace_back(document_id, relevance, documents_.at(document_id).rating);
 
         return matched_documents;
@@ -263,42 +281,10 @@ private:  // Class methods
 
     [[nodiscard]] Query ParseQuery(std::string_view query_text) const;
 
+    /// @brief Query has a few words, so it is parsed sequentially for any policy
     template <class ExecutionPolicy>
-    [[maybe_unused]] [[nodiscard]] Query ParseQuery(ExecutionPolicy policy, std::string_view query_text) const {
-        using namespace std::literals;
-        using namespace std::execution;
-        using namespace sprint_8::server::utils;
-
-        Query query;
-        std::vector<std::string_view> words = SplitIntoWords(query_text);
-
-        // Convert all words to the query-words
-        std::vector<std::pair<bool, QueryWord>> query_words(words.size());
-        std::transform(policy, words.begin(), words.end(), query_words.begin(), [this](std::string_view word) {
-            QueryWord query_word;
-            return std::make_pair(ParseQueryWord(word, query_word), query_word);
-        });
-
-        // Check that at least one word is invalid
-        auto invalid_word_position = std::find_if(policy, query_words.cbegin(), query_words.cend(),
-                                                  [](const std::pair<bool, QueryWord> &pair) { return !pair.first; });
-        if (invalid_word_position != query_words.cend())
-            throw std::invalid_argument("Invalid word in the query: "s +
-                                        std::string(invalid_word_position->second.data));
-
-        // Move words from the storage to the appropriate category <plus / minus>
-        for (auto [_, query_word] : query_words) {
-            if (!query_word.is_stop) {
-                if (query_word.is_minus) {
-                    query.minus_words.insert(query_word.data);
-                }
-                else {
-                    query.plus_words.insert(query_word.data);
-                }
-            }
-        }
-
-        return query;
+    [[maybe_unused]] [[nodiscard]] Query ParseQuery(ExecutionPolicy, std::string_view query_text) const {
+        return ParseQuery(query_text);
     }
 
     [[nodiscard]] double ComputeWordInverseDocumentFrequency(std::string_view word) const;
@@ -0,0 +1,171 @@
+#pragma once
+
+/*
+ * Description: shared pool of the worker threads, used by the parallel algorithms (see parallel_for.h). The pool
+ * executes "jobs": job consists of N independent tasks, which are claimed by the workers (and by the calling thread)
+ * one by one through the atomic counter, so the faster threads take more tasks (dynamic load balancing).
+ *
+ * Nested parallelism is forbidden: if the job is submitted from the worker thread, it is executed sequentially by this
+ * worker, which prevents both the deadlock and the oversubscription.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sprint_8::server::utils {
+
+class ThreadPool {
+public:  // Types
+    using Task = std::function<void(size_t)>;
+
+public:  // Constructors
+    explicit ThreadPool(size_t workers_count) {
+        workers_.reserve(workers_count);
+        for (size_t worker_id = 0; worker_id < workers_count; ++worker_id)
+            workers_.emplace_back([this] { WorkerLoop(); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard guard(mutex_);
+            is_stopped_ = true;
+        }
+        has_jobs_.notify_all();
+
+        for (auto& worker : workers_)
+            worker.join();
+    }
+
+public:  // Methods
+    /// @brief Shared pool: the calling thread also executes tasks, so it has one worker less than the hardware threads
+    static ThreadPool& Instance() {
+        static ThreadPool pool(std::max(std::thread::hardware_concurrency(), 1u) - 1u);
+        return pool;
+    }
+
+    /// @brief Number of threads, which could execute the tasks of one job (workers + calling thread)
+    [[nodiscard]] size_t GetThreadsCount() const {
+        return workers_.size() + 1u;
+    }
+
+    /// @brief Executes task(task_id) for each task_id in range [0, tasks_count) and waits for the completion
+    /// @details Rethrows the exception, thrown by one of the tasks
+    void Run(size_t tasks_count, const Task& task) {
+        if (tasks_count == 0)
+            return;
+
+        if (tasks_count == 1 || workers_.empty() || IsWorkerThread()) {
+            for (size_t task_id = 0; task_id < tasks_count; ++task_id)
+                task(task_id);
+            return;
+        }
+
+        auto job = std::make_shared<Job>(task, tasks_count);
+        {
+            std::lock_guard guard(mutex_);
+            jobs_.push_back(job);
+        }
+        has_jobs_.notify_all();
+
+        Execute(*job);
+
+        std::unique_lock lock(job->mutex);
+        job->is_finished.wait(lock, [&job] { return job->done_count == job->tasks_count; });
+
+        if (job->exception)
+            std::rethrow_exception(job->exception);
+    }
+
+private:  // Types
+    struct Job {
+        const Task& task;
+        const size_t tasks_count{0u};
+        std::atomic<size_t> next_task_id{0u};
+
+        // Completion is tracked under the mutex to make the notification reliable
+        std::mutex mutex;
+        std::condition_variable is_finished;
+        size_t done_count{0u};
+        std::exception_ptr exception;
+
+        Job(const Task& job_task, size_t count) : task(job_task), tasks_count(count) {}
+    };
+
+private:  // Methods
+    static bool& IsWorkerThread() {
+        static thread_local bool is_worker{false};
+        return is_worker;
+    }
+
+    void WorkerLoop() {
+        IsWorkerThread() = true;
+
+        while (true) {
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock lock(mutex_);
+                has_jobs_.wait(lock, [this] { return is_stopped_ || !jobs_.empty(); });
+                if (is_stopped_)
+                    return;
+
+                job = jobs_.front();
+            }
+
+            Execute(*job);
+
+            // All tasks of the job are claimed: remove it from the queue (if nobody has done it yet)
+            std::lock_guard guard(mutex_);
+            if (!jobs_.empty() && jobs_.front() == job)
+                jobs_.pop_front();
+        }
+    }
+
+    static void Execute(Job& job) {
+        size_t executed_count{0u};
+        std::exception_ptr exception;
+
+        for (size_t task_id = job.next_task_id++; task_id < job.tasks_count; task_id = job.next_task_id++) {
+            ++executed_count;
+            if (exception)
+                continue;
+
+            try {
+                job.task(task_id);
+            } catch (...) {
+                exception = std::current_exception();
+            }
+        }
+
+        if (executed_count == 0)
+            return;
+
+        std::lock_guard guard(job.mutex);
+        if (exception && !job.exception)
+            job.exception = exception;
+
+        job.done_count += executed_count;
+        if (job.done_count == job.tasks_count)
+            job.is_finished.notify_all();
+    }
+
+private:  // Fields
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable has_jobs_;
+    std::deque<std::shared_ptr<Job>> jobs_;
+    bool is_stopped_{false};
+};
+
+}  // namespace sprint_8::server::utils
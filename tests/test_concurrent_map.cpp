@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <execution>
+#include <map>
+#include <numeric>
+#include <vector>
+
+#include "../src/sprint_8/concurent_map.h"
+#include "../src/sprint_8/parallel_for.h"
+
+using namespace sprint_8::server;
+using namespace std::literals;
+
+TEST(ConcurrentHashMapClass, AccumulateEraseAndDrain) {
+    ConcurrentHashMap<int, int> map(2);
+    std::map<int, int> expected;
+
+    // Enough keys to resize stripes several times
+    for (int key = -500; key < 500; ++key) {
+        map.Accumulate(key, key);
+        map.Accumulate(key, 1);
+        expected[key] = key + 1;
+    }
+    EXPECT_EQ(map.Size(), expected.size()) << "Map should contain each accumulated key once"s;
+
+    for (int key = -500; key < 500; key += 3) {
+        EXPECT_TRUE(map.Erase(key)) << "Existed key should be erased"s;
+        expected.erase(key);
+    }
+    EXPECT_FALSE(map.Erase(100'000)) << "Missing key could not be erased"s;
+
+    auto drained = map.Drain();
+    std::sort(drained.begin(), drained.end());
+    const std::vector<std::pair<int, int>> expected_items(expected.begin(), expected.end());
+    EXPECT_EQ(drained, expected_items)
+        << "Map should keep the rest keys with accumulated values after erasing"s;
+    EXPECT_EQ(map.Size(), 0u) << "Map should be empty after drain"s;
+
+    map.Accumulate(7, 3);
+    EXPECT_EQ(map.Drain(), (std::vector<std::pair<int, int>>{{7, 3}})) << "Map should be reusable after drain"s;
+}
+
+TEST(ConcurrentHashMapClass, ParallelAccumulate) {
+    constexpr int kKeysCount{1'000};
+    constexpr int kRepeatsCount{20};
+
+    std::vector<int> keys(kKeysCount * kRepeatsCount);
+    for (size_t id = 0; id < keys.size(); ++id)
+        keys[id] = static_cast<int>(id % kKeysCount);
+
+    ConcurrentHashMap<int, long> map;
+    utils::ForEach(std::execution::par, keys, [&map](int key) { map.Accumulate(key, 1); }, utils::Schedule::Dynamic);
+
+    const auto drained = map.Drain();
+    EXPECT_EQ(drained.size(), static_cast<size_t>(kKeysCount)) << "Each key should be inserted once"s;
+    EXPECT_TRUE(std::all_of(drained.begin(), drained.end(), [](const auto& item) { return item.second == kRepeatsCount; }))
+        << "Parallel accumulation should not lose updates"s;
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/sprint_14/src/contraction_hierarchy.h"
+#include "../src/sprint_14/src/dijkstra_router.h"
+#include "../src/sprint_14/src/graph.h"
+
+using namespace graph;
+using namespace std::literals;
+
+namespace {
+
+using Graph = DirectedWeightedGraph<double>;
+
+Graph MakeGraph(size_t vertex_count, const std::vector<Edge<double>>& edges) {
+    Graph graph(vertex_count);
+    for (const auto& edge : edges)
+        graph.AddEdge(edge);
+    graph.Freeze();
+    return graph;
+}
+
+/// @brief Graph with small integer weights, so many paths have equal weights
+Graph MakeRandomGraph(std::mt19937& generator) {
+    const size_t vertex_count = std::uniform_int_distribution<size_t>(2, 30)(generator);
+    const size_t edge_count = std::uniform_int_distribution<size_t>(0, 3 * vertex_count)(generator);
+    std::uniform_int_distribution<size_t> vertex(0, vertex_count - 1);
+    std::uniform_int_distribution<int> weight(0, 3);
+
+    std::vector<Edge<double>> edges;
+    for (size_t index = 0; index < edge_count; ++index)
+        edges.push_back({vertex(generator), vertex(generator), static_cast<double>(weight(generator))});
+    return MakeGraph(vertex_count, edges);
+}
+
+/// @brief Checks, that the route of the hierarchy is the same as of Dijkstra and consists of the graph edges
+void ExpectSameRoute(const Graph& graph, const ContractionHierarchy<double>& hierarchy,
+                     const DijkstraRouter<double>& dijkstra, VertexId from, VertexId to) {
+    const auto route = hierarchy.BuildRoute(from, to);
+    const auto expected_route = dijkstra.BuildRoute(from, to);
+
+    ASSERT_EQ(route.has_value(), expected_route.has_value())
+        << "Route "s << from << " -> "s << to << " should be found by both routers"s;
+    if (!route)
+        return;
+
+    EXPECT_DOUBLE_EQ(route->weight, expected_route->weight) << "Route "s << from << " -> "s << to;
+
+    VertexId current = from;
+    double weight = 0.;
+    for (EdgeId edge_id : route->edges) {
+        const auto& edge = graph.GetEdge(edge_id);
+        ASSERT_EQ(edge.from, current) << "Route edges should be unpacked to the connected path"s;
+        current = edge.to;
+        weight += edge.weight;
+    }
+    EXPECT_EQ(current, to) << "Route should end at the target vertex"s;
+    EXPECT_DOUBLE_EQ(weight, route->weight) << "Route weight should be the sum of its edges"s;
+}
+
+}  // namespace
+
+TEST(ContractionHierarchy, KeepsShortcutsOfVerticesWithEqualNeighbours) {
+    // Vertices 1 and 2 are contracted in the same round and each of them is the equal-weight witness of the other
+    const auto graph = MakeGraph(6, {{0, 1, 1.}, {1, 3, 1.}, {0, 2, 1.}, {2, 3, 1.}, {4, 0, 1.}, {3, 5, 1.}});
+    const ContractionHierarchy<double> hierarchy(graph);
+    const DijkstraRouter<double> dijkstra(graph);
+
+    for (VertexId from = 0; from < graph.GetVertexCount(); ++from) {
+        for (VertexId to = 0; to < graph.GetVertexCount(); ++to)
+            ExpectSameRoute(graph, hierarchy, dijkstra, from, to);
+    }
+
+    const auto route = hierarchy.BuildRoute(4, 5);
+    ASSERT_TRUE(route.has_value()) << "Route 4 -> 5 exists in the graph"s;
+    EXPECT_DOUBLE_EQ(route->weight, 4.);
+}
+
+TEST(ContractionHierarchy, RoutesAreTheSameAsDijkstraOnRandomGraphs) {
+    std::mt19937 generator(42u);
+
+    for (int graph_id = 0; graph_id < 200; ++graph_id) {
+        const auto graph = MakeRandomGraph(generator);
+        const ContractionHierarchy<double> hierarchy(graph);
+        const DijkstraRouter<double> dijkstra(graph);
+
+        for (VertexId from = 0; from < graph.GetVertexCount(); ++from) {
+            for (VertexId to = 0; to < graph.GetVertexCount(); ++to)
+                ExpectSameRoute(graph, hierarchy, dijkstra, from, to);
+        }
+    }
+}
+
+TEST(ContractionHierarchy, WeightsMatrixIsTheSameAsDijkstraOnRandomGraphs) {
+    std::mt19937 generator(7u);
+
+    for (int graph_id = 0; graph_id < 200; ++graph_id) {
+        const auto graph = MakeRandomGraph(generator);
+        const ContractionHierarchy<double> hierarchy(graph);
+        const DijkstraRouter<double> dijkstra(graph);
+
+        std::vector<VertexId> vertices(graph.GetVertexCount());
+        for (VertexId vertex = 0; vertex < vertices.size(); ++vertex)
+            vertices[vertex] = vertex;
+
+        const auto weights = hierarchy.BuildWeightsMatrix(vertices, vertices);
+        ASSERT_EQ(weights.size(), vertices.size() * vertices.size());
+
+        for (VertexId from = 0; from < vertices.size(); ++from) {
+            for (VertexId to = 0; to < vertices.size(); ++to) {
+                const auto& weight = weights[from * vertices.size() + to];
+                const auto expected_route = dijkstra.BuildRoute(from, to);
+
+                ASSERT_EQ(weight.has_value(), expected_route.has_value())
+                    << "Route "s << from << " -> "s << to << " should be found by both routers"s;
+                if (weight) {
+                    EXPECT_DOUBLE_EQ(*weight, expected_route->weight) << "Route "s << from << " -> "s << to;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "../src/sprint_14/src/distance_table.h"
+
+using namespace catalogue;
+using namespace std::literals;
+
+TEST(DistanceTable, DistancesInBothDirectionsAreDifferent) {
+    DistanceTable table;
+    table.Add(1, 2, 100);
+    table.Add(2, 1, 250);
+
+    EXPECT_EQ(table.Get(1, 2), 100);
+    EXPECT_EQ(table.Get(2, 1), 250) << "Explicit distance of the reverse direction should be used"s;
+}
+
+TEST(DistanceTable, MissingDistanceIsTakenFromReverseDirection) {
+    DistanceTable table;
+    table.Add(3, 7, 1200);
+
+    EXPECT_EQ(table.Get(7, 3), 1200) << "Distance 'to' -> 'from' should be equal to 'from' -> 'to'"s;
+
+    // Explicit distance of the reverse direction replaces the one taken from the forward direction
+    table.Add(7, 3, 900);
+    EXPECT_EQ(table.Get(7, 3), 900);
+    EXPECT_EQ(table.Get(3, 7), 1200) << "Forward distance should not be changed by the reverse one"s;
+}
+
+TEST(DistanceTable, ExplicitDistanceIsNotOverwritten) {
+    DistanceTable table;
+    table.Add(1, 2, 100);
+    table.Add(1, 2, 500);
+    table.Add(2, 1, 300);
+    table.Add(1, 2, 700);
+
+    EXPECT_EQ(table.Get(1, 2), 100) << "The first explicit distance should be used"s;
+    EXPECT_EQ(table.Get(2, 1), 300);
+}
+
+TEST(DistanceTable, DistanceFromStopToItself) {
+    DistanceTable table;
+    table.Add(5, 5, 40);
+
+    EXPECT_EQ(table.Get(5, 5), 40);
+    EXPECT_EQ(table.GetSize(), 1u);
+}
+
+TEST(DistanceTable, ThrowsOnMissingDistance) {
+    DistanceTable table;
+    EXPECT_THROW((void)table.Get(0, 1), std::out_of_range) << "Empty table has no distances"s;
+
+    table.Add(0, 1, 10);
+    EXPECT_THROW((void)table.Get(0, 2), std::out_of_range);
+    EXPECT_THROW((void)table.Get(2, 1), std::out_of_range);
+}
+
+TEST(DistanceTable, GrowsAndKeepsAllDistancesOnRehash) {
+    // Random pairs of the stops with the random order of the directions, checked against std::map
+    std::mt19937 generator(42u);
+    std::uniform_int_distribution<StopId> stop(0, 3000);
+    std::uniform_int_distribution<int> distance(1, 100'000);
+
+    DistanceTable table;
+    std::map<std::pair<StopId, StopId>, int> explicit_distances;
+    std::map<std::pair<StopId, StopId>, int> expected;
+
+    for (int index = 0; index < 20'000; ++index) {
+        const StopId from = stop(generator);
+        const StopId to = stop(generator);
+        const int value = distance(generator);
+        table.Add(from, to, value);
+
+        if (explicit_distances.emplace(std::make_pair(from, to), value).second) {
+            expected[{from, to}] = value;
+            if (explicit_distances.count({to, from}) == 0)
+                expected[{to, from}] = value;
+        }
+
+        // Lookups are checked during the growth as well, so each rehash is covered
+        if (index % 1000 == 0) {
+            for (const auto& [stops, expected_distance] : expected)
+                ASSERT_EQ(table.Get(stops.first, stops.second), expected_distance) << "Broken after "s << index;
+        }
+    }
+
+    EXPECT_EQ(table.GetSize(), expected.size());
+    for (const auto& [stops, expected_distance] : expected)
+        EXPECT_EQ(table.Get(stops.first, stops.second), expected_distance);
+}
+
+TEST(DistanceTable, IteratesOverExplicitDistancesOnly) {
+    DistanceTable table;
+    table.Add(1, 2, 100);
+    table.Add(2, 3, 200);
+    table.Add(3, 2, 300);
+    table.Add(4000000000u, 0, 400);
+
+    std::map<std::pair<StopId, StopId>, int> distances;
+    table.ForEachExplicit([&distances](StopId from, StopId to, int distance) { distances[{from, to}] = distance; });
+
+    const std::map<std::pair<StopId, StopId>, int> expected{
+        {{1, 2}, 100}, {{2, 3}, 200}, {{3, 2}, 300}, {{4000000000u, 0}, 400}};
+    EXPECT_EQ(distances, expected) << "Distances taken from the reverse direction should not be iterated"s;
+}
@@ -0,0 +1,290 @@
+#include <gtest/gtest.h>
+
+#include <climits>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/sprint_14/src/json.h"
+#include "../src/sprint_14/src/json_fast_loader.h"
+#include "../src/sprint_14/src/json_pull_parser.h"
+
+using namespace std::literals;
+using namespace json;
+
+namespace {
+
+json::Document LoadJSON(const std::string& text) {
+    std::istringstream input(text);
+    return json::Load(input);
+}
+
+json::Document FastLoadJSON(const std::string& text) {
+    std::istringstream input(text);
+    return json::FastLoad(input);
+}
+
+json::Document PullLoadJSON(const std::string& text) {
+    json::PullParser parser(text);
+    return json::Document{parser.ReadNode()};
+}
+
+/// @brief Checks, that the fast loader and the pull parser load the valid document the same as json::Load
+void ExpectSameParsing(const std::string& text) {
+    const Document expected = LoadJSON(text);
+
+    EXPECT_EQ(FastLoadJSON(text), expected) << "FastLoad differs from Load for: "s << text;
+    EXPECT_EQ(json::FastLoad(std::string_view(text)), expected) << "FastLoad differs from Load for: "s << text;
+    EXPECT_EQ(PullLoadJSON(text), expected) << "PullParser differs from Load for: "s << text;
+}
+
+void ExpectParsingError(const std::string& text) {
+    EXPECT_THROW(FastLoadJSON(text), ParsingError) << "FastLoad should fail for: "s << text;
+    EXPECT_THROW(json::FastLoad(std::string_view(text)), ParsingError) << "FastLoad should fail for: "s << text;
+    EXPECT_THROW(PullLoadJSON(text), ParsingError) << "PullParser should fail for: "s << text;
+}
+
+/// @brief Checks the document, which could be invalid: json::Load accepts some of the invalid documents, so the
+/// parsers should fail, if json::Load fails, and otherwise both fail or load the same as json::Load
+void ExpectConsistentParsing(const std::string& text) {
+    std::optional<Document> expected;
+    try {
+        expected = LoadJSON(text);
+    } catch (const ParsingError&) {
+        ExpectParsingError(text);
+        return;
+    }
+
+    std::optional<Document> document;
+    try {
+        document = FastLoadJSON(text);
+    } catch (const ParsingError&) {
+        EXPECT_THROW(PullLoadJSON(text), ParsingError) << "PullParser should fail as FastLoad for: "s << text;
+        return;
+    }
+
+    EXPECT_EQ(*document, *expected) << "FastLoad differs from Load for: "s << text;
+    EXPECT_EQ(PullLoadJSON(text), *expected) << "PullParser differs from Load for: "s << text;
+}
+
+class DocumentGenerator {
+public:
+    explicit DocumentGenerator(unsigned seed) : generator_(seed) {}
+
+    std::string Generate() {
+        std::string text;
+        AddValue(text, 0);
+        return text;
+    }
+
+private:
+    static constexpr int kMaxDepth{4};
+
+    int Random(int min, int max) {
+        return std::uniform_int_distribution<int>(min, max)(generator_);
+    }
+
+    void AddSpaces(std::string& text) {
+        static const std::string spaces = " \t\r\n"s;
+        for (int count = Random(0, 2); count > 0; --count)
+            text += spaces[Random(0, static_cast<int>(spaces.size()) - 1)];
+    }
+
+    void AddString(std::string& text) {
+        // Escapes and quotes are frequent, so they fall on the borders of the SIMD blocks
+        static const std::vector<std::string> parts = {"a"s,    "Stop"s, " "s,   "\\\\"s, "\\\""s, "\\n"s,
+                                                       "\\t"s,  "\\r"s,  "{"s,   "]"s,    ","s,    ":"s,
+                                                       "\xD0\x9C"s, "12"s, "tr"s};
+        text += '"';
+        for (int count = Random(0, 20); count > 0; --count)
+            text += parts[Random(0, static_cast<int>(parts.size()) - 1)];
+        text += '"';
+    }
+
+    void AddNumber(std::string& text) {
+        static const std::vector<std::string> numbers = {
+            "0"s,          "-0"s,          "7"s,      "-15"s,     "2147483647"s, "-2147483648"s,
+            "2147483648"s, "-2147483649"s, "0.5"s,    "-12.25"s,  "1e5"s,        "1E+5"s,
+            "2.5e-3"s,     "-1.0E-07"s,    "123.456"s, "1e308"s,  "2.5e-308"s,   "99999999999999999999"s};
+        text += numbers[Random(0, static_cast<int>(numbers.size()) - 1)];
+    }
+
+    void AddValue(std::string& text, int depth) {
+        AddSpaces(text);
+        const int type = Random(0, depth < kMaxDepth ? 7 : 5);
+        if (type == 0) {
+            text += "null"s;
+        } else if (type == 1) {
+            text += Random(0, 1) ? "true"s : "false"s;
+        } else if (type == 2 || type == 3) {
+            AddNumber(text);
+        } else if (type == 4 || type == 5) {
+            AddString(text);
+        } else if (type == 6) {
+            text += '[';
+            for (int count = Random(0, 5), index = 0; index < count; ++index) {
+                if (index > 0)
+                    text += ',';
+                AddValue(text, depth + 1);
+            }
+            AddSpaces(text);
+            text += ']';
+        } else {
+            text += '{';
+            for (int count = Random(0, 5), index = 0; index < count; ++index) {
+                if (index > 0)
+                    text += ',';
+                AddSpaces(text);
+                // Keys are unique, but some of them need escapes
+                text += "\"key"s + std::to_string(index) + (index % 2 ? "\\n\""s : "\""s);
+                AddSpaces(text);
+                text += ':';
+                AddValue(text, depth + 1);
+            }
+            AddSpaces(text);
+            text += '}';
+        }
+        AddSpaces(text);
+    }
+
+    std::mt19937 generator_;
+};
+
+}  // namespace
+
+TEST(JsonLoaders, ScalarsAreTheSameAsLoad) {
+    const std::vector<std::string> inputs{"null"s, "true"s,  "false"s, "0"s,    "-0"s,      "42"s,   "-17"s,
+                                          "0.0"s,  "1.5"s,   "-3.25"s, "1e3"s,  "1E-3"s,    "2e+2"s, "\"\""s,
+                                          "\"text\""s, "  7  "s, "\n\t null \r\n"s};
+
+    for (const auto& input : inputs)
+        ExpectSameParsing(input);
+}
+
+TEST(JsonLoaders, NumbersEdgeCasesAreTheSameAsLoad) {
+    const std::vector<std::string> inputs{std::to_string(INT_MAX),
+                                          std::to_string(INT_MIN),
+                                          std::to_string(static_cast<long long>(INT_MAX) + 1),
+                                          std::to_string(static_cast<long long>(INT_MIN) - 1),
+                                          "99999999999999999999"s,
+                                          "0.1"s,
+                                          "1e308"s,
+                                          "-1e308"s,
+                                          "2.2250738585072014e-308"s,
+                                          "1.7976931348623157e308"s,
+                                          "123456789.123456789"s,
+                                          "[1,-2,3.5,-4e2,0]"s,
+                                          "{\"a\":1e-7,\"b\":-0.0}"s};
+
+    for (const auto& input : inputs)
+        ExpectSameParsing(input);
+
+    ASSERT_TRUE(FastLoadJSON(std::to_string(INT_MAX)).GetRoot().IsInt()) << "INT_MAX should be loaded as int"s;
+    ASSERT_TRUE(FastLoadJSON("2147483648"s).GetRoot().IsPureDouble()) << "Integer out of int should be double"s;
+}
+
+TEST(JsonLoaders, EscapesAreTheSameAsLoad) {
+    const std::vector<std::string> inputs{R"("\n")"s,     R"("\t\r")"s,     R"("\"")"s,        R"("\\")"s,
+                                          R"("\\\"")"s,   R"("a\\\\")"s,   R"(["\\", "\""])"s, R"({"\"k\"": 1})"s,
+                                          R"("\\\\\"")"s, R"("end\\")"s};
+
+    for (const auto& input : inputs)
+        ExpectSameParsing(input);
+}
+
+TEST(JsonLoaders, StringsAcrossBlocksBordersAreTheSameAsLoad) {
+    // Fast loader classifies the input by blocks of 64 bytes: quotes and backslashes runs should be carried correctly
+    // through the border of the block at any position
+    for (size_t shift = 0; shift < 140; ++shift) {
+        for (size_t backslashes = 1; backslashes <= 5; ++backslashes) {
+            const std::string padding(shift, ' ');
+            // Even run of the backslashes is the escaped backslashes, the odd one also escapes the next quote
+            const std::string escapes(2 * backslashes, '\\');
+
+            ExpectSameParsing(padding + "[\""s + escapes + "\\\"\", \"after\"]"s);
+            ExpectSameParsing("[\""s + padding + escapes + "\", {\"key\": \"value\"}]"s);
+            ExpectSameParsing("{\""s + std::string(shift, 'k') + "\": [\"" + escapes + "\\\"" + escapes + "\"]}"s);
+        }
+    }
+}
+
+TEST(JsonLoaders, LongStringsAreTheSameAsLoad) {
+    // Strings, which are longer than the block of 64 bytes, contain the operators of JSON
+    for (size_t length : {63u, 64u, 65u, 127u, 128u, 129u, 1000u}) {
+        std::string text;
+        for (size_t index = 0; index < length; ++index)
+            text += "{}[],: "[index % 7];
+        ExpectSameParsing("[\""s + text + "\", \""s + text + "\\\"\"]"s);
+    }
+}
+
+TEST(JsonLoaders, RandomDocumentsAreTheSameAsLoad) {
+    DocumentGenerator generator(42u);
+
+    for (int index = 0; index < 500; ++index)
+        ExpectSameParsing(generator.Generate());
+}
+
+TEST(JsonLoaders, DamagedDocumentsAreTheSameAsLoad) {
+    DocumentGenerator generator(7u);
+
+    for (int index = 0; index < 100; ++index) {
+        const std::string text = generator.Generate();
+        // Truncated document is either still valid (e.g. a number) or fails in all the parsers
+        for (size_t length = 0; length < text.size(); length += 1 + text.size() / 16)
+            ExpectConsistentParsing(text.substr(0, length));
+    }
+}
+
+TEST(JsonLoaders, InvalidDocumentsThrowParsingError) {
+    const std::vector<std::string> inputs{""s,        "   "s,       "["s,       "]"s,        "{"s,         "}"s,
+                                          "[1,"s,     "[1 2]"s,     "[,1]"s,    "[1,]"s,     "[1,,2]"s,    "{\"a\"}"s,
+                                          "{\"a\":}"s, "{1:2}"s,     "\"abc"s,   "tru"s,      "nul"s,       "falsee"s,
+                                          "\"\\q\""s, "-"s,         "{,\"a\":1}"s, "{\"a\":1,}"s,
+                                          "{\"a\":1 \"b\":2}"s,        "{\"a\":1,\"a\":2}"s};
+
+    for (const auto& input : inputs)
+        ExpectParsingError(input);
+}
+
+TEST(JsonLoaders, PullParserReadsValuesByTheEvents) {
+    const std::string text =
+        R"({"name": "Stop \"A\"", "count": 3, "point": 55.5, "flags": [true, null], "skip": {"a": [1, 2]}})"s;
+
+    json::PullParser parser(text);
+    parser.StartDict();
+
+    std::vector<std::string> keys;
+    while (auto key = parser.NextKey()) {
+        keys.emplace_back(*key);
+        if (*key == "name"sv) {
+            EXPECT_EQ(parser.Peek(), PullParser::ValueType::String);
+            EXPECT_EQ(parser.ReadString(), "Stop \"A\""sv) << "Escaped string should be unescaped"s;
+        } else if (*key == "count"sv) {
+            EXPECT_EQ(parser.ReadInt(), 3);
+        } else if (*key == "point"sv) {
+            EXPECT_DOUBLE_EQ(parser.ReadDouble(), 55.5);
+        } else if (*key == "flags"sv) {
+            parser.StartArray();
+            ASSERT_TRUE(parser.NextItem());
+            EXPECT_TRUE(parser.ReadBool());
+            ASSERT_TRUE(parser.NextItem());
+            parser.ReadNull();
+            EXPECT_FALSE(parser.NextItem());
+        } else {
+            const size_t position = parser.GetPosition();
+            parser.Skip();
+
+            // Skipped value could be read again from its position
+            const size_t end = parser.GetPosition();
+            parser.SetPosition(position);
+            EXPECT_EQ(parser.ReadNode(), LoadJSON(R"({"a": [1, 2]})"s).GetRoot());
+            EXPECT_EQ(parser.GetPosition(), end);
+        }
+    }
+
+    const std::vector<std::string> expected_keys{"name"s, "count"s, "point"s, "flags"s, "skip"s};
+    EXPECT_EQ(keys, expected_keys) << "Keys should be read in the order of the input"s;
+}
@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/sprint_14/src/json.h"
+#include "../src/sprint_14/src/json_builder.h"
+#include "../src/sprint_14/src/json_writer.h"
+
+using namespace std::literals;
+using namespace json;
+
+namespace {
+
+std::string Print(const Node& node) {
+    std::ostringstream output;
+    Print(Document{node}, output);
+    return output.str();
+}
+
+std::string WriteNode(const Node& node, size_t buffer_size = 64u * 1024u) {
+    std::ostringstream output;
+    {
+        Writer writer(output, buffer_size);
+        writer.Value(node);
+    }
+    return output.str();
+}
+
+/// @brief Adds the node to the builder by the same calls, as the document is written by the writer
+void BuildNode(const Node& node, Builder& builder) {
+    if (node.IsArray()) {
+        builder.StartArray();
+        for (const Node& item : node.AsArray())
+            BuildNode(item, builder);
+        builder.EndArray();
+    } else if (node.IsDict()) {
+        builder.StartDict();
+        for (const auto& [key, value] : node.AsDict()) {
+            builder.Key(key);
+            BuildNode(value, builder);
+        }
+        builder.EndDict();
+    } else {
+        builder.Value(node.GetValue());
+    }
+}
+
+void WriteEvents(const Node& node, Writer& writer) {
+    if (node.IsArray()) {
+        writer.StartArray();
+        for (const Node& item : node.AsArray())
+            WriteEvents(item, writer);
+        writer.EndArray();
+    } else if (node.IsDict()) {
+        writer.StartDict();
+        for (const auto& [key, value] : node.AsDict()) {
+            writer.Key(key);
+            WriteEvents(value, writer);
+        }
+        writer.EndDict();
+    } else if (node.IsString()) {
+        writer.Value(std::string_view(node.AsString()));
+    } else if (node.IsInt()) {
+        writer.Value(node.AsInt());
+    } else if (node.IsPureDouble()) {
+        writer.Value(node.AsDouble());
+    } else if (node.IsBool()) {
+        writer.Value(node.AsBool());
+    } else {
+        writer.Value(nullptr);
+    }
+}
+
+Node GenerateNode(std::mt19937& generator, int depth = 0) {
+    const auto random = [&generator](int min, int max) {
+        return std::uniform_int_distribution<int>(min, max)(generator);
+    };
+    static const std::vector<double> doubles{0.5,    -12.25, 1e-7, 123456.7, 1234567.8, 1e21,
+                                             -0.001, 3.14159265, 100., 1e-300, 6.02e23};
+    static const std::vector<std::string> strings{""s, "Stop"s, "\r\n"s, "\"quoted\""s, "back\\slash"s, "\t tab"s,
+                                                  "\xD0\x9C\xD0\xB8\xD1\x80"s};
+
+    switch (random(0, depth < 4 ? 7 : 5)) {
+        case 0:
+            return Node{nullptr};
+        case 1:
+            return Node{random(0, 1) == 1};
+        case 2:
+            return Node{random(-100'000, 100'000)};
+        case 3:
+            return Node{doubles[random(0, static_cast<int>(doubles.size()) - 1)]};
+        case 4:
+        case 5:
+            return Node{strings[random(0, static_cast<int>(strings.size()) - 1)]};
+        case 6: {
+            Array array;
+            for (int count = random(0, 4); count > 0; --count)
+                array.push_back(GenerateNode(generator, depth + 1));
+            return Node{std::move(array)};
+        }
+        default: {
+            Dict dict;
+            for (int count = random(0, 4); count > 0; --count)
+                dict.emplace(strings[random(0, static_cast<int>(strings.size()) - 1)] + std::to_string(count),
+                             GenerateNode(generator, depth + 1));
+            return Node{std::move(dict)};
+        }
+    }
+}
+
+}  // namespace
+
+TEST(JsonWriter, ScalarsAreTheSameAsPrint) {
+    const std::vector<Node> nodes{Node{nullptr},   Node{true},        Node{false},       Node{0},
+                                  Node{-42},       Node{2147483647},  Node{0.5},         Node{-123.45},
+                                  Node{1e-7},      Node{1234567.0},   Node{1e21},        Node{100.0},
+                                  Node{""s},       Node{"text"s},     Node{"\r\n\"\\"s}, Node{"\t"s}};
+
+    for (const auto& node : nodes)
+        EXPECT_EQ(WriteNode(node), Print(node)) << "Writer differs from Print for: "s << Print(node);
+}
+
+TEST(JsonWriter, RandomDocumentsAreTheSameAsBuilderAndPrint) {
+    std::mt19937 generator(42u);
+
+    for (int index = 0; index < 300; ++index) {
+        // Builder does not build the document with the null root, so the root is always the array
+        const Node node{Array{GenerateNode(generator)}};
+
+        Builder builder;
+        BuildNode(node, builder);
+        const std::string expected = Print(builder.Build());
+
+        std::ostringstream output;
+        {
+            Writer writer(output);
+            WriteEvents(node, writer);
+        }
+        EXPECT_EQ(output.str(), expected) << "Writer differs from Builder and Print"s;
+        EXPECT_EQ(WriteNode(node), expected) << "Writer of the node differs from Builder and Print"s;
+    }
+}
+
+TEST(JsonWriter, SmallBufferDoesNotChangeOutput) {
+    std::mt19937 generator(7u);
+
+    for (int index = 0; index < 100; ++index) {
+        const Node node = GenerateNode(generator);
+        const std::string expected = Print(node);
+
+        for (size_t buffer_size : {1u, 2u, 7u, 64u})
+            EXPECT_EQ(WriteNode(node, buffer_size), expected) << "Buffer of size "s << buffer_size;
+    }
+}
+
+TEST(JsonWriter, FragmentsAreInsertedAsValues) {
+    std::mt19937 generator(13u);
+
+    for (int index = 0; index < 100; ++index) {
+        Array items;
+        for (int count = index % 5; count > 0; --count)
+            items.push_back(GenerateNode(generator));
+        const Node node{items};
+
+        // Items are written separately with the indent of the array items
+        std::vector<std::string> fragments(items.size());
+        for (size_t item = 0; item < items.size(); ++item) {
+            Writer writer(fragments[item], 1u);
+            writer.Value(items[item]);
+        }
+
+        std::ostringstream output;
+        {
+            Writer writer(output);
+            writer.StartArray();
+            for (const auto& fragment : fragments)
+                writer.RawValue(fragment);
+            writer.EndArray();
+        }
+        EXPECT_EQ(output.str(), Print(node)) << "Document from the fragments differs from Print"s;
+    }
+}
+
+TEST(JsonWriter, ThrowsOnIncorrectJsonCreation) {
+    std::ostringstream output;
+
+    {
+        Writer writer(output);
+        EXPECT_THROW(writer.Key("key"sv), std::logic_error) << "Key outside of the dictionary"s;
+        EXPECT_THROW(writer.EndDict(), std::logic_error) << "End of not started dictionary"s;
+        EXPECT_THROW(writer.EndArray(), std::logic_error) << "End of not started array"s;
+    }
+    {
+        Writer writer(output);
+        writer.StartDict();
+        EXPECT_THROW(writer.Value(1), std::logic_error) << "Value of the dictionary without the key"s;
+        EXPECT_THROW(writer.EndArray(), std::logic_error) << "End of array instead of dictionary"s;
+        writer.Key("key"sv);
+        EXPECT_THROW(writer.Key("other"sv), std::logic_error) << "Two keys in a row"s;
+        EXPECT_THROW(writer.EndDict(), std::logic_error) << "End of dictionary without the value of the key"s;
+    }
+    {
+        Writer writer(output);
+        writer.StartArray();
+        EXPECT_THROW(writer.Key("key"sv), std::logic_error) << "Key in the array"s;
+        EXPECT_THROW(writer.EndDict(), std::logic_error) << "End of dictionary instead of array"s;
+        writer.EndArray();
+        EXPECT_THROW(writer.Value(1), std::logic_error) << "Second root value"s;
+        EXPECT_THROW(writer.StartArray(), std::logic_error) << "Second root value"s;
+    }
+}
@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <list>
 #include <numeric>
 
 #include "../src/sprint_8/paginator.h"
@@ -76,4 +77,34 @@ TEST(PaginatorClass, PaginatorSplitEmptyContainer) {
 
     auto paginator = Paginate(values, page_size);
     EXPECT_EQ(paginator.size(), 0u) << "Paginator should not split on pages empty container"s;
-}
\ No newline at end of file
+}
+
+TEST(PaginatorClass, PaginatorSplitContainerWithForwardIterators) {
+    const std::list<int> values = {1, 2, 3, 4, 5, 6, 7};
+    const std::vector<std::vector<int>> expected_pages = {{1, 2, 3}, {4, 5, 6}, {7}};
+    auto expected_page = expected_pages.begin();
+
+    auto paginator = Paginate(values, 3);
+    EXPECT_EQ(paginator.size(), expected_pages.size())
+        << "Paginator should split container with forward iterators on expected number of pages"s;
+
+    for (auto& page : paginator) {
+        std::vector<int> actual_page{page.start, page.end};
+        EXPECT_EQ(actual_page, *expected_page++)
+            << "Paginator should correctly split container on pages with expected content"s;
+    }
+}
+
+TEST(PaginatorClass, PaginatorReturnsPageById) {
+    std::vector<int> values(10);
+    std::iota(values.begin(), values.end(), 1);
+
+    auto paginator = Paginate(values, 4);
+
+    const auto page = paginator.GetPage(2);
+    EXPECT_EQ(std::vector<int>(page.start, page.end), std::vector<int>({9, 10}))
+        << "Paginator should return the last incomplete page by its index"s;
+
+    const auto missing_page = paginator.GetPage(3);
+    EXPECT_EQ(missing_page.start, missing_page.end) << "Paginator should return empty range for missing page"s;
+}
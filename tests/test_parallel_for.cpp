@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <execution>
+#include <list>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/sprint_8/parallel_for.h"
+
+using namespace sprint_8::server::utils;
+using namespace std::literals;
+
+TEST(ParallelForUtils, SplitIntoChunksCoversRangeWithAlmostEqualChunks) {
+    std::list<int> values(10);
+    std::iota(values.begin(), values.end(), 0);
+
+    const auto chunks = SplitIntoChunks(values.begin(), values.end(), 4);
+    ASSERT_EQ(chunks.size(), 4u) << "Range should be split on the requested number of chunks"s;
+
+    const std::vector<long> expected_sizes = {3, 3, 2, 2};
+    auto expected_begin = values.begin();
+    for (size_t chunk_id = 0; chunk_id < chunks.size(); ++chunk_id) {
+        EXPECT_EQ(chunks[chunk_id].first, expected_begin) << "Chunks should follow each other without gaps"s;
+        EXPECT_EQ(std::distance(chunks[chunk_id].first, chunks[chunk_id].second), expected_sizes[chunk_id])
+            << "Chunks sizes should differ not more than on one element"s;
+        expected_begin = chunks[chunk_id].second;
+    }
+    EXPECT_EQ(expected_begin, values.end()) << "Chunks should cover the whole range"s;
+
+    EXPECT_EQ(SplitIntoChunks(values.begin(), values.end(), 100).size(), values.size())
+        << "Number of chunks should not exceed number of elements"s;
+}
+
+TEST(ParallelForUtils, ForEachVisitsEachElementOnce) {
+    std::set<int> values;
+    for (int value = 0; value < 10'000; ++value)
+        values.insert(value);
+
+    for (auto schedule : {Schedule::Static, Schedule::Dynamic}) {
+        std::vector<std::atomic<int>> visits_count(values.size());
+        ForEach(
+            std::execution::par, values, [&visits_count](int value) { ++visits_count[value]; }, schedule);
+
+        EXPECT_TRUE(std::all_of(visits_count.begin(), visits_count.end(), [](const auto& count) { return count == 1; }))
+            << "Parallel ForEach should visit each element of the forward range exactly once"s;
+    }
+}
+
+TEST(ParallelForUtils, TransformReduceKeepsOrderOfElements) {
+    std::vector<std::string> words;
+    std::string expected_result;
+    for (int word_id = 0; word_id < 1'000; ++word_id) {
+        words.push_back(std::to_string(word_id));
+        expected_result += words.back() + ","s;
+    }
+
+    const auto to_item = [](const std::string& word) { return word + ","s; };
+    EXPECT_EQ(TransformReduce(std::execution::par, words.begin(), words.end(), ""s, std::plus<>(), to_item),
+              expected_result)
+        << "Parallel reduction should combine results in the order of elements"s;
+    EXPECT_EQ(TransformReduce(std::execution::seq, words.begin(), words.end(), ""s, std::plus<>(), to_item),
+              expected_result)
+        << "Sequential reduction should combine results in the order of elements"s;
+}
+
+TEST(ThreadPoolClass, RunExecutesAllTasksAndRethrowsException) {
+    ThreadPool pool(3);
+
+    std::vector<std::atomic<int>> executed(1'000);
+    pool.Run(executed.size(), [&executed](size_t task_id) { ++executed[task_id]; });
+    EXPECT_TRUE(std::all_of(executed.begin(), executed.end(), [](const auto& count) { return count == 1; }))
+        << "Thread pool should execute each task exactly once"s;
+
+    EXPECT_THROW(pool.Run(100,
+                          [](size_t task_id) {
+                              if (task_id == 42)
+                                  throw std::runtime_error("task failed"s);
+                          }),
+                 std::runtime_error)
+        << "Thread pool should rethrow exception of the task in the calling thread"s;
+}
+
+TEST(ThreadPoolClass, NestedRunDoesNotDeadlock) {
+    ThreadPool pool(2);
+
+    std::atomic<int> executed_count{0};
+    pool.Run(8, [&pool, &executed_count](size_t) { pool.Run(8, [&executed_count](size_t) { ++executed_count; }); });
+
+    EXPECT_EQ(executed_count, 64) << "Nested jobs should be executed by the worker itself"s;
+}
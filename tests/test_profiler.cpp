@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+#include "../src/sprint_8/profiler.h"
+
+using namespace sprint_8::server::utils;
+using namespace std::literals;
+
+namespace {
+
+const Profiler::ScopeStatistics* FindStatistics(const std::vector<Profiler::ScopeStatistics>& statistics,
+                                                const std::vector<std::string>& path) {
+    const auto position = std::find_if(statistics.begin(), statistics.end(),
+                                       [&path](const auto& item) { return item.path == path; });
+    return position != statistics.end() ? &*position : nullptr;
+}
+
+}  // namespace
+
+TEST(LatencyHistogramClass, BucketsCoverValuesWithBoundedRelativeError) {
+    for (uint64_t value : {0ull, 1ull, 7ull, 8ull, 15ull, 16ull, 1'000ull, 123'456'789ull, ~0ull}) {
+        const int bucket_id = LatencyHistogram::GetBucketId(value);
+        const uint64_t upper_bound = LatencyHistogram::GetBucketUpperBound(bucket_id);
+
+        EXPECT_GE(upper_bound, value) << "Value should not exceed the upper bound of its bucket"s;
+        EXPECT_LE(upper_bound - value, value / LatencyHistogram::kSubBucketsCount)
+            << "Bucket width should be bounded by the relative error"s;
+    }
+
+    EXPECT_EQ(LatencyHistogram::GetBucketId(~0ull), LatencyHistogram::kBucketsCount - 1)
+        << "The biggest value should fall into the last bucket"s;
+}
+
+TEST(LatencyHistogramClass, PercentilesOfUniformValues) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 1'000; ++value)
+        histogram.Record(value);
+
+    EXPECT_EQ(histogram.GetTotalCount(), 1'000);
+    EXPECT_NEAR(histogram.GetValueAtPercentile(50.), 500, 500 / LatencyHistogram::kSubBucketsCount);
+    EXPECT_NEAR(histogram.GetValueAtPercentile(99.), 990, 990 / LatencyHistogram::kSubBucketsCount);
+    EXPECT_GE(histogram.GetValueAtPercentile(100.), 1'000) << "Max percentile should cover all values"s;
+}
+
+TEST(ProfilerClass, NestedScopesFormCallPaths) {
+    for (int call_id = 0; call_id < 3; ++call_id) {
+        PROFILE_SCOPE("test-nested-parent");
+        for (int child_id = 0; child_id < 2; ++child_id) {
+            PROFILE_SCOPE("test-nested-child");
+        }
+    }
+
+    const auto statistics = Profiler::Instance().GetStatistics();
+    const auto* parent = FindStatistics(statistics, {"test-nested-parent"s});
+    const auto* child = FindStatistics(statistics, {"test-nested-parent"s, "test-nested-child"s});
+
+    ASSERT_NE(parent, nullptr) << "Profiler should store statistics of the top level scope"s;
+    ASSERT_NE(child, nullptr) << "Profiler should store statistics of the nested scope under its parent"s;
+    EXPECT_EQ(parent->calls_count, 3);
+    EXPECT_EQ(child->calls_count, 6);
+    EXPECT_GE(parent->total_time, child->total_time) << "Parent scope time includes time of the children"s;
+    EXPECT_EQ(parent->self_time, parent->total_time - child->total_time);
+    EXPECT_EQ(FindStatistics(statistics, {"test-nested-child"s}), nullptr)
+        << "Nested scope should not appear on the top level"s;
+}
+
+TEST(ProfilerClass, StatisticsAreMergedFromAllThreads) {
+    const int threads_count{4};
+    const int calls_count{1'000};
+
+    std::vector<std::thread> threads;
+    for (int thread_id = 0; thread_id < threads_count; ++thread_id) {
+        threads.emplace_back([] {
+            for (int call_id = 0; call_id < calls_count; ++call_id) {
+                PROFILE_SCOPE("test-multithreading");
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    const auto statistics = Profiler::Instance().GetStatistics();
+    const auto* scope = FindStatistics(statistics, {"test-multithreading"s});
+
+    ASSERT_NE(scope, nullptr);
+    EXPECT_EQ(scope->calls_count, threads_count * calls_count) << "Calls from all threads should be counted"s;
+    EXPECT_EQ(scope->histogram.GetTotalCount(), scope->calls_count);
+    EXPECT_LE(scope->min_time, scope->max_time);
+}
+
+TEST(ProfilerClass, DumpToJsonAndChromeTrace) {
+    auto& profiler = Profiler::Instance();
+    profiler.SetTracing(true);
+    {
+        PROFILE_SCOPE("test-dump \"quoted\"");
+    }
+    profiler.SetTracing(false);
+
+    std::stringstream json;
+    profiler.DumpJson(json);
+    EXPECT_NE(json.str().find(R"("path": "test-dump \"quoted\"")"), std::string::npos)
+        << "JSON dump should contain escaped scope path"s;
+    EXPECT_NE(json.str().find("\"p99_ns\""), std::string::npos) << "JSON dump should contain percentiles"s;
+
+    std::stringstream trace;
+    profiler.DumpChromeTrace(trace);
+    EXPECT_NE(trace.str().find(R"({"name": "test-dump \"quoted\"", "ph": "X")"), std::string::npos)
+        << "Chrome trace should contain complete event of the scope"s;
+}
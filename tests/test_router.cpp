@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/sprint_14/src/dijkstra_router.h"
+#include "../src/sprint_14/src/graph.h"
+#include "../src/sprint_14/src/router.h"
+
+using namespace graph;
+using namespace std::literals;
+
+namespace {
+
+using Graph = DirectedWeightedGraph<double>;
+
+/// @brief Graph of several blocks of the routes table with the vertices, which are unreachable from the others
+Graph MakeRandomGraph(std::mt19937& generator) {
+    const size_t vertex_count = std::uniform_int_distribution<size_t>(100, 200)(generator);
+    // Last vertices have no edges, so there are the pairs without the route
+    const size_t connected_count = vertex_count - vertex_count / 10;
+    std::uniform_int_distribution<size_t> vertex(0, connected_count - 1);
+    std::uniform_real_distribution<double> weight(0., 10.);
+
+    Graph graph(vertex_count);
+    for (size_t index = 0; index < 2 * connected_count; ++index)
+        graph.AddEdge({vertex(generator), vertex(generator), weight(generator)});
+    // Edges into the isolated part only: routes exist one way, but not back
+    graph.AddEdge({0, connected_count, 1.});
+    graph.Freeze();
+    return graph;
+}
+
+/// @brief Checks, that the route has the same weight as the Dijkstra one and consists of the connected graph edges
+template <typename Route>
+void ExpectSameRoute(const Graph& graph, const std::optional<Route>& route,
+                     const std::optional<typename DijkstraRouter<double>::RouteInfo>& expected_route, VertexId from,
+                     VertexId to, double tolerance) {
+    ASSERT_EQ(route.has_value(), expected_route.has_value())
+        << "Route "s << from << " -> "s << to << " should be found by both routers"s;
+    if (!route)
+        return;
+
+    EXPECT_NEAR(route->weight, expected_route->weight, tolerance) << "Route "s << from << " -> "s << to;
+
+    VertexId current = from;
+    double weight = 0.;
+    for (EdgeId edge_id : route->edges) {
+        const auto& edge = graph.GetEdge(edge_id);
+        ASSERT_EQ(edge.from, current) << "Route edges should be the connected path"s;
+        current = edge.to;
+        weight += edge.weight;
+    }
+    EXPECT_EQ(current, to) << "Route should end at the target vertex"s;
+    EXPECT_NEAR(weight, route->weight, 1e-9) << "Route weight should be the sum of its edges"s;
+}
+
+template <typename Router>
+void ExpectSameRoutesAsDijkstra(const Graph& graph, const Router& router, double tolerance) {
+    const DijkstraRouter<double> dijkstra(graph);
+
+    for (VertexId from = 0; from < graph.GetVertexCount(); ++from) {
+        for (VertexId to = 0; to < graph.GetVertexCount(); ++to)
+            ExpectSameRoute(graph, router.BuildRoute(from, to), dijkstra.BuildRoute(from, to), from, to, tolerance);
+    }
+}
+
+}  // namespace
+
+TEST(Router, FloydWarshallRoutesAreTheSameAsDijkstra) {
+    std::mt19937 generator(42u);
+
+    for (int graph_id = 0; graph_id < 5; ++graph_id) {
+        const auto graph = MakeRandomGraph(generator);
+        const Router<double> router(graph, AllPairsAlgorithm::FloydWarshall);
+        ExpectSameRoutesAsDijkstra(graph, router, 1e-9);
+    }
+}
+
+TEST(Router, ParallelDijkstraRoutesAreTheSameAsDijkstra) {
+    std::mt19937 generator(7u);
+
+    for (int graph_id = 0; graph_id < 5; ++graph_id) {
+        const auto graph = MakeRandomGraph(generator);
+        const Router<double> router(graph, AllPairsAlgorithm::ParallelDijkstra);
+        ExpectSameRoutesAsDijkstra(graph, router, 1e-9);
+    }
+}
+
+TEST(Router, FloatTableRoutesAreCloseToDijkstra) {
+    // Weight of the route is summed up from the original edges, so only the choice of the route could be affected by
+    // the rounding of the table weights
+    std::mt19937 generator(13u);
+
+    for (int graph_id = 0; graph_id < 3; ++graph_id) {
+        const auto graph = MakeRandomGraph(generator);
+        for (auto algorithm : {AllPairsAlgorithm::FloydWarshall, AllPairsAlgorithm::ParallelDijkstra}) {
+            const Router<double, float> router(graph, algorithm);
+            ExpectSameRoutesAsDijkstra(graph, router, 1e-3);
+        }
+    }
+}
+
+TEST(Router, RoutesTableIsRestoredFromData) {
+    std::mt19937 generator(21u);
+    const auto graph = MakeRandomGraph(generator);
+    const Router<double> router(graph);
+
+    const Router<double> restored_router(graph, router.GetData());
+    ExpectSameRoutesAsDijkstra(graph, restored_router, 1e-9);
+
+    auto data = router.GetData();
+    data.weights.pop_back();
+    EXPECT_THROW(Router<double>(graph, std::move(data)), std::invalid_argument) << "Table of another graph"s;
+}
+
+TEST(Router, ThrowsOnIncorrectInput) {
+    Graph graph(3);
+    graph.AddEdge({0, 1, 1.});
+    graph.AddEdge({1, 2, -1.});
+    graph.Freeze();
+    EXPECT_THROW(Router<double>{graph}, std::domain_error) << "Negative weight of the edge"s;
+
+    Graph correct_graph(2);
+    correct_graph.AddEdge({0, 1, 1.});
+    correct_graph.Freeze();
+    const Router<double> router(correct_graph);
+    EXPECT_THROW((void)router.BuildRoute(0, 2), std::out_of_range) << "Vertex is out of the graph"s;
+    EXPECT_FALSE(router.BuildRoute(1, 0).has_value()) << "Route in the opposite direction of the edge"s;
+    EXPECT_EQ(router.BuildRoute(1, 1)->edges.size(), 0u) << "Route to the same vertex is empty"s;
+}
@@ -7,6 +7,7 @@
 #include <cmath>
 #include <execution>
 
+#include "../src/sprint_8/paginator.h"
 #include "../src/sprint_8/search_server.h"
 
 using namespace sprint_8::server;
@@ -178,6 +179,31 @@ TEST(SearchServerClass, TestFoundDocumentsSortingByRelevance) {
     EXPECT_TRUE(is_sorted_by_relevance) << "Server returns documents, sorted by relevance"s;
 }
 
+TEST(SearchServerClass, TestDocumentsGeneratorReturnsAllDocumentsSortedByRelevance) {
+    SearchServer server;
+
+    for (int document_id = 1; document_id <= 50; ++document_id)
+        server.AddDocument(document_id, "cat dog"s, DocumentStatus::ACTUAL, {document_id});
+    server.AddDocument(100, "dog"s, DocumentStatus::ACTUAL, general_ratings);
+
+    const auto generator = server.FindDocumentsGenerator("cat"s);
+    EXPECT_EQ(generator.size(), 50u) << "Generator contains all found documents"s;
+
+    const auto top_documents = server.FindTopDocuments("cat"s);
+    const std::vector<Document> generated_top(generator.begin(), std::next(generator.begin(), 5));
+    for (size_t id = 0; id < top_documents.size(); ++id)
+        EXPECT_EQ(generated_top[id].id, top_documents[id].id) << "Generator starts with the top documents"s;
+
+    const std::vector<Document> all_documents(generator.begin(), generator.end());
+    EXPECT_TRUE(std::is_sorted(all_documents.begin(), all_documents.end(), IsMoreRelevant))
+        << "Generator returns documents sorted by relevance and rating"s;
+
+    auto paginator = Paginate(generator, 20);
+    const auto last_page = paginator.GetPage(2);
+    EXPECT_EQ(std::distance(last_page.start, last_page.end), 10) << "Generator could be paginated lazily"s;
+    EXPECT_EQ(last_page.start->id, 10) << "Last page starts with the document of the tenth rating"s;
+}
+
 TEST(SearchServerClass, TestServerFindNotMoreDocumentsThanExpected) {
     SearchServer server;
 
@@ -400,4 +426,19 @@ TEST(SearchServerClass, TestMatchDocumentsWithDifferentExecutionPolices) {
         EXPECT_EQ(words.size(), 0)
             << "Unexpected behaviour in method MatchDocument() with Multi-thread policy (execution::par)"s;
     }
-}
\ No newline at end of file
+}
+
+TEST(SearchServerClass, TestMatchDocumentsPartiallyWithDifferentExecutionPolices) {
+    SearchServer search_server("and with"s);
+    search_server.AddDocument(1, "funny pet and nasty rat"s, DocumentStatus::ACTUAL, {1, 2});
+
+    const std::string query = "rat curly funny hair"s;
+    const std::vector<std::string_view> expected_words{"funny"sv, "rat"sv};
+
+    EXPECT_EQ(std::get<0>(search_server.MatchDocument(query, 1)), expected_words)
+        << "Only the words of the document should be matched"s;
+    EXPECT_EQ(std::get<0>(search_server.MatchDocument(std::execution::seq, query, 1)), expected_words)
+        << "Only the words of the document should be matched (execution::seq)"s;
+    EXPECT_EQ(std::get<0>(search_server.MatchDocument(std::execution::par, query, 1)), expected_words)
+        << "Only the words of the document should be matched (execution::par)"s;
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "../src/sprint_14/src/geo.h"
+#include "../src/sprint_14/src/spatial_index.h"
+
+using namespace geo;
+using namespace std::literals;
+
+namespace {
+
+std::vector<Coordinates> MakeRandomPoints(std::mt19937& generator, size_t count) {
+    std::uniform_real_distribution<double> lat(55.5, 55.9);
+    std::uniform_real_distribution<double> lng(37.3, 37.9);
+
+    std::vector<Coordinates> points(count);
+    for (auto& point : points)
+        point = {lat(generator), lng(generator)};
+    return points;
+}
+
+std::vector<uint32_t> FindInBoxByBruteForce(const std::vector<Coordinates>& points, Coordinates min, Coordinates max) {
+    std::vector<uint32_t> result;
+    for (uint32_t id = 0; id < points.size(); ++id) {
+        const auto& point = points[id];
+        if (min.lat <= point.lat && point.lat <= max.lat && min.lng <= point.lng && point.lng <= max.lng)
+            result.push_back(id);
+    }
+    return result;
+}
+
+/// @brief Computes the distances to all the points by the same kernel as the index, so the order of the equal
+/// distances is the same
+std::vector<GridIndex::Neighbour> FindNearestByBruteForce(const std::vector<Coordinates>& points, Coordinates point,
+                                                          size_t count) {
+    PointsTerms terms;
+    std::vector<uint32_t> ids(points.size());
+    for (uint32_t id = 0; id < points.size(); ++id) {
+        terms.Add(points[id]);
+        ids[id] = id;
+    }
+    std::vector<double> distances(points.size());
+    ComputeDistances(terms, point, ids.data(), ids.size(), distances.data());
+
+    std::vector<GridIndex::Neighbour> result;
+    for (uint32_t id = 0; id < points.size(); ++id)
+        result.push_back({id, distances[id]});
+    std::sort(result.begin(), result.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.distance < rhs.distance || (lhs.distance == rhs.distance && lhs.id < rhs.id);
+    });
+    result.resize(std::min(count, result.size()));
+    return result;
+}
+
+void ExpectSameNearest(const std::vector<Coordinates>& points, const GridIndex& index, Coordinates point,
+                       size_t count) {
+    const auto nearest = index.FindNearest(point, count);
+    const auto expected = FindNearestByBruteForce(points, point, count);
+
+    ASSERT_EQ(nearest.size(), expected.size()) << "Count of the nearest points for k = "s << count;
+    for (size_t position = 0; position < nearest.size(); ++position) {
+        EXPECT_EQ(nearest[position].id, expected[position].id)
+            << "Nearest point #"s << position << " for k = "s << count;
+        EXPECT_DOUBLE_EQ(nearest[position].distance, expected[position].distance);
+        EXPECT_NEAR(nearest[position].distance, ComputeDistance(point, points[nearest[position].id]), 1e-3)
+            << "Distance should be the geodesic one"s;
+    }
+}
+
+}  // namespace
+
+TEST(GridIndex, EmptyIndexFindsNothing) {
+    const GridIndex index;
+
+    EXPECT_TRUE(index.FindInBox({0., 0.}, {90., 180.}).empty());
+    EXPECT_TRUE(index.FindNearest({55.7, 37.6}, 5).empty());
+}
+
+TEST(GridIndex, FindInBoxIsTheSameAsBruteForce) {
+    std::mt19937 generator(42u);
+    const auto points = MakeRandomPoints(generator, 1000);
+    const GridIndex index(points);
+
+    // Boxes are random, so most of them cross the borders of the cells, some of them are out of the points
+    std::uniform_real_distribution<double> lat(55.4, 56.);
+    std::uniform_real_distribution<double> lng(37.2, 38.);
+    for (int query = 0; query < 500; ++query) {
+        Coordinates min{lat(generator), lng(generator)};
+        Coordinates max{lat(generator), lng(generator)};
+        if (query % 10 != 0) {
+            // Borders of every tenth box are not ordered, so it is mostly empty (min is greater than max)
+            std::tie(min.lat, max.lat) = std::minmax(min.lat, max.lat);
+            std::tie(min.lng, max.lng) = std::minmax(min.lng, max.lng);
+        }
+
+        EXPECT_EQ(index.FindInBox(min, max), FindInBoxByBruteForce(points, min, max)) << "Box #"s << query;
+    }
+}
+
+TEST(GridIndex, FindInBoxIncludesPointsOnBordersOfBoxAndCells) {
+    // Points of the regular lattice lie on the borders of the cells, the box borders pass through the points
+    std::vector<Coordinates> points;
+    for (int row = 0; row < 10; ++row) {
+        for (int column = 0; column < 10; ++column)
+            points.push_back({55.5 + row * 0.01, 37.5 + column * 0.01});
+    }
+    const GridIndex index(points);
+
+    for (int row_begin = 0; row_begin < 10; ++row_begin) {
+        for (int column_begin = 0; column_begin < 10; ++column_begin) {
+            const Coordinates min = points[row_begin * 10 + column_begin];
+            const Coordinates max = points[9 * 10 + 9];
+
+            const auto expected = FindInBoxByBruteForce(points, min, max);
+            ASSERT_EQ(expected.size(), static_cast<size_t>((10 - row_begin) * (10 - column_begin)));
+            EXPECT_EQ(index.FindInBox(min, max), expected);
+        }
+    }
+
+    EXPECT_EQ(index.FindInBox(points[55], points[55]), std::vector<uint32_t>{55}) << "Box of the single point"s;
+}
+
+TEST(GridIndex, FindNearestIsTheSameAsBruteForce) {
+    std::mt19937 generator(7u);
+    const auto points = MakeRandomPoints(generator, 1000);
+    const GridIndex index(points);
+
+    // Query points are inside and outside of the points bounding box
+    std::uniform_real_distribution<double> lat(55.3, 56.1);
+    std::uniform_real_distribution<double> lng(37.1, 38.1);
+    for (int query = 0; query < 300; ++query) {
+        const Coordinates point{lat(generator), lng(generator)};
+        for (size_t count : {1u, 2u, 5u, 17u, 100u})
+            ExpectSameNearest(points, index, point, count);
+    }
+}
+
+TEST(GridIndex, FindNearestReturnsAllPointsIfCountIsGreater) {
+    std::mt19937 generator(13u);
+    const auto points = MakeRandomPoints(generator, 50);
+    const GridIndex index(points);
+
+    for (size_t count : {49u, 50u, 51u, 1000u})
+        ExpectSameNearest(points, index, {55.7, 37.6}, count);
+
+    EXPECT_TRUE(index.FindNearest({55.7, 37.6}, 0).empty()) << "Zero nearest points should be found"s;
+}
+
+TEST(GridIndex, DegeneratePointsAreFound) {
+    // Equal points, the points on the one meridian and on the one parallel give the grid of one row or column
+    const std::vector<std::vector<Coordinates>> point_sets{
+        {{55.7, 37.6}, {55.7, 37.6}, {55.7, 37.6}},
+        {{55.5, 37.6}, {55.6, 37.6}, {55.7, 37.6}, {55.8, 37.6}, {55.7, 37.6}},
+        {{55.7, 37.5}, {55.7, 37.6}, {55.7, 37.7}, {55.7, 37.8}, {55.7, 37.55}},
+        {{55.7, 37.6}}};
+
+    for (const auto& points : point_sets) {
+        const GridIndex index(points);
+        for (const Coordinates point : {Coordinates{55.7, 37.6}, Coordinates{55.65, 37.62}, Coordinates{54., 36.}}) {
+            for (size_t count : {1u, 3u, 10u})
+                ExpectSameNearest(points, index, point, count);
+        }
+
+        for (const auto& [min, max] : {std::pair{Coordinates{55.6, 37.55}, Coordinates{55.7, 37.7}},
+                                       std::pair{Coordinates{50., 30.}, Coordinates{60., 40.}}})
+            EXPECT_EQ(index.FindInBox(min, max), FindInBoxByBruteForce(points, min, max));
+    }
+}
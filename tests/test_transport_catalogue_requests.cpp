@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/sprint_14/src/json.h"
+#include "../src/sprint_14/src/request_handler.h"
+
+using namespace std::literals;
+
+namespace {
+
+const std::string kRenderSettings =
+    R"("render_settings": {"width": 600, "height": 400, "padding": 50, "stop_radius": 5, "line_width": 14,
+    "bus_label_font_size": 20, "bus_label_offset": [7, 15], "stop_label_font_size": 18, "stop_label_offset": [7, -3],
+    "underlayer_color": [255, 255, 255, 0.85], "underlayer_width": 3, "color_palette": ["green", [255, 160, 0]]})"s;
+
+/// @brief Base of the bus "1" through the stops A, B, C and the stop "Lonely" without buses
+std::string MakeBaseRequests(const std::string& path, const std::string& router_type) {
+    return R"({"serialization_settings": {"file": ")"s + path + R"("}, )"s +
+           R"("routing_settings": {"bus_wait_time": 2, "bus_velocity": 30, "router_type": ")"s + router_type +
+           R"("}, )"s + kRenderSettings + R"(, "base_requests": [
+        {"type": "Bus", "name": "1", "stops": ["A", "B", "C"], "is_roundtrip": false},
+        {"type": "Stop", "name": "A", "latitude": 55.60, "longitude": 37.60, "road_distances": {"B": 1000}},
+        {"type": "Stop", "name": "B", "latitude": 55.61, "longitude": 37.60, "road_distances": {"C": 1000}},
+        {"type": "Stop", "name": "C", "latitude": 55.62, "longitude": 37.60},
+        {"type": "Stop", "name": "Lonely", "latitude": 55.70, "longitude": 37.70}]})"s;
+}
+
+json::Array ProcessRequests(const std::string& router_type, const std::string& stat_requests) {
+    const std::string path = (std::filesystem::temp_directory_path() / "test_transport_catalogue_requests.db"s)
+                                 .generic_string();
+
+    std::istringstream base_input(MakeBaseRequests(path, router_type));
+    request::ProcessMakeBaseQuery(base_input);
+
+    std::istringstream input(R"({"serialization_settings": {"file": ")"s + path + R"("}, "stat_requests": )"s +
+                             stat_requests + "}"s);
+    std::ostringstream output;
+    request::ProcessRequestsQuery(input, output);
+    std::filesystem::remove(path);
+
+    std::istringstream responses(output.str());
+    return json::Load(responses).GetRoot().AsArray();
+}
+
+bool IsNotFound(const json::Node& response) {
+    const auto& dict = response.AsDict();
+    return dict.count("error_message"s) > 0 && dict.at("error_message"s).AsString() == "not found"s;
+}
+
+}  // namespace
+
+TEST(TransportCatalogueRequests, RoutesWithUnknownStopsAreNotFound) {
+    const std::string requests = R"([
+        {"id": 1, "type": "Route", "from": "A", "to": "Unknown"},
+        {"id": 2, "type": "Route", "from": "Unknown", "to": "C"},
+        {"id": 3, "type": "Route", "from": {"latitude": 55.6, "longitude": 37.6}, "to": "Unknown"},
+        {"id": 4, "type": "Route", "from": "A", "to": "C"},
+        {"id": 5, "type": "RouteMatrix", "from": ["A", "Unknown"], "to": ["C"]},
+        {"id": 6, "type": "Route", "from": "A", "to": "Lonely"},
+        {"id": 7, "type": "Bus", "name": "Unknown"},
+        {"id": 8, "type": "Stop", "name": "Unknown"},
+        {"id": 9, "type": "Route", "from": "C", "to": "A"}])"s;
+
+    for (const auto& router_type :
+         {"all_pairs"s, "all_pairs_dijkstra"s, "dijkstra"s, "contraction_hierarchies"s, "raptor"s}) {
+        const auto responses = ProcessRequests(router_type, requests);
+        ASSERT_EQ(responses.size(), 9u) << "All requests should be answered by the router "s << router_type;
+
+        for (size_t index = 0; index < responses.size(); ++index)
+            EXPECT_EQ(responses[index].AsDict().at("request_id"s).AsInt(), static_cast<int>(index + 1));
+
+        for (size_t index : {0u, 1u, 2u, 4u, 5u, 6u, 7u})
+            EXPECT_TRUE(IsNotFound(responses[index])) << "Request #"s << index + 1 << " of the router "s << router_type;
+
+        // Wait for 2 minutes and ride 2000 meters with the velocity 500 meters per minute
+        for (size_t index : {3u, 8u}) {
+            ASSERT_FALSE(IsNotFound(responses[index]))
+                << "Request #"s << index + 1 << " of the router "s << router_type;
+            EXPECT_DOUBLE_EQ(responses[index].AsDict().at("total_time"s).AsDouble(), 6.);
+        }
+    }
+}
@@ -0,0 +1,248 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/sprint_14/src/transport_catalogue.h"
+
+using namespace catalogue;
+using namespace std::literals;
+
+namespace {
+
+template <typename Range>
+std::vector<uint32_t> ToVector(Range range) {
+    return {range.begin(), range.end()};
+}
+
+/// @brief Catalogue with the two-directional bus "750", the circle bus "256" and the stop without buses
+TransportCatalogue MakeCatalogue() {
+    TransportCatalogue catalogue;
+    catalogue.AddStop({"Tolstopaltsevo"s, {55.611087, 37.20829}});
+    catalogue.AddStop({"Marushkino"s, {55.595884, 37.209755}});
+    catalogue.AddStop({"Rasskazovka"s, {55.632761, 37.333324}});
+    catalogue.AddStop({"Biryulyovo Zapadnoye"s, {55.574371, 37.6517}});
+    catalogue.AddStop({"Biryusinka"s, {55.581065, 37.64839}});
+    catalogue.AddStop({"Universam"s, {55.587655, 37.645687}});
+    catalogue.AddStop({"Prazhskaya"s, {55.611678, 37.603831}});
+
+    catalogue.AddDistance("Tolstopaltsevo"sv, "Marushkino"sv, 3900);
+    catalogue.AddDistance("Marushkino"sv, "Rasskazovka"sv, 9900);
+    catalogue.AddDistance("Marushkino"sv, "Marushkino"sv, 100);
+    catalogue.AddDistance("Rasskazovka"sv, "Marushkino"sv, 9500);
+    catalogue.AddDistance("Biryulyovo Zapadnoye"sv, "Biryusinka"sv, 1800);
+    catalogue.AddDistance("Biryulyovo Zapadnoye"sv, "Universam"sv, 2400);
+    catalogue.AddDistance("Biryusinka"sv, "Universam"sv, 750);
+
+    catalogue.AddBus({"750"s, RouteType::TWO_DIRECTIONAL,
+                      {"Tolstopaltsevo"sv, "Marushkino"sv, "Marushkino"sv, "Rasskazovka"sv}});
+    catalogue.AddBus({"256"s, RouteType::CIRCLE,
+                      {"Biryulyovo Zapadnoye"sv, "Biryusinka"sv, "Universam"sv, "Biryulyovo Zapadnoye"sv}});
+    return catalogue;
+}
+
+/// @brief Geographic length of the whole route (with the backward way) computed by the distances of the stops pairs
+double GetGeographicLength(const TransportCatalogue& catalogue, BusId bus) {
+    const auto stops = catalogue.GetRouteStops(bus);
+
+    double length{0.};
+    for (size_t index = 1; index < stops.size(); ++index)
+        length += geo::ComputeDistance(catalogue.GetStopPoint(stops[index - 1]), catalogue.GetStopPoint(stops[index]));
+    return length;
+}
+
+}  // namespace
+
+TEST(TransportCatalogueStorage, StopsAndBusesHaveDenseIdsInTheOrderOfAdding) {
+    const auto catalogue = MakeCatalogue();
+
+    ASSERT_EQ(catalogue.GetStopsCount(), 7u);
+    ASSERT_EQ(catalogue.GetBusesCount(), 2u);
+
+    EXPECT_EQ(catalogue.GetStopId("Tolstopaltsevo"sv), 0u);
+    EXPECT_EQ(catalogue.GetStopId("Prazhskaya"sv), 6u);
+    EXPECT_EQ(catalogue.GetStopName(2), "Rasskazovka"sv);
+    EXPECT_DOUBLE_EQ(catalogue.GetStopPoint(1).lat, 55.595884);
+    EXPECT_DOUBLE_EQ(catalogue.GetStopPoint(1).lng, 37.209755);
+
+    EXPECT_EQ(catalogue.GetBusId("750"sv), 0u);
+    EXPECT_EQ(catalogue.GetBusId("256"sv), 1u);
+    EXPECT_EQ(catalogue.GetBusNumber(1), "256"sv);
+    EXPECT_EQ(catalogue.GetBusType(0), RouteType::TWO_DIRECTIONAL);
+    EXPECT_EQ(catalogue.GetBusType(1), RouteType::CIRCLE);
+
+    EXPECT_THROW((void)catalogue.GetStopId("Unknown"sv), std::out_of_range) << "Unknown stop has no id"s;
+    EXPECT_THROW((void)catalogue.GetBusId("Unknown"sv), std::out_of_range) << "Unknown bus has no id"s;
+}
+
+TEST(TransportCatalogueStorage, SecondStopWithTheSameNameIsIgnored) {
+    auto catalogue = MakeCatalogue();
+    catalogue.AddStop({"Marushkino"s, {0., 0.}});
+
+    EXPECT_EQ(catalogue.GetStopsCount(), 7u);
+    EXPECT_DOUBLE_EQ(catalogue.GetStopPoint(catalogue.GetStopId("Marushkino"sv)).lat, 55.595884);
+}
+
+TEST(TransportCatalogueStorage, BusStopsAreStoredInTheOrderOfTheInput) {
+    const auto catalogue = MakeCatalogue();
+
+    EXPECT_EQ(ToVector(catalogue.GetBusStops(0)), (std::vector<StopId>{0, 1, 1, 2}));
+    EXPECT_EQ(ToVector(catalogue.GetBusStops(1)), (std::vector<StopId>{3, 4, 5, 3}));
+
+    EXPECT_EQ(catalogue.GetFinalStops(0), (std::vector<StopId>{0, 2}));
+    EXPECT_EQ(catalogue.GetFinalStops(1), (std::vector<StopId>{3})) << "Circle bus has the only final stop"s;
+}
+
+TEST(TransportCatalogueStorage, RouteStopsIncludeBackwardWayOfTwoDirectionalBus) {
+    const auto catalogue = MakeCatalogue();
+
+    EXPECT_EQ(catalogue.GetRouteStops(0), (std::vector<StopId>{0, 1, 1, 2, 1, 1, 0}));
+    EXPECT_EQ(catalogue.GetRouteStops(0, false), (std::vector<StopId>{0, 1, 1, 2}));
+    EXPECT_EQ(catalogue.GetRouteStops(1), (std::vector<StopId>{3, 4, 5, 3})) << "Circle bus has no backward way"s;
+}
+
+TEST(TransportCatalogueStorage, RouteStopsOfLongTwoDirectionalBus) {
+    // The backward way does not fit the capacity of the forward one, so the route stops are reallocated on inserting
+    TransportCatalogue catalogue;
+    std::vector<std::string> names;
+    for (int index = 0; index < 100; ++index) {
+        names.push_back("Stop "s + std::to_string(index));
+        catalogue.AddStop({names.back(), {55. + index * 0.001, 37.}});
+    }
+
+    Bus bus{"1"s, RouteType::TWO_DIRECTIONAL, {}};
+    std::vector<StopId> expected;
+    for (int index = 0; index < 100; ++index) {
+        bus.stop_names.emplace_back(names[index]);
+        expected.push_back(index);
+    }
+    for (int index = 98; index >= 0; --index)
+        expected.push_back(index);
+    catalogue.AddBus(std::move(bus));
+
+    EXPECT_EQ(catalogue.GetRouteStops(0), expected);
+}
+
+TEST(TransportCatalogueStorage, BusesThroughTheStopAreOrderedByNumbers) {
+    auto catalogue = MakeCatalogue();
+    catalogue.AddBus({"1000"s, RouteType::CIRCLE, {"Marushkino"sv, "Universam"sv, "Marushkino"sv}});
+    catalogue.AddBus({"05"s, RouteType::TWO_DIRECTIONAL, {"Marushkino"sv, "Rasskazovka"sv}});
+
+    const BusId bus_1000 = catalogue.GetBusId("1000"sv);
+    const BusId bus_05 = catalogue.GetBusId("05"sv);
+
+    EXPECT_EQ(catalogue.GetOrderedBuses(), (std::vector<BusId>{bus_05, bus_1000, 1, 0}));
+    EXPECT_EQ(ToVector(*catalogue.GetBusesPassingThroughTheStop("Marushkino"sv)),
+              (std::vector<BusId>{bus_05, bus_1000, 0}));
+    EXPECT_EQ(ToVector(*catalogue.GetBusesPassingThroughTheStop("Universam"sv)), (std::vector<BusId>{bus_1000, 1}));
+
+    const auto no_buses = catalogue.GetBusesPassingThroughTheStop("Prazhskaya"sv);
+    ASSERT_TRUE(no_buses.has_value()) << "Stop without buses is known"s;
+    EXPECT_TRUE(ToVector(*no_buses).empty());
+    EXPECT_FALSE(catalogue.GetBusesPassingThroughTheStop("Unknown"sv).has_value());
+}
+
+TEST(TransportCatalogueStorage, AllStopsFromRoutesAreOrderedByNames) {
+    const auto catalogue = MakeCatalogue();
+
+    std::vector<std::string_view> names;
+    for (StopId stop : catalogue.GetAllStopsFromRoutes())
+        names.push_back(catalogue.GetStopName(stop));
+
+    const std::vector<std::string_view> expected{"Biryulyovo Zapadnoye"sv, "Biryusinka"sv, "Marushkino"sv,
+                                                 "Rasskazovka"sv, "Tolstopaltsevo"sv, "Universam"sv};
+    EXPECT_EQ(names, expected) << "Stop without buses is not on any route"s;
+}
+
+TEST(TransportCatalogueStorage, BusStatisticsOfTwoDirectionalAndCircleBuses) {
+    const auto catalogue = MakeCatalogue();
+
+    const auto two_directional = catalogue.GetBusStatistics("750"sv);
+    ASSERT_TRUE(two_directional.has_value());
+    EXPECT_EQ(two_directional->number, "750"sv);
+    EXPECT_EQ(two_directional->stops_count, 7u);
+    EXPECT_EQ(two_directional->unique_stops_count, 3u);
+    EXPECT_EQ(two_directional->rout_length, 3900 + 100 + 9900 + 9500 + 100 + 3900);
+    EXPECT_NEAR(two_directional->curvature, two_directional->rout_length / GetGeographicLength(catalogue, 0), 1e-6);
+
+    const auto circle = catalogue.GetBusStatistics("256"sv);
+    ASSERT_TRUE(circle.has_value());
+    EXPECT_EQ(circle->stops_count, 4u);
+    EXPECT_EQ(circle->unique_stops_count, 3u);
+    EXPECT_EQ(circle->rout_length, 1800 + 750 + 2400);
+    EXPECT_NEAR(circle->curvature, circle->rout_length / GetGeographicLength(catalogue, 1), 1e-6);
+
+    EXPECT_FALSE(catalogue.GetBusStatistics("Unknown"sv).has_value());
+}
+
+TEST(TransportCatalogueStorage, PrecomputedBusStatisticsAreTheSameAsComputedOnTheFly) {
+    auto catalogue = MakeCatalogue();
+    const auto expected_750 = catalogue.GetBusStatistics("750"sv);
+    const auto expected_256 = catalogue.GetBusStatistics("256"sv);
+
+    catalogue.ComputeBusStatistics();
+
+    EXPECT_EQ(catalogue.GetBusStatistics("750"sv)->rout_length, expected_750->rout_length);
+    EXPECT_DOUBLE_EQ(catalogue.GetBusStatistics("750"sv)->curvature, expected_750->curvature);
+    EXPECT_EQ(catalogue.GetBusStatistics("256"sv)->rout_length, expected_256->rout_length);
+    EXPECT_DOUBLE_EQ(catalogue.GetBusStatistics("256"sv)->curvature, expected_256->curvature);
+}
+
+TEST(TransportCatalogueStorage, BusStatisticsAreRecomputedAfterAddingDistance) {
+    auto catalogue = MakeCatalogue();
+    catalogue.ComputeBusStatistics();
+    ASSERT_EQ(catalogue.GetBusStatistics("750"sv)->rout_length, 27400);
+
+    // Explicit backward distance replaces the one taken from the forward direction
+    catalogue.AddDistance("Marushkino"sv, "Tolstopaltsevo"sv, 4100);
+    EXPECT_EQ(catalogue.GetBusStatistics("750"sv)->rout_length, 27600) << "Statistics should be invalidated"s;
+    EXPECT_NEAR(catalogue.GetBusStatistics("750"sv)->curvature, 27600 / GetGeographicLength(catalogue, 0), 1e-6);
+
+    catalogue.ComputeBusStatistics();
+    EXPECT_EQ(catalogue.GetBusStatistics("750"sv)->rout_length, 27600) << "Statistics should be recomputed"s;
+    EXPECT_EQ(catalogue.GetBusStatistics("256"sv)->rout_length, 4950) << "Other bus should not be changed"s;
+}
+
+TEST(TransportCatalogueStorage, BusStatisticsAreInvalidatedForAllBusesThroughTheStops) {
+    auto catalogue = MakeCatalogue();
+    catalogue.AddBus({"1"s, RouteType::CIRCLE, {"Universam"sv, "Marushkino"sv, "Universam"sv}});
+    catalogue.AddDistance("Universam"sv, "Marushkino"sv, 20000);
+    catalogue.ComputeBusStatistics();
+    ASSERT_EQ(catalogue.GetBusStatistics("1"sv)->rout_length, 40000);
+
+    catalogue.AddDistance("Marushkino"sv, "Universam"sv, 15000);
+    EXPECT_EQ(catalogue.GetBusStatistics("1"sv)->rout_length, 35000);
+    EXPECT_EQ(catalogue.GetBusStatistics("750"sv)->rout_length, 27400);
+    EXPECT_EQ(catalogue.GetBusStatistics("256"sv)->rout_length, 4950);
+}
+
+TEST(TransportCatalogueStorage, BusStatisticsAreComputedForBusAddedAfterComputing) {
+    auto catalogue = MakeCatalogue();
+    catalogue.ComputeBusStatistics();
+
+    catalogue.AddStop({"Lipetskaya"s, {55.6, 37.65}});
+    catalogue.AddDistance("Universam"sv, "Lipetskaya"sv, 1000);
+    catalogue.AddBus({"2"s, RouteType::TWO_DIRECTIONAL, {"Universam"sv, "Lipetskaya"sv}});
+
+    const auto statistics = catalogue.GetBusStatistics("2"sv);
+    ASSERT_TRUE(statistics.has_value());
+    EXPECT_EQ(statistics->stops_count, 3u);
+    EXPECT_EQ(statistics->rout_length, 2000);
+
+    catalogue.ComputeBusStatistics();
+    EXPECT_EQ(catalogue.GetBusStatistics("2"sv)->rout_length, 2000);
+    EXPECT_NEAR(catalogue.GetBusStatistics("2"sv)->curvature, 2000 / GetGeographicLength(catalogue, 2), 1e-6);
+    EXPECT_EQ(catalogue.GetBusStatistics("256"sv)->rout_length, 4950) << "Stop adding should not change statistics"s;
+}
+
+TEST(TransportCatalogueStorage, StoredBusStatisticsAreInvalidatedByDistance) {
+    // Statistics set on the deserialization is used until the route length is changed
+    auto catalogue = MakeCatalogue();
+    catalogue.SetBusStatistics(catalogue.GetBusId("256"sv), 100, 2.);
+    EXPECT_EQ(catalogue.GetBusStatistics("256"sv)->rout_length, 100);
+    EXPECT_DOUBLE_EQ(catalogue.GetBusStatistics("256"sv)->curvature, 2.);
+
+    catalogue.AddDistance("Universam"sv, "Biryusinka"sv, 800);
+    EXPECT_EQ(catalogue.GetBusStatistics("256"sv)->rout_length, 4950) << "Only the forward distance is used"s;
+}
@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../src/sprint_14/src/transport_catalogue.h"
+#include "../src/sprint_14/src/transport_router.h"
+
+using namespace catalogue;
+using namespace routing;
+using namespace std::literals;
+
+namespace {
+
+/// @brief City of the two districts, which are not connected by the buses, and the stops without buses. Buses of the
+/// district have few stops, so most of the routes need the transfers; circle buses give the routes in one direction
+class RandomCity {
+public:
+    explicit RandomCity(std::mt19937& generator) {
+        const size_t stops_count = std::uniform_int_distribution<size_t>(20, 40)(generator);
+        std::uniform_real_distribution<double> lat(55.5, 55.9);
+        std::uniform_real_distribution<double> lng(37.3, 37.9);
+        for (size_t index = 0; index < stops_count; ++index) {
+            stop_names_.push_back("Stop "s + std::to_string(index));
+            catalogue_.AddStop({stop_names_.back(), {lat(generator), lng(generator)}});
+        }
+        stops_.assign(stop_names_.begin(), stop_names_.end());
+
+        // Last stops have no buses
+        const size_t district_size = (stops_count - 2) / 2;
+        for (size_t district = 0; district < 2; ++district) {
+            for (int bus = 0; bus < 4; ++bus)
+                AddRandomBus(generator, district * district_size, (district + 1) * district_size);
+        }
+    }
+
+    [[nodiscard]] const TransportCatalogue& GetCatalogue() const { return catalogue_; }
+    [[nodiscard]] const std::vector<std::string_view>& GetStops() const { return stops_; }
+
+private:
+    void AddRandomBus(std::mt19937& generator, size_t first_stop, size_t last_stop) {
+        std::uniform_int_distribution<size_t> stop(first_stop, last_stop - 1);
+        std::uniform_int_distribution<int> distance(500, 5000);
+        const size_t stops_count = std::uniform_int_distribution<size_t>(3, 6)(generator);
+        const bool is_circle = std::bernoulli_distribution(0.5)(generator);
+
+        Bus bus{std::to_string(catalogue_.GetBusesCount() + 1),
+                is_circle ? RouteType::CIRCLE : RouteType::TWO_DIRECTIONAL, {}};
+        for (size_t index = 0; index < stops_count; ++index)
+            bus.stop_names.push_back(stops_[stop(generator)]);
+        if (is_circle)
+            bus.stop_names.push_back(bus.stop_names.front());
+
+        // Distance of the reverse direction is set for some of the stops only, so the others are taken from the forward
+        // one (the first explicit distance is kept, so the repeated pairs are not changed)
+        for (size_t index = 1; index < bus.stop_names.size(); ++index) {
+            catalogue_.AddDistance(bus.stop_names[index - 1], bus.stop_names[index], distance(generator));
+            if (std::bernoulli_distribution(0.3)(generator))
+                catalogue_.AddDistance(bus.stop_names[index], bus.stop_names[index - 1], distance(generator));
+        }
+
+        catalogue_.AddBus(std::move(bus));
+    }
+
+private:
+    TransportCatalogue catalogue_;
+    std::vector<std::string> stop_names_;
+    std::vector<std::string_view> stops_;
+};
+
+Settings MakeSettings(RouterType router_type) {
+    Settings settings;
+    settings.bus_velocity_ = 500.;  // 30 km/h
+    settings.bus_wait_time_ = 3;
+    settings.router_type_ = router_type;
+    return settings;
+}
+
+/// @brief Checks, that the route consists of the waits for the buses and the rides, which sum up to the total time
+void ExpectConsistentRoute(const ResponseData& route, std::string_view from) {
+    double total_time{0.};
+    for (size_t index = 0; index < route.items.size(); ++index) {
+        const auto& item = route.items[index];
+        // Passenger waits before each bus
+        EXPECT_EQ(item.type, index % 2 == 0 ? ResponseType::Wait : ResponseType::Bus);
+        if (item.type == ResponseType::Bus) {
+            EXPECT_GT(item.span_count, 0) << "Bus should ride at least one stop"s;
+        }
+        total_time += item.time;
+    }
+
+    if (!route.items.empty()) {
+        EXPECT_EQ(route.items.front().name, from) << "Route should start from its first stop"s;
+    }
+    EXPECT_NEAR(total_time, route.total_time, 1e-9) << "Total time should be the sum of the route items"s;
+}
+
+size_t GetBusesCount(const ResponseData& route) {
+    return route.items.size() / 2;
+}
+
+}  // namespace
+
+TEST(TransportRouter, RaptorRoutesHaveTheSameTimeAsGraphRouters) {
+    std::mt19937 generator(42u);
+    size_t routes_with_transfers{0u};
+    size_t pairs_without_route{0u};
+
+    for (int city_id = 0; city_id < 10; ++city_id) {
+        const RandomCity city(generator);
+        const auto& stops = city.GetStops();
+
+        const TransportRouter raptor(city.GetCatalogue(), MakeSettings(RouterType::Raptor));
+        for (auto router_type : {RouterType::AllPairs, RouterType::Dijkstra}) {
+            const TransportRouter router(city.GetCatalogue(), MakeSettings(router_type));
+
+            for (std::string_view from : stops) {
+                for (std::string_view to : stops) {
+                    const auto route = raptor.BuildRoute(from, to);
+                    const auto expected_route = router.BuildRoute(from, to);
+
+                    ASSERT_EQ(route.has_value(), expected_route.has_value())
+                        << "Route "s << from << " -> "s << to << " should be found by both routers"s;
+                    if (!route) {
+                        ++pairs_without_route;
+                        continue;
+                    }
+
+                    EXPECT_NEAR(route->total_time, expected_route->total_time, 1e-9)
+                        << "Route "s << from << " -> "s << to;
+                    ExpectConsistentRoute(*route, from);
+                    if (GetBusesCount(*route) > 1)
+                        ++routes_with_transfers;
+                }
+            }
+        }
+    }
+
+    EXPECT_GT(routes_with_transfers, 0u) << "Cities should have the routes with the transfers"s;
+    EXPECT_GT(pairs_without_route, 0u) << "Cities should have the pairs of stops without the route"s;
+}
+
+TEST(TransportRouter, RaptorRoutesFromOneStopAreTheSameAsSingleRoutes) {
+    std::mt19937 generator(7u);
+
+    for (int city_id = 0; city_id < 5; ++city_id) {
+        const RandomCity city(generator);
+        const auto& stops = city.GetStops();
+        const TransportRouter raptor(city.GetCatalogue(), MakeSettings(RouterType::Raptor));
+
+        // Routes are restored after one search without the target pruning
+        for (std::string_view from : stops) {
+            const auto routes = raptor.BuildRoutes(from, stops);
+            ASSERT_EQ(routes.size(), stops.size());
+
+            for (size_t index = 0; index < stops.size(); ++index) {
+                const auto route = raptor.BuildRoute(from, stops[index]);
+                ASSERT_EQ(routes[index].has_value(), route.has_value());
+                if (!route)
+                    continue;
+
+                EXPECT_NEAR(routes[index]->total_time, route->total_time, 1e-9);
+                ExpectConsistentRoute(*routes[index], from);
+            }
+        }
+    }
+}
+
+TEST(TransportRouter, RaptorRouteMatrixIsTheSameAsGraphRouters) {
+    std::mt19937 generator(13u);
+
+    for (int city_id = 0; city_id < 5; ++city_id) {
+        const RandomCity city(generator);
+        const auto& stops = city.GetStops();
+
+        // Stops 'from' are the part of the stops 'to', so the matrix is not square
+        const std::vector<std::string_view> from(stops.begin(), stops.begin() + stops.size() / 2);
+        const auto matrix = TransportRouter(city.GetCatalogue(), MakeSettings(RouterType::Raptor))
+                                .BuildRouteMatrix(from, stops);
+
+        for (auto router_type : {RouterType::AllPairs, RouterType::Dijkstra, RouterType::ContractionHierarchies}) {
+            const auto expected_matrix =
+                TransportRouter(city.GetCatalogue(), MakeSettings(router_type)).BuildRouteMatrix(from, stops);
+
+            ASSERT_EQ(matrix.size(), expected_matrix.size());
+            for (size_t row = 0; row < matrix.size(); ++row) {
+                ASSERT_EQ(matrix[row].size(), expected_matrix[row].size());
+                for (size_t column = 0; column < matrix[row].size(); ++column) {
+                    const auto& time = matrix[row][column];
+                    const auto& expected_time = expected_matrix[row][column];
+
+                    ASSERT_EQ(time.has_value(), expected_time.has_value())
+                        << "Route "s << from[row] << " -> "s << stops[column];
+                    if (time) {
+                        EXPECT_NEAR(*time, *expected_time, 1e-9) << "Route "s << from[row] << " -> "s << stops[column];
+                    }
+                }
+            }
+        }
+    }
+}